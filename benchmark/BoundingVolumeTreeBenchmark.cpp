@@ -0,0 +1,121 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include "CoreBenchmark.h"
+
+#include <core/Essentials.h>
+#include <core/Scene/BoundingVolumeTree.h>
+
+#include <random>
+
+namespace core { namespace Benchmark {
+
+namespace {
+
+constexpr size_t objectCount = 100000;
+constexpr size_t queryCount  = 1000;
+
+/** Boxes of objectCount objects spread over a 1km cube, the tree built from them and query boxes */
+struct TreeData {
+    vector<Range3D>              boxes;
+    vector<Range3D>              queries;
+    BoundingVolumeTree<uint32_t> tree;
+
+    TreeData() {
+        std::mt19937 random { 19 };
+        std::uniform_real_distribution<float> position { -500.0f, 500.0f };
+        std::uniform_real_distribution<float> size { 0.5f, 4.0f };
+        const auto box = [&](float scale) {
+            const Vector3 min { position(random), position(random), position(random) };
+            return Range3D { min, min + Vector3 { size(random), size(random), size(random) } * scale };
+        };
+
+        for (uint32_t i = 0; i < objectCount; ++i) {
+            boxes.push_back(box(1.0f));
+            tree.Insert(boxes.back(), i);
+        }
+        tree.Rebuild();
+
+        /* Roughly the size of a trigger volume or an explosion radius */
+        for (size_t i = 0; i < queryCount; ++i) { queries.push_back(box(5.0f)); }
+    }
+};
+
+const TreeData& GetTreeData() {
+    static const TreeData data;
+    return data;
+}
+
+bool Overlaps(const Range3D& a, const Range3D& b) {
+    for (int i = 0; i < 3; ++i) {
+        if (a.max()[i] < b.min()[i] || b.max()[i] < a.min()[i]) { return false; }
+    }
+    return true;
+}
+
+}
+
+void CoreBenchmark::BoundingVolumeTreeQueryOverlap() {
+    const TreeData& data = GetTreeData();
+    vector<uint32_t> result;
+
+    size_t hits = 0;
+    CORRADE_BENCHMARK(1) {
+        for (const Range3D& query : data.queries) {
+            result.clear();
+            data.tree.QueryOverlap(query, result);
+            hits += result.size();
+        }
+    }
+    CORRADE_VERIFY(hits > 0);
+}
+void CoreBenchmark::BoundingVolumeTreeQueryOverlapLinear() {
+    const TreeData& data = GetTreeData();
+    vector<uint32_t> result;
+
+    size_t hits = 0;
+    CORRADE_BENCHMARK(1) {
+        for (const Range3D& query : data.queries) {
+            result.clear();
+            for (uint32_t i = 0; i < objectCount; ++i) {
+                if (Overlaps(data.boxes[i], query)) { result.push_back(i); }
+            }
+            hits += result.size();
+        }
+    }
+    CORRADE_VERIFY(hits > 0);
+}
+void CoreBenchmark::BoundingVolumeTreeQueryFrustum() {
+    const TreeData& data = GetTreeData();
+    /* Camera at the center of the world, looking down -Z */
+    const Frustum frustum = Frustum::fromMatrix(Matrix4::perspectiveProjection(Deg(60.0f), 16.0f / 9.0f, 0.1f, 300.0f));
+    vector<uint32_t> result;
+
+    CORRADE_BENCHMARK(10) {
+        result.clear();
+        data.tree.QueryFrustum(frustum, result);
+    }
+}
+
+}}
@@ -0,0 +1,95 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "CoreBenchmark.h"
+
+#include <core/Entity.h>
+
+#include <typeinfo>
+
+namespace core { namespace Benchmark {
+
+namespace {
+
+template<int N>
+class LookupComponent : public IComponent {
+public:
+    explicit LookupComponent(Entity& parent) : IComponent(parent, "Lookup") { }
+
+    int value { N };
+};
+
+constexpr size_t lookupCount = 10000;
+
+/* Typed lookup as Entity did it before dense type ids: scan, typeid compare, dynamic_cast */
+template<typename T>
+T* FindByTypeid(const vector<IComponent*>& components) {
+    for (IComponent* component : components) {
+        if (typeid(*component).hash_code() == typeid(T).hash_code()) {
+            return dynamic_cast<T*>(component);
+        }
+    }
+    return nullptr;
+}
+
+}
+
+void CoreBenchmark::ComponentLookupDense() {
+    Entity entity("Lookup");
+    entity.AddComponent<LookupComponent<0>>()
+          .AddComponent<LookupComponent<1>>()
+          .AddComponent<LookupComponent<2>>()
+          .AddComponent<LookupComponent<3>>()
+          .AddComponent<LookupComponent<4>>()
+          .AddComponent<LookupComponent<5>>();
+
+    int sum = 0;
+    CORRADE_BENCHMARK(lookupCount) {
+        sum += entity.GetComponent<LookupComponent<5>>()->value;
+        sum += entity.GetComponent<LookupComponent<2>>()->value;
+    }
+    CORRADE_COMPARE(sum, 7 * int(lookupCount));
+}
+void CoreBenchmark::ComponentLookupTypeid() {
+    Entity entity("Lookup");
+    entity.AddComponent<LookupComponent<0>>()
+          .AddComponent<LookupComponent<1>>()
+          .AddComponent<LookupComponent<2>>()
+          .AddComponent<LookupComponent<3>>()
+          .AddComponent<LookupComponent<4>>()
+          .AddComponent<LookupComponent<5>>();
+
+    const vector<IComponent*> components {
+        entity.GetComponent<LookupComponent<0>>(), entity.GetComponent<LookupComponent<1>>(),
+        entity.GetComponent<LookupComponent<2>>(), entity.GetComponent<LookupComponent<3>>(),
+        entity.GetComponent<LookupComponent<4>>(), entity.GetComponent<LookupComponent<5>>() };
+
+    int sum = 0;
+    CORRADE_BENCHMARK(lookupCount) {
+        sum += FindByTypeid<LookupComponent<5>>(components)->value;
+        sum += FindByTypeid<LookupComponent<2>>(components)->value;
+    }
+    CORRADE_COMPARE(sum, 7 * int(lookupCount));
+}
+
+}}
@@ -0,0 +1,61 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "CoreBenchmark.h"
+
+namespace core { namespace Benchmark {
+
+CoreBenchmark::CoreBenchmark() {
+    addBenchmarks({ &CoreBenchmark::BoundingVolumeTreeQueryOverlap,
+                    &CoreBenchmark::BoundingVolumeTreeQueryOverlapLinear,
+                    &CoreBenchmark::BoundingVolumeTreeQueryFrustum }, 10);
+
+    addBenchmarks({ &CoreBenchmark::ComponentLookupDense,
+                    &CoreBenchmark::ComponentLookupTypeid }, 50);
+
+    addBenchmarks({ &CoreBenchmark::EventTrigger,
+                    &CoreBenchmark::EventTriggerFunction,
+                    &CoreBenchmark::EventSubscribe,
+                    &CoreBenchmark::EventSubscribeFunction }, 50);
+
+    addBenchmarks({ &CoreBenchmark::ComposeTransformsMagnum,
+                    &CoreBenchmark::MultiplyMagnum,
+                    &CoreBenchmark::ExtractNormalMatricesMagnum,
+                    &CoreBenchmark::NormalizeQuaternionsMagnum }, 20);
+
+    addBenchmarks({ &CoreBenchmark::OcclusionBufferRasterize,
+                    &CoreBenchmark::OcclusionBufferTestVisibility }, 20);
+
+    addBenchmarks({ &CoreBenchmark::SceneSnapshotDecode,
+                    &CoreBenchmark::SceneSnapshotLoad }, 10);
+
+    /* One instance per Math::SimdLevel */
+    addInstancedBenchmarks({ &CoreBenchmark::ComposeTransforms,
+                             &CoreBenchmark::Multiply,
+                             &CoreBenchmark::ExtractNormalMatrices,
+                             &CoreBenchmark::NormalizeQuaternions }, 20, 3);
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Benchmark::CoreBenchmark)
@@ -0,0 +1,74 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_BENCHMARK_COREBENCHMARK_H
+#define CORE_BENCHMARK_COREBENCHMARK_H
+
+#include <Corrade/TestSuite/Tester.h>
+
+namespace core { namespace Benchmark {
+
+/**
+ * Benchmarks of engine hot paths, each group lives in its own source file
+ * @details Run CoreBenchmark executable, pass --only to pick benchmarks
+ */
+struct CoreBenchmark : Corrade::TestSuite::Tester {
+    explicit CoreBenchmark();
+
+    /* BoundingVolumeTreeBenchmark.cpp, 100k boxes, Linear is the brute force baseline */
+    void BoundingVolumeTreeQueryOverlap();
+    void BoundingVolumeTreeQueryOverlapLinear();
+    void BoundingVolumeTreeQueryFrustum();
+
+    /* ComponentLookupBenchmark.cpp */
+    void ComponentLookupDense();
+    void ComponentLookupTypeid();
+
+    /* OcclusionBufferBenchmark.cpp, 200 wall occluders and 10k tested bounds on a default sized buffer */
+    void OcclusionBufferRasterize();
+    void OcclusionBufferTestVisibility();
+
+    /* EventBenchmark.cpp, Function ones are the std::function based Event baseline */
+    void EventTrigger();
+    void EventTriggerFunction();
+    void EventSubscribe();
+    void EventSubscribeFunction();
+
+    /* SceneSnapshotBenchmark.cpp, 10k entities with a Transform, Load includes Decode */
+    void SceneSnapshotDecode();
+    void SceneSnapshotLoad();
+
+    /* MathBenchmark.cpp, kernels are instanced per Math::SimdLevel, Magnum ones are the per-object baseline */
+    void ComposeTransformsMagnum();
+    void ComposeTransforms();
+    void MultiplyMagnum();
+    void Multiply();
+    void ExtractNormalMatricesMagnum();
+    void ExtractNormalMatrices();
+    void NormalizeQuaternionsMagnum();
+    void NormalizeQuaternions();
+};
+
+}}
+
+#endif //CORE_BENCHMARK_COREBENCHMARK_H
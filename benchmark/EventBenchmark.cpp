@@ -0,0 +1,118 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include "CoreBenchmark.h"
+
+#include <core/Essentials.h>
+#include <core/Event.h>
+
+#include <functional>
+
+namespace core { namespace Benchmark {
+
+namespace {
+
+constexpr size_t triggerCount    = 100000;
+constexpr size_t subscriberCount = 4;
+
+/** Event as it was before delegates: every callback is a std::function, subscriptions are never removed */
+template<typename T>
+class FunctionEvent {
+public:
+    void Subscribe(std::function<void(T&)> callback) {
+        callbacks.emplace_back(std::move(callback));
+    }
+    void Trigger(T& obj) {
+        for (const auto& callback : callbacks) {
+            callback(obj);
+        }
+    }
+    void Clear() {
+        callbacks.clear();
+    }
+
+private:
+    vector<std::function<void(T&)>> callbacks;
+};
+
+/** Captures three pointers, more than std::function keeps inline, still fits into Delegate */
+struct Counter {
+    int64_t* sum;
+    int64_t* calls;
+    int64_t* last;
+
+    void operator()(int& value) const {
+        *sum  += value;
+        *calls += 1;
+        *last  = value;
+    }
+};
+
+}
+
+void CoreBenchmark::EventTrigger() {
+    int64_t sum = 0, calls = 0, last = 0;
+    Event<int> event;
+    for (size_t i = 0; i < subscriberCount; ++i) { event.Subscribe(Counter { &sum, &calls, &last }); }
+
+    int value = 1;
+    CORRADE_BENCHMARK(triggerCount) {
+        event.Trigger(value);
+    }
+    CORRADE_COMPARE(calls, int64_t(subscriberCount * triggerCount));
+}
+void CoreBenchmark::EventTriggerFunction() {
+    int64_t sum = 0, calls = 0, last = 0;
+    FunctionEvent<int> event;
+    for (size_t i = 0; i < subscriberCount; ++i) { event.Subscribe(Counter { &sum, &calls, &last }); }
+
+    int value = 1;
+    CORRADE_BENCHMARK(triggerCount) {
+        event.Trigger(value);
+    }
+    CORRADE_COMPARE(calls, int64_t(subscriberCount * triggerCount));
+}
+void CoreBenchmark::EventSubscribe() {
+    int64_t sum = 0, calls = 0, last = 0;
+    Event<int> event;
+
+    /* Subscribing and unsubscribing, as a component does when it starts and is destroyed */
+    CORRADE_BENCHMARK(triggerCount) {
+        Subscription subscription = event.SubscribeScoped(Counter { &sum, &calls, &last });
+    }
+    CORRADE_COMPARE(calls, 0);
+}
+void CoreBenchmark::EventSubscribeFunction() {
+    int64_t sum = 0, calls = 0, last = 0;
+    FunctionEvent<int> event;
+
+    /* Old event could not unsubscribe, clearing it stands in for the removal */
+    CORRADE_BENCHMARK(triggerCount) {
+        event.Subscribe(Counter { &sum, &calls, &last });
+        event.Clear();
+    }
+    CORRADE_COMPARE(calls, 0);
+}
+
+}}
@@ -0,0 +1,170 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "CoreBenchmark.h"
+
+#include <core/Essentials.h>
+#include <core/Math.h>
+
+#include <random>
+
+namespace core { namespace Benchmark {
+
+namespace {
+
+constexpr size_t objectCount = 10000;
+
+const char* const levelNames[] { "Scalar", "SSE4.1", "AVX2" };
+
+/** Transforms of objectCount objects, in both layouts */
+struct TransformData {
+    vector<float>      position[3], rotation[4], scale[3];
+    vector<Vector3>    positions, scales;
+    vector<Quaternion> rotations;
+    vector<Matrix4>    matrices;
+
+    TransformData() {
+        std::mt19937 random { 14 };
+        std::uniform_real_distribution<float> unit { -1.0f, 1.0f };
+        for (size_t i = 0; i < objectCount; ++i) {
+            positions.push_back({ unit(random) * 100, unit(random) * 100, unit(random) * 100 });
+            scales.push_back({ 1.5f + unit(random), 1.5f + unit(random), 1.5f + unit(random) });
+            rotations.push_back(Quaternion({ unit(random), unit(random), unit(random) }, unit(random)).normalized());
+            matrices.push_back(Matrix4::from(rotations.back().toMatrix(), positions.back()) * Matrix4::scaling(scales.back()));
+
+            for (size_t c = 0; c < 3; ++c) {
+                position[c].push_back(positions.back()[c]);
+                scale[c].push_back(scales.back()[c]);
+                rotation[c].push_back(rotations.back().vector()[c]);
+            }
+            rotation[3].push_back(rotations.back().scalar());
+        }
+    }
+
+    Math::TransformArrays Arrays() const {
+        return { { position[0].data(), position[1].data(), position[2].data() },
+                 { rotation[0].data(), rotation[1].data(), rotation[2].data(), rotation[3].data() },
+                 { scale[0].data(), scale[1].data(), scale[2].data() } };
+    }
+};
+
+const TransformData& GetTransformData() {
+    static const TransformData data;
+    return data;
+}
+
+}
+
+/* Selects kernels of the benchmarked instance, skips it if CPU lacks them */
+#define CORE_SELECT_SIMD_LEVEL()                                                    \
+    setTestCaseDescription(levelNames[testCaseInstanceId()]);                       \
+    Math::SetSimdLevel(static_cast<Math::SimdLevel>(testCaseInstanceId()));         \
+    if (size_t(Math::GetSimdLevel()) != testCaseInstanceId()) { CORRADE_SKIP("Not supported by CPU"); }
+
+void CoreBenchmark::ComposeTransformsMagnum() {
+    const TransformData& data = GetTransformData();
+    vector<Matrix4> output(objectCount);
+
+    CORRADE_BENCHMARK(10) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            output[i] = Matrix4::from(data.rotations[i].toMatrix(), data.positions[i]) * Matrix4::scaling(data.scales[i]);
+        }
+    }
+    CORRADE_COMPARE(output.back(), data.matrices.back());
+}
+void CoreBenchmark::ComposeTransforms() {
+    CORE_SELECT_SIMD_LEVEL();
+    const TransformData& data = GetTransformData();
+    const Math::TransformArrays input = data.Arrays();
+    vector<Matrix4> output(objectCount);
+
+    CORRADE_BENCHMARK(10) {
+        Math::ComposeTransforms(input, output.data(), objectCount);
+    }
+    CORRADE_COMPARE(output.back(), data.matrices.back());
+}
+void CoreBenchmark::MultiplyMagnum() {
+    const TransformData& data = GetTransformData();
+    vector<Matrix4> output(objectCount);
+
+    CORRADE_BENCHMARK(10) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            output[i] = data.matrices[i] * data.matrices[objectCount - 1 - i];
+        }
+    }
+    CORRADE_COMPARE(output.back(), data.matrices.back() * data.matrices.front());
+}
+void CoreBenchmark::Multiply() {
+    CORE_SELECT_SIMD_LEVEL();
+    const TransformData& data = GetTransformData();
+    const vector<Matrix4> reversed(data.matrices.rbegin(), data.matrices.rend());
+    vector<Matrix4> output(objectCount);
+
+    CORRADE_BENCHMARK(10) {
+        Math::Multiply(data.matrices.data(), reversed.data(), output.data(), objectCount);
+    }
+    CORRADE_COMPARE(output.back(), data.matrices.back() * data.matrices.front());
+}
+void CoreBenchmark::ExtractNormalMatricesMagnum() {
+    const TransformData& data = GetTransformData();
+    vector<Matrix3x3> output(objectCount);
+
+    CORRADE_BENCHMARK(10) {
+        for (size_t i = 0; i < objectCount; ++i) {
+            output[i] = data.matrices[i].normalMatrix();
+        }
+    }
+    CORRADE_COMPARE(output.back(), data.matrices.back().normalMatrix());
+}
+void CoreBenchmark::ExtractNormalMatrices() {
+    CORE_SELECT_SIMD_LEVEL();
+    const TransformData& data = GetTransformData();
+    vector<Matrix3x3> output(objectCount);
+
+    CORRADE_BENCHMARK(10) {
+        Math::ExtractNormalMatrices(data.matrices.data(), output.data(), objectCount);
+    }
+    CORRADE_COMPARE(output.back(), data.matrices.back().normalMatrix());
+}
+void CoreBenchmark::NormalizeQuaternionsMagnum() {
+    vector<Quaternion> rotations = GetTransformData().rotations;
+
+    CORRADE_BENCHMARK(10) {
+        for (Quaternion& rotation : rotations) {
+            rotation = rotation.normalized();
+        }
+    }
+    CORRADE_COMPARE(rotations.back(), GetTransformData().rotations.back());
+}
+void CoreBenchmark::NormalizeQuaternions() {
+    CORE_SELECT_SIMD_LEVEL();
+    const TransformData& data = GetTransformData();
+    vector<float> x = data.rotation[0], y = data.rotation[1], z = data.rotation[2], w = data.rotation[3];
+
+    CORRADE_BENCHMARK(10) {
+        Math::NormalizeQuaternions(x.data(), y.data(), z.data(), w.data(), objectCount);
+    }
+    CORRADE_COMPARE(Quaternion({ x.back(), y.back(), z.back() }, w.back()), data.rotations.back());
+}
+
+}}
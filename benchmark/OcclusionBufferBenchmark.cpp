@@ -0,0 +1,99 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include "CoreBenchmark.h"
+
+#include <core/Essentials.h>
+#include <core/JobSystem.h>
+#include <core/Scene/OcclusionBuffer.h>
+
+#include <random>
+
+namespace core { namespace Benchmark {
+
+namespace {
+
+constexpr size_t occluderCount = 200;
+constexpr size_t boundsCount   = 10000;
+
+/** City-like scene in front of a camera looking down -Z, walls as occluders and small objects around them */
+struct OcclusionData {
+    Matrix4         projection = Matrix4::perspectiveProjection(Deg(70.0f), 2.0f, 0.1f, 500.0f);
+    vector<Matrix4> occluders;
+    vector<Range3D> bounds;
+    Range3D         wall { { -4.0f, 0.0f, -0.2f }, { 4.0f, 10.0f, 0.2f } };
+
+    OcclusionData() {
+        std::mt19937 random { 21 };
+        std::uniform_real_distribution<float> x { -150.0f, 150.0f }, z { -300.0f, -5.0f }, size { 0.5f, 3.0f };
+        for (size_t i = 0; i < occluderCount; ++i) {
+            occluders.push_back(Matrix4::translation({ x(random), -2.0f, z(random) }));
+        }
+        for (size_t i = 0; i < boundsCount; ++i) {
+            const Vector3 min { x(random), -2.0f, z(random) };
+            bounds.push_back({ min, min + Vector3 { size(random), size(random), size(random) } });
+        }
+    }
+};
+
+const OcclusionData& GetOcclusionData() {
+    static const OcclusionData data;
+    return data;
+}
+
+}
+
+void CoreBenchmark::OcclusionBufferRasterize() {
+    const OcclusionData& data = GetOcclusionData();
+    JobSystem jobSystem;
+    OcclusionBuffer buffer { jobSystem };
+
+    CORRADE_BENCHMARK(10) {
+        buffer.Begin(data.projection);
+        for (const Matrix4& occluder : data.occluders) {
+            buffer.AddOccluder(occluder, data.wall);
+        }
+        buffer.Rasterize();
+    }
+    CORRADE_VERIFY(buffer.GetTriangleCount() > 0);
+}
+void CoreBenchmark::OcclusionBufferTestVisibility() {
+    const OcclusionData& data = GetOcclusionData();
+    JobSystem jobSystem;
+    OcclusionBuffer buffer { jobSystem };
+    buffer.Begin(data.projection);
+    for (const Matrix4& occluder : data.occluders) {
+        buffer.AddOccluder(occluder, data.wall);
+    }
+    buffer.Rasterize();
+
+    vector<uint8_t> visible(boundsCount);
+    size_t visibleCount = 0;
+    CORRADE_BENCHMARK(10) {
+        visibleCount = buffer.TestVisibility(data.bounds.data(), visible.data(), boundsCount);
+    }
+    CORRADE_VERIFY(visibleCount < boundsCount);
+}
+
+}}
@@ -0,0 +1,92 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include "CoreBenchmark.h"
+
+#include <core/Essentials.h>
+#include <core/Entity.h>
+#include <core/Components/Transform.h>
+#include <core/Scene/Scene.h>
+#include <core/Scene/SceneSnapshot.h>
+
+#include <filesystem>
+
+namespace core { namespace Benchmark {
+
+namespace {
+
+constexpr size_t rootCount  = 100;
+constexpr size_t childCount = 100;
+
+/** Snapshot of rootCount entities with childCount children each, all with a Transform */
+struct SnapshotData {
+    string path = (std::filesystem::temp_directory_path() / "CoreSceneSnapshotBenchmark.snap").string();
+
+    SnapshotData() {
+        EntityHandle saved = Entity::Spawn("Saved", Scene::Get("Default")->Root()->GetHandle());
+        for (size_t i = 0; i < rootCount; ++i) {
+            EntityHandle root = Entity::Spawn("Root", saved);
+            root.Get()->AddComponent<Transform>();
+            for (size_t j = 0; j < childCount; ++j) {
+                EntityHandle child = Entity::Spawn("Child", root);
+                child.Get()->AddComponent<Transform>();
+                child.GetComponent<Transform>()->SetPosition(Vector3(float(i), float(j), 0));
+            }
+        }
+        SceneSnapshot::Save(path, saved);
+        Entity::Destroy(saved);
+    }
+};
+
+const SnapshotData& GetSnapshotData() {
+    static const SnapshotData data;
+    return data;
+}
+
+}
+
+void CoreBenchmark::SceneSnapshotDecode() {
+    const SnapshotData& data = GetSnapshotData();
+
+    size_t entities = 0;
+    CORRADE_BENCHMARK(1) {
+        entities += SceneSnapshot::Decode(data.path).entities.size;
+    }
+    CORRADE_COMPARE(entities, rootCount * (childCount + 1));
+}
+void CoreBenchmark::SceneSnapshotLoad() {
+    const SnapshotData& data = GetSnapshotData();
+    SceneSnapshot snapshot;
+    EntityHandle target = Entity::Spawn("Loaded", Scene::Get("Default")->Root()->GetHandle());
+
+    size_t roots = 0;
+    CORRADE_BENCHMARK(1) {
+        roots += snapshot.Load(data.path, target).size();
+    }
+    CORRADE_COMPARE(roots, rootCount);
+
+    Entity::Destroy(target);
+}
+
+}}
@@ -0,0 +1,210 @@
+/**
+ *  Check ComponentStorage.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_COMPONENTSTORAGE_H
+#define CORE_COMPONENTSTORAGE_H
+
+#include "Essentials.h"
+#include "Instantiable.h"
+#include "ITicker.h"
+#include "TickerPhases.h"
+
+#include <vector>
+
+namespace core {
+
+/**
+ * Type-erased interface of ComponentStorage
+ * @details Every storage is an ITicker, passing update calls to all of its components
+ */
+class IComponentStorage : public ITicker, public Instantiable<IComponentStorage> {
+public:
+    virtual ~IComponentStorage() = default;
+
+    /**
+     * Destroys component and returns its slot to the storage
+     * @param component - Component previously created by this storage
+     */
+    virtual void Release(IComponent* component) = 0;
+
+    /**
+     * Moves component to active or inactive part of the storage
+     * @note Called by IComponent::SetActive
+     */
+    virtual void SetActive(IComponent* component, bool active) = 0;
+
+    /**
+     * @return Number of components alive in this storage
+     */
+    virtual size_t Size() const = 0;
+
+    /**
+     * Get storages of component types which do work in phase
+     */
+    static const vector<IComponentStorage*>& ForPhase(TickerPhase phase) {
+        return phaseInstances[static_cast<size_t>(phase)];
+    }
+
+protected:
+
+    /**
+     * Adds storage to lists of phases in mask
+     */
+    void RegisterPhases(TickerPhaseMask mask) {
+        for (size_t i = 0; i < tickerPhaseCount; ++i) {
+            if (mask & PhaseBit(static_cast<TickerPhase>(i))) { phaseInstances[i].push_back(this); }
+        }
+    }
+
+    static inline vector<IComponentStorage*> phaseInstances[tickerPhaseCount] { };
+
+};
+
+/**
+ * Owns all components of type T
+ * @details Components are placed into fixed-size chunks, so components of the same type lie next to each other
+ * in memory and never move once created. Pointers to live components are kept in a dense array, which is walked
+ * by every update call.
+ * @tparam T - Component typename
+ */
+template<typename T>
+class ComponentStorage : public IComponentStorage {
+public:
+
+    /** Copying is not allowed */
+    ComponentStorage(const ComponentStorage&) = delete;
+
+    /** Copying is not allowed */
+    ComponentStorage& operator=(const ComponentStorage&) = delete;
+
+    /**
+     * Get storage of components of type T
+     * @note Storage is created on first call and is never destroyed
+     */
+    static ComponentStorage<T>& Get();
+
+    /**
+     * Constructs new component in the storage
+     * @param entity - Entity component is attached to
+     * @param args - Arguments passed to component's constructor
+     * @return Pointer to created component
+     */
+    template<typename ...Args>
+    T* Create(Entity& entity, Args&&... args);
+
+    void Release(IComponent* component) override;
+    void SetActive(IComponent* component, bool active) override;
+    size_t Size() const override;
+
+    /**
+     * @return Number of active components, they come first in GetComponents()
+     */
+    size_t ActiveCount() const;
+
+    /**
+     * Makes sure storage can hold count components without allocating
+     */
+    void Reserve(size_t count);
+
+    /**
+     * Dense array of pointers to all live components of type T
+     * @details Active components come first, followed by inactive ones
+     */
+    const vector<T*>& GetComponents() const;
+
+    /** Number of components fitting into one chunk */
+    static constexpr size_t chunkCapacity = sizeof(T) < 16384 ? 16384 / sizeof(T) : 1;
+
+protected:
+
+    ComponentStorage();
+
+    void Start() override;
+    void FixedTick() override;
+    void EarlyTick() override;
+    void Tick() override;
+    void LateTick() override;
+    void Stop() override;
+
+    /**
+     * Calls phase function on every active component
+     * @details Components of final types are called without virtual dispatch, so calls can be inlined,
+     * such types have to grant ComponentStorage access to their phase functions.
+     * Activation changes made during the call are applied to the dense array after every component was called
+     */
+    template<TickerPhase P>
+    void Invoke();
+
+    /**
+     * Moves components whose activity changed during Invoke to their part of the dense array
+     */
+    void ApplyPendingActivity();
+
+    /**
+     * Calls phase function of component, statically bound to T's override
+     */
+    template<TickerPhase P>
+    static void InvokeStatic(T& component);
+
+    /**
+     * Swaps two components in the dense array
+     */
+    void Swap(uint32_t a, uint32_t b);
+
+    /**
+     * Allocates new chunk and adds all its slots to the free list
+     */
+    void AllocateChunk();
+
+    struct Chunk {
+        alignas(T) unsigned char data[chunkCapacity * sizeof(T)];
+    };
+
+    /** Memory blocks components are placed in */
+    vector<unique<Chunk>> chunks     { };
+
+    /** Unoccupied slots, next slot to use is at the back */
+    vector<T*>            freeSlots  { };
+
+    /** Live components, densely packed, active ones first */
+    vector<T*>            components { };
+
+    /** Number of active components at the front of components */
+    size_t                activeCount { 0 };
+
+    /** Components which changed activity while Invoke was walking the dense array */
+    vector<T*>            pendingActivity { };
+
+    /** Is Invoke walking the dense array? */
+    bool                  invoking { false };
+
+};
+
+} // namespace core
+
+#include "ComponentStorage.tpp"
+
+#endif //CORE_COMPONENTSTORAGE_H
@@ -0,0 +1,222 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "ComponentStorage.h"
+#include "IComponent.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+namespace core {
+
+template<typename T>
+ComponentStorage<T>& ComponentStorage<T>::Get() {
+    static_assert(std::is_base_of<IComponent, T>::value, "Component T must inherit from core::IComponent");
+
+    // Intentionally never destroyed: entities owned by static containers (e.g. Scene roots)
+    // release their components after function-local statics are already gone
+    static ComponentStorage<T>* storage = new ComponentStorage<T>();
+    return *storage;
+}
+template<typename T>
+ComponentStorage<T>::ComponentStorage() {
+    RegisterPhases(TickerPhases<T>::mask);
+}
+template<typename T>
+template<typename ...Args>
+T* ComponentStorage<T>::Create(Entity& entity, Args&&... args) {
+    if (freeSlots.empty()) { AllocateChunk(); }
+
+    T* slot = freeSlots.back();
+    freeSlots.pop_back();
+
+    T* component;
+    try {
+        component = new(slot) T(entity, std::forward<Args>(args)...);
+    } catch (...) {
+        freeSlots.push_back(slot);
+        throw;
+    }
+
+    component->storage = this;
+    component->storageIndex = static_cast<uint32_t>(components.size());
+    components.push_back(component);
+
+    /* Component might have been deactivated in its constructor */
+    if (component->active) {
+        Swap(component->storageIndex, static_cast<uint32_t>(activeCount++));
+    }
+
+    return component;
+}
+template<typename T>
+void ComponentStorage<T>::Release(IComponent* base) {
+    T* component = static_cast<T*>(base);
+
+    if (invoking) {
+        pendingActivity.erase(std::remove(pendingActivity.begin(), pendingActivity.end(), component), pendingActivity.end());
+    }
+
+    /* Move component to the start of the inactive part, then to the back */
+    if (component->storageIndex < activeCount) {
+        Swap(component->storageIndex, static_cast<uint32_t>(--activeCount));
+    }
+    Swap(component->storageIndex, static_cast<uint32_t>(components.size() - 1));
+    components.pop_back();
+
+    component->~T();
+    freeSlots.push_back(component);
+}
+template<typename T>
+void ComponentStorage<T>::SetActive(IComponent* base, bool active) {
+    T* component = static_cast<T*>(base);
+    component->entity->ListComponent(component, active);
+
+    /* Swapping now would move an unvisited component behind the iteration cursor */
+    if (invoking) {
+        pendingActivity.push_back(component);
+        return;
+    }
+
+    if (active) {
+        Swap(component->storageIndex, static_cast<uint32_t>(activeCount++));
+    } else {
+        Swap(component->storageIndex, static_cast<uint32_t>(--activeCount));
+    }
+}
+template<typename T>
+void ComponentStorage<T>::ApplyPendingActivity() {
+    for (T* component : pendingActivity) {
+        const bool inActivePart = component->storageIndex < activeCount;
+        if (component->active == inActivePart) { continue; }
+
+        if (component->active) {
+            Swap(component->storageIndex, static_cast<uint32_t>(activeCount++));
+        } else {
+            Swap(component->storageIndex, static_cast<uint32_t>(--activeCount));
+        }
+    }
+    pendingActivity.clear();
+}
+template<typename T>
+size_t ComponentStorage<T>::ActiveCount() const {
+    return activeCount;
+}
+template<typename T>
+void ComponentStorage<T>::Swap(uint32_t a, uint32_t b) {
+    std::swap(components[a], components[b]);
+    components[a]->storageIndex = a;
+    components[b]->storageIndex = b;
+}
+template<typename T>
+size_t ComponentStorage<T>::Size() const {
+    return components.size();
+}
+template<typename T>
+void ComponentStorage<T>::Reserve(size_t count) {
+    while (freeSlots.size() < count) {
+        AllocateChunk();
+    }
+    components.reserve(components.size() + count);
+}
+template<typename T>
+const vector<T*>& ComponentStorage<T>::GetComponents() const {
+    return components;
+}
+template<typename T>
+void ComponentStorage<T>::AllocateChunk() {
+    chunks.push_back(unique<Chunk>(new Chunk));
+
+    /* Push slots in reverse, so they are taken in address order */
+    T* slots = reinterpret_cast<T*>(chunks.back()->data);
+    for (size_t i = chunkCapacity; i > 0; --i) {
+        freeSlots.push_back(slots + i - 1);
+    }
+}
+template<typename T>
+template<TickerPhase P>
+void ComponentStorage<T>::Invoke() {
+    invoking = true;
+    try {
+        // Indexed loop, since components might be created while iterating
+        for (size_t i = 0; i < activeCount; ) {
+            T* component = components[i];
+
+            /* Deactivated by another component earlier in this phase, still in the active part */
+            if (!component->active) { ++i; continue; }
+
+            if constexpr (std::is_final<T>::value) {
+                InvokeStatic<P>(*component);
+            } else {
+                (static_cast<ITicker*>(component)->*PhaseFunction(P))();
+            }
+
+            /* Component released itself, slot i now holds one which was not called yet */
+            if (i < components.size() && components[i] != component) { continue; }
+            ++i;
+        }
+    } catch (...) {
+        invoking = false;
+        ApplyPendingActivity();
+        throw;
+    }
+    invoking = false;
+    ApplyPendingActivity();
+}
+template<typename T>
+template<TickerPhase P>
+void ComponentStorage<T>::InvokeStatic(T& component) {
+    if constexpr (P == TickerPhase::Start)     { component.T::Start(); }
+    if constexpr (P == TickerPhase::FixedTick) { component.T::FixedTick(); }
+    if constexpr (P == TickerPhase::EarlyTick) { component.T::EarlyTick(); }
+    if constexpr (P == TickerPhase::Tick)      { component.T::Tick(); }
+    if constexpr (P == TickerPhase::LateTick)  { component.T::LateTick(); }
+    if constexpr (P == TickerPhase::Stop)      { component.T::Stop(); }
+}
+template<typename T>
+void ComponentStorage<T>::Start() {
+    Invoke<TickerPhase::Start>();
+}
+template<typename T>
+void ComponentStorage<T>::FixedTick() {
+    Invoke<TickerPhase::FixedTick>();
+}
+template<typename T>
+void ComponentStorage<T>::EarlyTick() {
+    Invoke<TickerPhase::EarlyTick>();
+}
+template<typename T>
+void ComponentStorage<T>::Tick() {
+    Invoke<TickerPhase::Tick>();
+}
+template<typename T>
+void ComponentStorage<T>::LateTick() {
+    Invoke<TickerPhase::LateTick>();
+}
+template<typename T>
+void ComponentStorage<T>::Stop() {
+    Invoke<TickerPhase::Stop>();
+}
+
+} // namespace core
@@ -0,0 +1,173 @@
+/*
+ * This is a stand-alone header file. No ComponentType.cpp is presented.
+ */
+
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_COMPONENTTYPE_H
+#define CORE_COMPONENTTYPE_H
+
+#include "Essentials.h"
+#include "Logger.h"
+
+#include <atomic>
+#include <stdexcept>
+#include <typeinfo>
+
+#ifndef CORE_MAX_COMPONENT_TYPES
+#   define CORE_MAX_COMPONENT_TYPES 256
+#endif
+
+#ifdef _MSC_VER
+#   include <intrin.h>
+#endif
+
+namespace core {
+
+using ComponentTypeId = uint32_t;
+
+/**
+ * Assigns dense ids to component types
+ * @details Ids are given out in order of first use, starting from 0,
+ * so they can be used as indices and bit positions
+ */
+class ComponentType {
+public:
+
+    /**
+     * Get id of component type T
+     * @note First call assigns the id, every next call is a single static load
+     * @throw std::logic_error if more than CORE_MAX_COMPONENT_TYPES types are used
+     */
+    template<typename T>
+    static ComponentTypeId Id() {
+        static const ComponentTypeId id = NextId(typeid(T).name());
+        return id;
+    }
+
+    /**
+     * @return Number of component types that have an id
+     */
+    static ComponentTypeId Count() {
+        return typeIdCounter.load();
+    }
+
+private:
+
+    static ComponentTypeId NextId(const char* typeName) {
+        const ComponentTypeId id = typeIdCounter++;
+        if (id >= CORE_MAX_COMPONENT_TYPES) {
+            Logger::Log(INTERNAL, ERR_HERE) << "Component type " << typeName << " exceeds CORE_MAX_COMPONENT_TYPES";
+            throw std::logic_error("Component type " + string(typeName) + " exceeds CORE_MAX_COMPONENT_TYPES");
+        }
+        return id;
+    }
+
+    static inline std::atomic<ComponentTypeId> typeIdCounter { 0 };
+
+};
+
+/**
+ * Set of component types, one bit per ComponentTypeId
+ */
+class ComponentSignature {
+public:
+
+    void Set(ComponentTypeId id) {
+        words[id / 64] |= bit(id);
+    }
+
+    void Reset(ComponentTypeId id) {
+        words[id / 64] &= ~bit(id);
+    }
+
+    bool Test(ComponentTypeId id) const {
+        return (words[id / 64] & bit(id)) != 0;
+    }
+
+    /**
+     * Count types in the signature with id lower than given one
+     * @details If components are kept sorted by type id, this is the index of component with this id
+     */
+    uint32_t Rank(ComponentTypeId id) const {
+        uint32_t rank = 0;
+        for (size_t i = 0; i < id / 64; ++i) {
+            rank += popcount(words[i]);
+        }
+        return rank + popcount(words[id / 64] & (bit(id) - 1));
+    }
+
+    /**
+     * Does this signature have every type of other signature?
+     */
+    bool Contains(const ComponentSignature& other) const {
+        for (size_t i = 0; i < wordCount; ++i) {
+            if ((words[i] & other.words[i]) != other.words[i]) { return false; }
+        }
+        return true;
+    }
+
+    /**
+     * Does this signature share at least one type with other signature?
+     */
+    bool Intersects(const ComponentSignature& other) const {
+        for (size_t i = 0; i < wordCount; ++i) {
+            if ((words[i] & other.words[i]) != 0) { return true; }
+        }
+        return false;
+    }
+
+    bool operator==(const ComponentSignature& rhs) const {
+        for (size_t i = 0; i < wordCount; ++i) {
+            if (words[i] != rhs.words[i]) { return false; }
+        }
+        return true;
+    }
+    bool operator!=(const ComponentSignature& rhs) const {
+        return !(*this == rhs);
+    }
+
+private:
+
+    static constexpr size_t wordCount = (CORE_MAX_COMPONENT_TYPES + 63) / 64;
+
+    static uint64_t bit(ComponentTypeId id) {
+        return uint64_t(1) << (id % 64);
+    }
+
+    static uint32_t popcount(uint64_t word) {
+    #ifdef _MSC_VER
+        return static_cast<uint32_t>(__popcnt64(word));
+    #else
+        return static_cast<uint32_t>(__builtin_popcountll(word));
+    #endif
+    }
+
+    uint64_t words[wordCount] { };
+
+};
+
+} // namespace core
+
+#endif //CORE_COMPONENTTYPE_H
@@ -33,5 +33,7 @@
 #include <core/Components/Renderer.h>
 #include <core/Components/Camera.h>
 #include <core/Components/Script.h>
+#include <core/Components/Bounds.h>
+#include <core/Components/Occluder.h>
 
 #endif //CORE_COMPONENTS_H
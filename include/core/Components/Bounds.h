@@ -0,0 +1,97 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_COMPONENT_BOUNDS_H
+#define CORE_COMPONENT_BOUNDS_H
+
+#include <core/Essentials.h>
+#include <core/IComponent.h>
+#include <core/Handle.h>
+#include <core/Math.h>
+#include <core/Scene/BoundingVolumeTree.h>
+
+namespace core {
+
+/**
+ * Axis-aligned bounds of the entity, kept in the scene-wide spatial index
+ * @details World bounds are recomputed by TransformSystem whenever the entity's
+ * world transform changes, inactive bounds are removed from the index
+ */
+class Bounds : public IComponent {
+public:
+    explicit Bounds(Entity& parent,
+                    const Range3D& localBounds = { { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } },
+                    const string& name = "Bounds");
+    ~Bounds() override;
+
+    /**
+     * Set bounds relative to the entity's transform
+     */
+    void SetLocalBounds(const Range3D& bounds);
+
+    /**
+     * Get bounds relative to the entity's transform
+     */
+    const Range3D& GetLocalBounds() const;
+
+    /**
+     * Get bounds in world space
+     * @note Up to date after TransformSystem update
+     */
+    const Range3D& GetWorldBounds() const;
+
+    /**
+     * Spatial index of world bounds of all active Bounds components
+     * @details Use its queries for proximity, picking and visibility tests instead of scanning entities
+     * @note Not thread-safe, modified on the main thread by TransformSystem.
+     * Intentionally never destroyed, same as ComponentStorage
+     */
+    static BoundingVolumeTree<EntityHandle>& GetIndex();
+
+protected:
+    friend class TransformSystem;
+
+    /**
+     * Recomputes world bounds from the world matrix and moves them in the index
+     */
+    void UpdateWorldBounds(const Matrix4& worldTransform);
+
+    void OnActiveChanged(bool active) override;
+
+    /** Bounds relative to the entity's transform */
+    Range3D    localBounds;
+
+    /** Bounds in world space, enclosing transformed local bounds */
+    Range3D    worldBounds;
+
+    /** Sibling Transform */
+    Transform* transform { nullptr };
+
+    /** Proxy in the index, none while inactive */
+    uint32_t   proxy { BoundingVolumeTree<EntityHandle>::none };
+
+};
+
+} // namespace core
+
+#endif //CORE_COMPONENT_BOUNDS_H
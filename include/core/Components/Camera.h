@@ -29,9 +29,11 @@
 #include "core/LayerLinked.h"
 #include "core/CameraList.h"
 #include "core/Entity.h"
+#include "core/Event.h"
 #include "core/Layer.h"
 #include "core/Math.h"
 #include "core/View.h"
+#include "core/Scene/OcclusionBuffer.h"
 
 namespace core {
 
@@ -56,10 +58,28 @@ public:
 
     /**
      * Calls Layer::Draw() on every linked layer
-     * @details Everything on the layer gets drawn onto the attached view
+     * @details Everything on the layer inside of the camera frustum gets drawn onto the attached view
      */
     void Draw();
 
+    /**
+     * Get frustum culling counters of the last Draw() call
+     */
+    const CullingStats& GetCullingStats() const;
+
+    /**
+     * Enable or disable occlusion culling
+     * @details When enabled, every Draw() rasterizes active Occluder components of linked layers into
+     * a CPU depth buffer of given size and skips drawables hidden behind them
+     */
+    void SetOcclusionCulling(bool enabled, uint32_t width = 256, uint32_t height = 128);
+
+    /**
+     * Get depth buffer used for occlusion culling
+     * @return nullptr if occlusion culling is disabled
+     */
+    const OcclusionBuffer* GetOcclusionBuffer() const;
+
     /**
      * Get internal perspective matrix of the camera
      * @return Matrix4&
@@ -114,9 +134,11 @@ public:
 
 protected:
 
-    void Tick() override;
     void Start() override;
 
+    /** Only active cameras are drawn */
+    void OnActiveChanged(bool active) override;
+
     /**
      * Sets internal transfrom matrix
      * @details Updates internal projection matrix of the camera
@@ -168,6 +190,18 @@ protected:
     Matrix4* transformMtx;
     Matrix4  perspectiveMtx;
     Matrix4  projectionMtx;
+
+    /** Frustum culling counters of the last draw */
+    CullingStats cullingStats;
+
+    /** Occluders depth buffer, exists while occlusion culling is enabled */
+    unique<OcclusionBuffer> occlusionBuffer;
+
+    /** Transform::OnTransformChange subscription, dropped with the camera */
+    Subscription transformSubscription;
+
+    /** View::OnResize subscription of the attached view */
+    Subscription resizeSubscription;
 };
 
 class SceneCamera : public Camera {
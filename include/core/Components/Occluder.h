@@ -0,0 +1,70 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_COMPONENT_OCCLUDER_H
+#define CORE_COMPONENT_OCCLUDER_H
+
+#include <core/Essentials.h>
+#include <core/IComponent.h>
+#include <core/Math.h>
+
+namespace core {
+
+/**
+ * Box hiding objects behind it from cameras with occlusion culling enabled
+ * @details Box has to fit inside of the entity's drawn geometry, walls and building cores make good occluders
+ */
+class Occluder : public IComponent {
+public:
+    explicit Occluder(Entity& parent,
+                      const Range3D& box = { { -0.5f, -0.5f, -0.5f }, { 0.5f, 0.5f, 0.5f } },
+                      const string& name = "Occluder");
+
+    /**
+     * Set occluding box relative to the entity's transform
+     */
+    void SetBox(const Range3D& box);
+
+    /**
+     * Get occluding box relative to the entity's transform
+     */
+    const Range3D& GetBox() const;
+
+    /**
+     * Get world transform matrix of the entity
+     */
+    const Matrix4& GetWorldTransformMatrix() const;
+
+protected:
+
+    /** Occluding box relative to the entity's transform */
+    Range3D    box;
+
+    /** Sibling Transform */
+    Transform* transform { nullptr };
+
+};
+
+} // namespace core
+
+#endif //CORE_COMPONENT_OCCLUDER_H
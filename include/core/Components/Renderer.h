@@ -41,11 +41,33 @@ public:
              const shared<Model>& model,
              const string& name = "Renderer");
 
+    /**
+     * Asset the Model was imported from
+     */
+    struct Source {
+        /** Path of imported scene file */
+        string   path;
+
+        /** Object id in the imported scene */
+        uint32_t object { 0 };
+    };
+
+    /**
+     * Records asset the Model was imported from, so the Renderer can be saved in SceneSnapshot
+     */
+    void SetSource(const Source& source);
+
+    /**
+     * Get asset the Model was imported from
+     * @return Source with empty path if Model was not imported
+     */
+    const Source& GetSource() const;
+
 protected:
 
     /**
      * Draws attached Model
-     * calculates transform matrix based on attached Transfrom component values,
+     * uploads transform matrix of attached Transform component if it has changed since last draw,
      * uses provided projMtx as projection matrix
      * @param camera - projection matrix
      */
@@ -66,12 +88,33 @@ protected:
      */
     void SetLight(Light& light) override;
 
+    /**
+     * Encloses bounding sphere of the Model's mesh in world space
+     * @details Recomputed only if attached Transform has changed since last call
+     */
+    bool GetBoundingSphere(Vector4& sphere) override;
+
     /** Managed Model */
     shared<Model>   model;
     
     /** Sibling Transform */
     Transform*      transform { nullptr };
 
+    /** Version of transform last uploaded to the Model */
+    uint32_t        uploadedVersion { 0 };
+
+    /** Asset the Model was imported from */
+    Source          source { };
+
+    /** World space bounding sphere, center in xyz and radius in w */
+    Vector4         boundingSphere { };
+
+    /** Version of transform bounding sphere was computed from */
+    uint32_t        boundingSphereVersion { 0 };
+
+    /** Was bounding sphere computed at least once? */
+    bool            hasBoundingSphere { false };
+
 };
 
 }
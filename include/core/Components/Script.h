@@ -30,22 +30,72 @@
 #include <core/Essentials.h>
 #include <core/IComponent.h>
 #include <core/ScriptedBehaviour.h>
+#include <core/TickerPhases.h>
+
+#include <type_traits>
+#include <utility>
 
 namespace core {
 
+#define CORE_SCRIPT_PHASE_ACCESS(Phase)                                                                             \
+    template<typename U, typename = void>                                                                           \
+    struct Phase##Access : std::false_type { };                                                                     \
+    template<typename U>                                                                                            \
+    struct Phase##Access<U, std::void_t<decltype(std::declval<U&>().U::Phase())>> : std::true_type { };
+
+/**
+ * Finds out which phase functions of T can be called from outside of T
+ * @details Overrides declared protected or private are not accessible
+ */
+template<typename T>
+class ScriptPhaseAccess {
+    CORE_SCRIPT_PHASE_ACCESS(Start)
+    CORE_SCRIPT_PHASE_ACCESS(FixedTick)
+    CORE_SCRIPT_PHASE_ACCESS(EarlyTick)
+    CORE_SCRIPT_PHASE_ACCESS(Tick)
+    CORE_SCRIPT_PHASE_ACCESS(LateTick)
+    CORE_SCRIPT_PHASE_ACCESS(Stop)
+
+public:
+    static constexpr bool Accessible(TickerPhase phase) {
+        switch (phase) {
+            case TickerPhase::Start:     return StartAccess<T>::value;
+            case TickerPhase::FixedTick: return FixedTickAccess<T>::value;
+            case TickerPhase::EarlyTick: return EarlyTickAccess<T>::value;
+            case TickerPhase::Tick:      return TickAccess<T>::value;
+            case TickerPhase::LateTick:  return LateTickAccess<T>::value;
+            case TickerPhase::Stop:      return StopAccess<T>::value;
+        }
+        return false;
+    }
+};
+
+#undef CORE_SCRIPT_PHASE_ACCESS
+
 /**
- * Handles lifetime of ScriptedBehaviour, passes all ITcker calls to it
+ * Holds ScriptedBehaviour of type T inline, passes all ITicker calls to it
+ * @details Scripts of the same T share one storage and are ticked together. Public overrides of T are
+ * called statically bound, protected and private ones are called through ITicker. That call is still virtual
+ * in general, so keep overrides public in hot behaviours
  */
 template<typename T>
-class Script : public IComponent {
+class Script final : public IComponent {
 static_assert(std::is_base_of<ScriptedBehaviour, T>::value, "Script T must inherit from ScriptedBehaviour");
 
 public:
     
     Script(Entity& parent, const string& name = "Script");
-    ~Script();
+
+    /**
+     * Get attached behaviour
+     */
+    T& GetBehaviour();
+
+    /** Script does work only in phases its behaviour overrides */
+    static constexpr TickerPhaseMask tickerPhases = TickerPhases<T>::mask;
 
 protected:
+    template<typename> friend class ComponentStorage;
     
     void FixedTick() override;
     void EarlyTick() override;
@@ -53,10 +103,15 @@ protected:
     void Tick() override;
     void Stop() override;
     void LateTick() override;
-    
 
-    /** Attached ScriptedBehaviour */
-    ScriptedBehaviour* scriptedBehaviour;
+    /**
+     * Calls phase function of behaviour, statically bound if T's override is accessible
+     */
+    template<TickerPhase P>
+    void InvokeBehaviour();
+
+    /** Attached behaviour */
+    T behaviour;
 };
 
 } // namespace core
@@ -32,36 +32,48 @@ template<typename T>
 Script<T>::Script(Entity &parent, const string &name)
 : IComponent(parent, name)
 {
-    scriptedBehaviour = new T;
-    scriptedBehaviour->SetEntity(entity);
+    behaviour.SetEntity(entity->GetHandle());
 }
 template<typename T>
-Script<T>::~Script() {
-    delete scriptedBehaviour;
+T& Script<T>::GetBehaviour() {
+    return behaviour;
+}
+template<typename T>
+template<TickerPhase P>
+void Script<T>::InvokeBehaviour() {
+    if constexpr (!ScriptPhaseAccess<T>::Accessible(P)) {
+        (static_cast<ITicker&>(behaviour).*PhaseFunction(P))();
+    }
+    else if constexpr (P == TickerPhase::Start)     { behaviour.T::Start(); }
+    else if constexpr (P == TickerPhase::FixedTick) { behaviour.T::FixedTick(); }
+    else if constexpr (P == TickerPhase::EarlyTick) { behaviour.T::EarlyTick(); }
+    else if constexpr (P == TickerPhase::Tick)      { behaviour.T::Tick(); }
+    else if constexpr (P == TickerPhase::LateTick)  { behaviour.T::LateTick(); }
+    else if constexpr (P == TickerPhase::Stop)      { behaviour.T::Stop(); }
 }
 template<typename T>
 void Script<T>::FixedTick() {
-    scriptedBehaviour->FixedTick();
+    InvokeBehaviour<TickerPhase::FixedTick>();
 }
 template<typename T>
 void Script<T>::EarlyTick() {
-    scriptedBehaviour->EarlyTick();
+    InvokeBehaviour<TickerPhase::EarlyTick>();
 }
 template<typename T>
 void Script<T>::Tick() {
-    scriptedBehaviour->Tick();
+    InvokeBehaviour<TickerPhase::Tick>();
 }
 template<typename T>
 void Script<T>::LateTick() {
-    scriptedBehaviour->LateTick();
+    InvokeBehaviour<TickerPhase::LateTick>();
 }
 template<typename T>
 void Script<T>::Start() {
-    scriptedBehaviour->Start();
+    InvokeBehaviour<TickerPhase::Start>();
 }
 template<typename T>
 void Script<T>::Stop() {
-    scriptedBehaviour->Stop();
+    InvokeBehaviour<TickerPhase::Stop>();
 }
 
 } // namespace core
@@ -29,6 +29,8 @@
 #include <core/Math.h>
 #include <core/Event.h>
 
+#include <atomic>
+
 namespace core {
 
 class Transform : public IComponent {
@@ -40,13 +42,26 @@ public:
     Event<Vector3>    OnScaleChange;
     Event<Quaternion> OnRotationChange;
     
+    /**
+     * Get transform matrix relative to the world
+     * @note Recomputed by TransformSystem once per frame, before cameras draw
+     */
     Matrix4&    GetWorldTransformMatrix();
+
+    /**
+     * Get matrix transforming normals to world space
+     * @note Extracted by TransformSystem in one batch together with other recomputed transforms
+     */
+    const Matrix3x3& GetNormalMatrix() const;
+
+    /**
+     * Get transform matrix relative to the parent transform
+     */
     Matrix4&    GetTransformMatrix();
     Vector3&    GetPosition();
     Quaternion& GetRotation();
     Vector3&    GetScale();
 
-    void SetParent(Transform* parent);
     void SetRotation(const Quaternion& rotation);
     void SetRotation(const Quaternion&& rotation);
     void SetPosition(Vector3& position);
@@ -61,11 +76,25 @@ public:
     void Scale(Vector3& scale);
     void Scale(Vector3&& scale);
 
+    /**
+     * Queues world matrix of this transform and of all transforms below it for recomputation
+     */
+    void Invalidate();
+
 protected:
+    friend class TransformSystem;
 
-    void Tick() override;
+    /**
+     * Marks local matrix outdated
+     */
     void UpdateTransform();
 
+    /**
+     * Recomputes outdated local matrix and world matrix from the parent entity's transform
+     * @note Parent's world matrix is expected to be up to date
+     */
+    void UpdateWorldTransform();
+
     /** Vector representing position of the entity */
     Vector3    position { 0, 0, 0 };
 
@@ -76,7 +105,14 @@ protected:
     Vector3    scale    { 1, 1, 1 };
 
     Matrix4     localTransform { };
-    Matrix4*    parentTransform;
+    Matrix4     worldTransform { };
+    Matrix3x3   normalMatrix   { };
+
+    /** Local matrix does not match position, rotation and scale */
+    bool        localDirty { true };
+
+    /** Transform is waiting in TransformSystem queue, set from any thread writing the transform */
+    std::atomic<bool> queued { false };
 
 };
 
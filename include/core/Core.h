@@ -35,6 +35,7 @@
 #include "TypeMap.h"
 #include "Object.h"
 #include "Pool.h"
+#include "JobSystem.h"
 
 #include <memory>
 #include <iterator>
@@ -57,6 +58,12 @@ public:
     template<class T>
     static int32_t GetModuleId();
 
+    /**
+     * Get job system shared by all modules
+     * @throw std::logic_error if Core was not built yet
+     */
+    static JobSystem& GetJobSystem();
+
     template<class ModuleType, class Deleter, class ...Deps>
     std::unique_ptr<ModuleType, Deleter> Inject(ModuleFactory<ModuleType, Deleter, Deps...> moduleFactory) const;
 
@@ -64,6 +71,9 @@ private:
     Core() : Object("Core") { };
 
     static ModuleMap moduleMap;
+
+    /** Created by CoreConfig::Build() before any module */
+    unique<JobSystem> jobSystem;
 };
 
 }
@@ -32,6 +32,8 @@
 #include "Essentials.h"
 #include "ModuleContainer.h"
 #include "Core.h"
+#include "IModule.h"
+#include "JobSystem.h"
 
 #include <functional>
 #include <unordered_set>
@@ -55,6 +57,13 @@ public:
     template <class InstanceType, class Deleter, class ...Deps>
     CoreConfig& Add(ModuleFactory<InstanceType, Deleter, Deps...> moduleFactory);
 
+    /**
+     * Sets number of worker threads of the Core job system
+     * @details Defaults to number of hardware threads minus the main one
+     * @return reference to this CoreConfig
+     */
+    CoreConfig& SetWorkerCount(uint32_t count);
+
     /**
      * Creates new Core object from this config
      * @return core::Core object
@@ -122,6 +131,11 @@ private:
      */
     std::unordered_map<int, NodeInfo> graph;
 
+    /**
+     * Number of job system worker threads
+     */
+    uint32_t workerCount { JobSystem::DefaultWorkerCount() };
+
 };
 
 }
@@ -38,6 +38,11 @@ CoreConfig& CoreConfig::Add(ModuleFactory<ModuleType, Deleter, Deps...> moduleFa
 
     newNodeInfo.initializer = [moduleFactory](Core &core) {
         auto instance = WrapIntoModuleContainer(core.Inject(moduleFactory));
+
+        /* Skip the module in phases it does not override */
+        using Module = typename std::remove_const<ModuleType>::type;
+        static_cast<IModule*>(static_cast<Module*>(instance->Get()))->SetPhases(TickerPhases<Module>::mask);
+
         Core::moduleMap.Put<ModuleType>(std::move(instance));
     };
     newNodeInfo.hasIniliatizer = true;
@@ -0,0 +1,111 @@
+/**
+ *  Check Delegate.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_DELEGATE_H
+#define CORE_DELEGATE_H
+
+#include "core/Essentials.h"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace core {
+
+template<typename Signature>
+class Delegate;
+
+/**
+ * Move-only type-erased callable stored in a fixed inline buffer
+ * @details Unlike std::function, never allocates: callables that don't fit into bufferSize bytes
+ * are rejected at compile time. Invocation is a single indirect call
+ */
+template<typename R, typename ...Args>
+class Delegate<R(Args...)> {
+public:
+    /** Fits a lambda capturing up to four pointers */
+    static constexpr size_t bufferSize = 4 * sizeof(void*);
+
+    Delegate() = default;
+
+    /**
+     * Store callable f inside of the delegate
+     * @note Callable must fit into bufferSize bytes and be nothrow move constructible
+     */
+    template<typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, Delegate>::value>>
+    Delegate(F&& f);
+
+    Delegate(Delegate&& other) noexcept;
+    Delegate& operator=(Delegate&& other) noexcept;
+
+    /** Copying is not allowed */
+    Delegate(const Delegate&) = delete;
+
+    /** Copying is not allowed */
+    Delegate& operator=(const Delegate&) = delete;
+
+    ~Delegate();
+
+    /**
+     * Invoke stored callable
+     * @note Delegate is expected to be non-empty
+     */
+    R operator()(Args... args) const;
+
+    /**
+     * Destroy stored callable, leaving delegate empty
+     */
+    void Reset();
+
+    explicit operator bool() const { return invoker != nullptr; }
+
+private:
+
+    using Invoker = R (*)(void*, Args...);
+
+    /** Move-constructs callable from src into dst and destroys src; only destroys src if dst is nullptr */
+    using Manager = void (*)(void* dst, void* src);
+
+    template<typename F>
+    static R Invoke(void* storage, Args... args);
+
+    template<typename F>
+    static void Manage(void* dst, void* src);
+
+    void MoveFrom(Delegate& other);
+
+    alignas(std::max_align_t) mutable unsigned char storage[bufferSize];
+
+    Invoker invoker { nullptr };
+
+    /** Stays nullptr for trivially copyable callables, those are moved with memcpy */
+    Manager manager { nullptr };
+};
+
+} // namespace core
+
+#include "Delegate.tpp"
+
+#endif //CORE_DELEGATE_H
@@ -0,0 +1,99 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "Delegate.h"
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+namespace core {
+
+template<typename R, typename ...Args>
+template<typename F, typename>
+Delegate<R(Args...)>::Delegate(F&& f) {
+    using Callable = std::decay_t<F>;
+    static_assert(sizeof(Callable) <= bufferSize, "Callable is too big for Delegate, capture less or capture by pointer");
+    static_assert(alignof(Callable) <= alignof(std::max_align_t), "Callable is over-aligned for Delegate");
+    static_assert(std::is_nothrow_move_constructible<Callable>::value, "Callable stored in Delegate must be nothrow move constructible");
+
+    ::new (static_cast<void*>(storage)) Callable(std::forward<F>(f));
+    invoker = &Invoke<Callable>;
+    if (!(std::is_trivially_copyable<Callable>::value && std::is_trivially_destructible<Callable>::value)) {
+        manager = &Manage<Callable>;
+    }
+}
+template<typename R, typename ...Args>
+Delegate<R(Args...)>::Delegate(Delegate&& other) noexcept {
+    MoveFrom(other);
+}
+template<typename R, typename ...Args>
+Delegate<R(Args...)>& Delegate<R(Args...)>::operator=(Delegate&& other) noexcept {
+    if (this != &other) {
+        Reset();
+        MoveFrom(other);
+    }
+    return *this;
+}
+template<typename R, typename ...Args>
+Delegate<R(Args...)>::~Delegate() {
+    Reset();
+}
+template<typename R, typename ...Args>
+R Delegate<R(Args...)>::operator()(Args... args) const {
+    return invoker(storage, std::forward<Args>(args)...);
+}
+template<typename R, typename ...Args>
+void Delegate<R(Args...)>::Reset() {
+    if (manager) { manager(nullptr, storage); }
+    invoker = nullptr;
+    manager = nullptr;
+}
+template<typename R, typename ...Args>
+template<typename F>
+R Delegate<R(Args...)>::Invoke(void* storage, Args... args) {
+    return (*std::launder(static_cast<F*>(storage)))(std::forward<Args>(args)...);
+}
+template<typename R, typename ...Args>
+template<typename F>
+void Delegate<R(Args...)>::Manage(void* dst, void* src) {
+    F* callable = std::launder(static_cast<F*>(src));
+    if (dst) { ::new (dst) F(std::move(*callable)); }
+    callable->~F();
+}
+template<typename R, typename ...Args>
+void Delegate<R(Args...)>::MoveFrom(Delegate& other) {
+    if (!other.invoker) { return; }
+
+    if (other.manager) {
+        other.manager(storage, other.storage);
+    } else {
+        std::memcpy(storage, other.storage, bufferSize);
+    }
+    invoker = other.invoker;
+    manager = other.manager;
+    other.invoker = nullptr;
+    other.manager = nullptr;
+}
+
+}
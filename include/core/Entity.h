@@ -28,8 +28,11 @@
 #define INTERFACERS_ENTITY_H
 
 #include "Essentials.h"
-#include "Instantiable.h"
+#include "Handle.h"
 #include "IComponent.h"
+#include "ComponentStorage.h"
+#include "ComponentType.h"
+#include "TickerPhases.h"
 #include "Object.h"
 #include "Layer.h"
 #include "IDrawable.h"
@@ -46,13 +49,43 @@ namespace core {
  *  Class of every object appearing on the scene.
  *  @note Not derivable, use Component system instead
  */
-class Entity final : public Object, public ITicker, public SceneObject<Entity>, public Instantiable<Entity> {
+class Entity final : public Object, public ITicker, public Referable<Entity>, public SceneObject<Entity> {
 public:
     explicit Entity(const string&    name = "Entity",
-                    shared<Entity> parent = Scene::Get("Default")->Root(),
+                    EntityHandle   parent = Scene::Get("Default")->Root()->GetHandle(),
                     shared<Layer>   layer = Layer::Get("Default") );
     ~Entity() final;
 
+    /**
+     * Creates new Entity owned by the engine
+     * @details Entity lives until Entity::Destroy(EntityHandle) is called on it or on any of its parents
+     * @return Handle to created Entity
+     */
+    static EntityHandle Spawn(const string&    name = "Entity",
+                              EntityHandle   parent = Scene::Get("Default")->Root()->GetHandle(),
+                              shared<Layer>   layer = Layer::Get("Default") );
+
+    /**
+     * Creates count engine-owned entities from prefab in one pass
+     * @details Storage for entities and their components is reserved up front
+     * @return Handles to created entities, in order of creation
+     */
+    static vector<EntityHandle> SpawnBatch(const Prefab& prefab,
+                                           size_t count,
+                                           EntityHandle parent = Scene::Get("Default")->Root()->GetHandle() );
+
+    /**
+     * Makes sure count entities can be spawned without allocating memory for them
+     */
+    static void Reserve(size_t count);
+
+    /**
+     * Spawned entities are placed in recycled memory blocks
+     * @note Blocks of destroyed entities are kept for next entities, instead of being returned to the heap
+     */
+    static void* operator new(size_t size);
+    static void operator delete(void* memory);
+
     /**
      * Creates new Component c and adds it to Entity,
      * passing additional arguments to the component's constructor
@@ -60,6 +93,7 @@ public:
      * @tparam T - component typename
      * @tparam Args - Arguments passed to Component's constructor
      * @return Reference to this Entity, allowing method chaining
+     * @throw std::logic_error, if Entity already has Component T
      */
     template<typename T, typename ...Args>
     Entity& AddComponent(Args... args);
@@ -72,6 +106,7 @@ public:
      * @tparam S - Component typename
      * @tparam Args - Arguments passed to Component's constructor
      * @return Reference to this Entity, allowing method chaining
+     * @throw std::logic_error, if Entity already has Component T<S>
      */
     template<template<typename> typename T, typename S, typename ...Args>
     Entity& AddComponent(Args... args);
@@ -81,6 +116,7 @@ public:
      * @tparam T - Component typename
      * @return Component* if Entity has it, nullptr otherwise
      * @note Use Entity::HasComponent<T>() to make sure component exists
+     * @details Constant time, no RTTI involved
      */
     template<typename T>
     T* GetComponent();
@@ -94,6 +130,18 @@ public:
     template<typename T>
     bool HasComponent();
 
+    /**
+     * Get set of component types attached to this entity
+     */
+    const ComponentSignature& GetSignature() const;
+
+    /**
+     * Sets entity as a child of parent
+     * @details Transform of this entity is recomputed relative to the new parent before the next draw
+     * @param parent - new parent, invalid handle detaches entity
+     */
+    void SetParent(EntityHandle parent);
+
     /**
      * Checks if entity has component of type T, required by component of type C, logs error & throws if it does not
      * @param caller - Pointer to calling component
@@ -127,6 +175,13 @@ public:
      */
     static void Destroy(shared<Entity>& entity);
 
+    /**
+     * Destroys entity created with Entity::Spawn and its children
+     * @note Entities not owned by the engine are only detached from their parent
+     * @details Does nothing if handle is no longer valid
+     */
+    static void Destroy(EntityHandle entity);
+
 
     bool operator==(const Entity &rhs) const;
     bool operator!=(const Entity &rhs) const;
@@ -134,6 +189,7 @@ public:
 protected:
     friend class SceneModule;
     friend class Layer;
+    template<typename T> friend class ComponentStorage;
 
     /** Passes FixedTick to all components of this entity */
     void Start() override;
@@ -154,13 +210,44 @@ protected:
     void Stop() override;
 
 
+    /**
+     * Components attached to this entity
+     * @note Components are owned by their ComponentStorage, released on Entity destruction
+     * @details bases are sorted by ComponentTypeId, so component of type T is found
+     * at signature.Rank(ComponentType::Id<T>()). Tickers are listed only in phases their type overrides
+     */
     struct ComponentsListing {
-        vector<shared<IComponent>>  bases         { };
-        vector<ITicker*>            tickers       { };
+        ComponentSignature          signature     { };
+        vector<IComponent*>         bases         { };
+        vector<ITicker*>            tickers[tickerPhaseCount] { };
         vector<IDrawable*>          drawables     { };
     } components;
 
     shared<Layer> layer;
+
+    /** Was this entity created by Entity::Spawn */
+    bool spawned { false };
+
+private:
+
+    /**
+     * Puts component into the listing
+     */
+    template<typename T>
+    void AttachComponent(T* component);
+
+    /**
+     * Adds component to or removes it from tickers and drawables
+     * @details Only active components are listed
+     */
+    template<typename T>
+    void ListComponent(T* component, bool listed);
+
+    /**
+     * Updates queries after set of components changed
+     * @param previous - Signature before the change
+     */
+    void SignatureChanged(const ComponentSignature& previous);
 };
 
 } // namespace core
@@ -29,6 +29,8 @@
 #include "IComponent.h"
 #include "Entity.h"
 
+#include <algorithm>
+
 
 namespace core {
 
@@ -36,10 +38,9 @@ template<template<typename> typename T, typename S, typename ...Args>
 Entity& Entity::AddComponent(Args... args) {
     static_assert(std::is_base_of<IComponent, T<S>>::value, "Component S must inherit from core::IComponent");
 
-    shared<T<S>> component = std::make_shared<T<S>>(*this, args...);
-    if constexpr(std::is_base_of<ITicker, T<S>>::value)      { components.tickers.emplace_back(static_cast<ITicker*>(&(*component))); };
-    if constexpr(std::is_base_of<IDrawable, T<S>>::value)    { components.drawables.emplace_back(static_cast<IDrawable*>(&(*component))); };
-    components.bases.push_back(std::move(component));
+    assertExistingComponent<T<S>>();
+
+    AttachComponent(ComponentStorage<T<S>>::Get().Create(*this, args...));
 
     return *this;
 };
@@ -47,13 +48,40 @@ template<typename T, typename... Args>
 Entity& Entity::AddComponent(Args... args) {
     static_assert(std::is_base_of<IComponent, T>::value, "Component T must inherit from core::IComponent");
 
-    auto component = std::make_shared<T>(*this, args...);
-    if constexpr(std::is_base_of<ITicker, T>::value)         { components.tickers.emplace_back(static_cast<ITicker*>(&(*component))); };
-    if constexpr(std::is_base_of<IDrawable, T>::value)       { components.drawables.emplace_back(static_cast<IDrawable*>(&(*component))); };
-    components.bases.push_back(std::move(component));
+    assertExistingComponent<T>();
+
+    AttachComponent(ComponentStorage<T>::Get().Create(*this, args...));
 
     return *this;
 }
+template<typename T>
+void Entity::AttachComponent(T* component) {
+    const ComponentTypeId id = ComponentType::Id<T>();
+    const ComponentSignature previous = components.signature;
+
+    if (component->IsActive()) { ListComponent(component, true); }
+    components.bases.insert(components.bases.begin() + components.signature.Rank(id), component);
+    components.signature.Set(id);
+
+    SignatureChanged(previous);
+}
+template<typename T>
+void Entity::ListComponent(T* component, bool listed) {
+    auto list = [&](auto& container, auto* item) {
+        if (listed) {
+            container.push_back(item);
+        } else {
+            container.erase(std::remove(container.begin(), container.end(), item), container.end());
+        }
+    };
+
+    if constexpr(std::is_base_of<ITicker, T>::value) {
+        for (size_t i = 0; i < tickerPhaseCount; ++i) {
+            if (TickerPhases<T>::mask & PhaseBit(static_cast<TickerPhase>(i))) { list(components.tickers[i], static_cast<ITicker*>(component)); }
+        }
+    }
+    if constexpr(std::is_base_of<IDrawable, T>::value) { list(components.drawables, static_cast<IDrawable*>(component)); }
+}
 template<typename T, typename C>
 void Entity::assertRequiredComponent(C* caller) {
     static_assert(std::is_base_of<IComponent, T>::value, "Component T must inherit from core::IComponent");
@@ -74,21 +102,17 @@ void Entity::assertExistingComponent() {
 
 template<typename T>
 T* Entity::GetComponent() {
-    auto it = std::find_if(components.bases.begin(),
-                           components.bases.end(),
-                           [&](std::shared_ptr<IComponent> const& p)
-                           { return typeid(*p).hash_code() == typeid(T).hash_code(); });
-    if ( it != components.bases.end() ) {
-        return dynamic_cast<T*>(it->get());
-    } else {
+    static_assert(std::is_base_of<IComponent, T>::value, "Component T must inherit from core::IComponent");
+
+    const ComponentTypeId id = ComponentType::Id<T>();
+    if ( !components.signature.Test(id) ) {
         return nullptr;
     }
+    return static_cast<T*>(components.bases[components.signature.Rank(id)]);
 }
 template<typename T>
 bool Entity::HasComponent() {
-    return std::any_of(components.bases.begin(), components.bases.end(),
-                       [&](std::shared_ptr<IComponent> &c)
-                       { return typeid(*c).hash_code() == typeid(T).hash_code(); });
+    return components.signature.Test(ComponentType::Id<T>());
 }
 
 } // namespace core
\ No newline at end of file
@@ -55,6 +55,15 @@
 #   endif
 #endif
 
+/** Keeps rarely taken paths out of hot functions they are called from */
+#ifndef CORE_NOINLINE
+#   if defined(_MSC_VER) && !defined(__clang__)
+#       define CORE_NOINLINE __declspec(noinline)
+#   else
+#       define CORE_NOINLINE __attribute__((noinline))
+#   endif
+#endif
+
 /**     Core std includes     */
 #include <optional>
 #include <cstring>
@@ -86,18 +95,27 @@ namespace core {
 class Core;
 class CoreConfig;
 class EngineLoop;
+class EventBus;
+class EventDispatcher;
 class Entity;
 class FileSystem;
+class JobSystem;
 class Layer;
 class Light;
 class Logger;
 class LogEntry;
+class MappedFile;
 class Mesh;
 class Model;
+class NameTable;
 class Object;
+class Prefab;
 class Scene;
 class ScriptedBehaviour;
 class Shader;
+class Subscription;
+class SystemScheduler;
+class TransformSystem;
 class GUIBehaviour;
 class GUIContext;
 
@@ -107,19 +125,29 @@ class EditorModule;
 class ApplicationModule;
 class EngineModule;
 class SceneModule;
+class SceneSnapshot;
+class WorldPartition;
+struct SceneData;
 class InputModule;
 
 // Core Components classes
 class Camera;
+class CommandBuffer;
 class SceneCamera;
 class Renderer;
 class Transform;
 class Light;
+class Bounds;
+class Occluder;
+class OcclusionBuffer;
 template<typename T> class Script;
 
 // Core interface classes
 class IDrawable;
 class IComponent;
+class IComponentStorage;
+class IQuery;
+class ISystem;
 class IModule;
 class ITicker;
 class IModuleContainer;
@@ -129,8 +157,18 @@ template<typename T> class Pool;
 template<typename T> class Singleton;
 template<typename T> class Instantiable;
 template<typename T> class TypeMap;
+template<typename T> class ComponentStorage;
+template<typename ...Ts> class Query;
 template<class T, class D> class ModuleContainer;
 template<typename T> class LayerLinked;
+template<typename T> class Referable;
+template<typename T> struct Handle;
+template<typename T> class SceneHierarchy;
+template<typename T> class BoundingVolumeTree;
+template<typename Signature> class Delegate;
+
+// Core handles
+using EntityHandle = Handle<Entity>;
 
 // Core structs
 typedef struct Rect Rect;
@@ -1,3 +1,6 @@
+/**
+ *  Check Event.tpp for template definitions
+ */
 /*
  MIT License
  
@@ -25,26 +28,272 @@
 #define CORE_EVENT_H
 
 #include "core/Essentials.h"
+#include "core/Delegate.h"
+#include "core/MpscQueue.h"
 
 #include <vector>
 #include <utility>
-#include <functional>
-#include <unordered_set>
+#include <atomic>
+#include <thread>
+#include <tuple>
+#include <optional>
 
 namespace core {
 
+/**
+ * Reference counted state shared by an Event, its Subscription tokens and posted commands
+ * @details Outlives the Event while something still references it, IsAlive() tells if the Event is gone
+ */
+class IEventState : public MpscNode {
+public:
+    void Retain();
+    void Release();
+
+    bool IsAlive() const;
+
+    /**
+     * Remove subscription
+     * @note Thread safe, from other than owner thread removal is posted
+     */
+    virtual void Unsubscribe(uint32_t id) = 0;
+
+protected:
+    friend class EventDispatcher;
+
+    IEventState() = default;
+    virtual ~IEventState() = default;
+
+    /**
+     * Make EventDispatcher drain posted commands of this event
+     * @note Call after every command push
+     */
+    void Schedule();
+
+    /**
+     * Run posted commands
+     * @note Owner thread only
+     */
+    virtual void DispatchPosted() = 0;
+
+    std::atomic<uint32_t> references { 1 };
+    std::atomic<bool>     alive      { true };
+
+    /** Set while the state is queued in EventDispatcher */
+    std::atomic<bool>     scheduled  { false };
+};
+
+/**
+ * Delivers events published from other threads on the event owner thread
+ * @details Owner thread is the one running the main loop. Any thread may Trigger or Subscribe to an Event,
+ * calls made from other threads are posted and carried out at the next DispatchPosted()
+ */
+class EventDispatcher {
+public:
+    static EventDispatcher& Get();
+
+    /**
+     * Make calling thread the owner of every event
+     * @details Until called, every thread is treated as the owner
+     */
+    void BindToThisThread();
+
+    /**
+     * Is calling thread allowed to dispatch events directly?
+     * @details Compares a per thread copy of the binding with the current one, without calling into the dispatcher
+     */
+    static bool IsOwnerThread() {
+        const uint32_t current = binding.load(std::memory_order_acquire);
+        return current == 0 || current == threadBinding;
+    }
+
+    /**
+     * Carry out everything posted to events since last call
+     * @details Things posted by the dispatched callbacks are carried out on the next call
+     * @note Owner thread only
+     */
+    void DispatchPosted();
+
+private:
+    friend class IEventState;
+
+    EventDispatcher() = default;
+
+    void Schedule(IEventState* state);
+
+    MpscQueue<IEventState> ready;
+
+    /** Reused between calls to DispatchPosted() */
+    vector<IEventState*> batch;
+
+    /** Incremented by every BindToThisThread(), 0 while unbound */
+    static inline std::atomic<uint32_t> binding { 0 };
+
+    /** Value of binding when calling thread became the owner */
+    static inline thread_local uint32_t threadBinding { 0 };
+};
+
+/**
+ * RAII token of a single Event subscription
+ * @details Unsubscribes the callback when destroyed or reset. Safe to outlive the event it came from
+ */
+class Subscription {
+public:
+    Subscription() = default;
+
+    /** Takes over a reference of state */
+    Subscription(IEventState* state, uint32_t id);
+
+    Subscription(Subscription&& other) noexcept;
+    Subscription& operator=(Subscription&& other) noexcept;
+
+    /** Copying is not allowed */
+    Subscription(const Subscription&) = delete;
+
+    /** Copying is not allowed */
+    Subscription& operator=(const Subscription&) = delete;
+
+    ~Subscription();
+
+    /**
+     * Unsubscribe now
+     */
+    void Reset();
+
+    /**
+     * Is callback still subscribed to an alive event?
+     */
+    bool IsConnected() const;
+
+private:
+
+    IEventState* state { nullptr };
+    uint32_t     id    { 0 };
+};
+
 template<typename T, typename ...Args>
 class Event {
 public:
-    using callbackList = std::vector<std::function<void(T&, Args...)>>;
+    using Callback = Delegate<void(T&, Args...)>;
+
+    Event() = default;
+    Event(Event&& other) noexcept;
+    Event& operator=(Event&& other) noexcept;
 
-    void Subscribe(std::function<void(T&, Args...)> callback);
+    /** Copying is not allowed */
+    Event(const Event&) = delete;
+
+    /** Copying is not allowed */
+    Event& operator=(const Event&) = delete;
+
+    ~Event();
+
+    /**
+     * Subscribe callback for the whole lifetime of the event
+     * @note Thread safe, callback is always called on the owner thread
+     */
+    void Subscribe(Callback callback);
+
+    /**
+     * Subscribe callback until returned Subscription is destroyed
+     * @details Use it whenever subscriber may be destroyed before the event
+     * @note Thread safe, callback is always called on the owner thread
+     */
+    [[nodiscard]] Subscription SubscribeScoped(Callback callback);
+
+    /**
+     * Call every subscribed callback
+     * @details Callbacks may subscribe and unsubscribe during the call, subscriptions made
+     * while triggering receive the next trigger. Order of the callbacks is not preserved.
+     * Called from other than owner thread, works as Post()
+     * @throw std::logic_error if called from other than owner thread and arguments can't be copied
+     * @note Callbacks must not destroy the event they are called from
+     */
     void Trigger(T& obj, Args... args);
     void Trigger(T&& obj, Args... args);
 
+    /**
+     * Copy arguments and call subscribed callbacks at the next EventDispatcher::DispatchPosted()
+     * @note Thread safe, event must outlive the call
+     */
+    void Post(const T& obj, Args... args);
+
 protected:
 
-    callbackList callbacks;
+    using Payload = std::tuple<std::decay_t<T>, std::decay_t<Args>...>;
+
+    struct Slot {
+        uint32_t id;
+        Callback callback;
+    };
+
+    /** Trigger, subscription or removal posted from other than owner thread */
+    struct Command : MpscNode {
+        enum class Kind : uint8_t { Trigger, Subscribe, Unsubscribe };
+
+        Kind              kind;
+        uint32_t          id { 0 };
+        Callback          callback;
+        optional<Payload> payload;
+    };
+
+    class State : public IEventState {
+    public:
+        ~State() override;
+
+        uint32_t Add(Callback callback);
+        void Unsubscribe(uint32_t id) override;
+        void Dispatch(T& obj, Args... args);
+        void Post(Payload&& payload);
+
+        /** Drops every callback, called by the destroyed Event */
+        void Kill();
+
+    protected:
+        void DispatchPosted() override;
+
+    private:
+
+        void Push(Command* command);
+        void AddSlot(uint32_t id, Callback callback);
+        void RemoveSlot(uint32_t id);
+
+        /** Swap-removes slots unsubscribed during dispatch and appends ones subscribed during it */
+        void Flush();
+
+        /** Slots below are touched on the owner thread only */
+        vector<Slot> slots;
+
+        /** Slots subscribed while dispatching, vector above must not reallocate under running callbacks */
+        vector<Slot> pending;
+
+        /** Commands taken out of the queue, reused between DispatchPosted() calls */
+        vector<Command*> posted;
+
+        MpscQueue<Command> commands;
+
+        /** Ids of slots subscribed on the owner thread are even, the rest are odd, 0 marks a removed slot */
+        uint32_t              nextOwnerId { 2 };
+        std::atomic<uint32_t> nextPostedId { 1 };
+
+        uint32_t dispatchDepth  { 0 };
+        bool     hasRemoved     { false };
+    };
+
+    /**
+     * Trigger from other than owner thread
+     * @details Kept out of line, so Trigger() on the owner thread inlines down to the dispatch loop
+     * @throw std::logic_error if arguments can't be copied
+     */
+    CORE_NOINLINE void PostFromOtherThread(T& obj, Args... args);
+
+    /**
+     * Get state, creating it if needed
+     * @note Thread safe
+     */
+    State* AcquireState();
+
+    /** Created on first subscribe, most events never have any subscribers */
+    std::atomic<State*> state { nullptr };
     uint32_t id { ++eventCounter };
 
 private:
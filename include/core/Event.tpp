@@ -22,6 +22,10 @@
  SOFTWARE.
  */
 #include "Event.h"
+#include "core/Logger.h"
+
+#include <stdexcept>
+#include <typeinfo>
 
 namespace core {
 
@@ -29,20 +33,233 @@ template<typename T, typename... Args>
 std::atomic<uint32_t> Event<T, Args...>::eventCounter { 0 };
 
 template<typename T, typename... Args>
-void Event<T, Args...>::Subscribe(std::function<void(T&, Args...)> callback) {
-    callbacks.emplace_back(callback);
+Event<T, Args...>::Event(Event&& other) noexcept
+    : state(other.state.exchange(nullptr, std::memory_order_acq_rel))
+    , id(other.id) { }
+
+template<typename T, typename... Args>
+Event<T, Args...>& Event<T, Args...>::operator=(Event&& other) noexcept {
+    if (this != &other) {
+        State* old = state.exchange(other.state.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_acq_rel);
+        if (old) {
+            old->Kill();
+            old->Release();
+        }
+        id = other.id;
+    }
+    return *this;
+}
+template<typename T, typename... Args>
+Event<T, Args...>::~Event() {
+    if (State* current = state.load(std::memory_order_acquire)) {
+        current->Kill();
+        current->Release();
+    }
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::Subscribe(Callback callback) {
+    AcquireState()->Add(std::move(callback));
+}
+template<typename T, typename... Args>
+Subscription Event<T, Args...>::SubscribeScoped(Callback callback) {
+    State* current = AcquireState();
+    const uint32_t slotId = current->Add(std::move(callback));
+    current->Retain();
+    return Subscription(current, slotId);
 }
 template<typename T, typename... Args>
 void Event<T, Args...>::Trigger(T& obj, Args... args) {
-    for (const auto& callback : callbacks) {
-        callback(obj, args...);
+    State* current = state.load(std::memory_order_acquire);
+    if (!current) { return; }
+
+    if (EventDispatcher::IsOwnerThread()) {
+        current->Dispatch(obj, args...);
+    } else {
+        PostFromOtherThread(obj, args...);
     }
 }
 template<typename T, typename... Args>
 void Event<T, Args...>::Trigger(T&& obj, Args... args) {
-    for (const auto& callback : callbacks) {
-        callback(obj, args...);
+    State* current = state.load(std::memory_order_acquire);
+    if (!current) { return; }
+
+    if (EventDispatcher::IsOwnerThread()) {
+        current->Dispatch(obj, args...);
+    } else {
+        PostFromOtherThread(obj, args...);
+    }
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::Post(const T& obj, Args... args) {
+    /* Nobody to deliver to, subscriptions posted later must not receive it anyway */
+    if (State* current = state.load(std::memory_order_acquire)) {
+        current->Post(Payload(obj, args...));
+    }
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::PostFromOtherThread(T& obj, Args... args) {
+    if constexpr (std::is_constructible<Payload, T&, Args&...>::value) {
+        state.load(std::memory_order_acquire)->Post(Payload(obj, args...));
+    } else {
+        /* Input events only reference SDL data that is gone once the trigger returns */
+        Logger::Log(INTERNAL, ERR_HERE) << "Event of " << typeid(T).name() << " can't be copied to be triggered from other thread";
+        throw std::logic_error(string("Event of ") + typeid(T).name() + " can't be triggered from other thread");
+    }
+}
+template<typename T, typename... Args>
+typename Event<T, Args...>::State* Event<T, Args...>::AcquireState() {
+    State* current = state.load(std::memory_order_acquire);
+    if (current) { return current; }
+
+    State* created = new State();
+    if (state.compare_exchange_strong(current, created, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return created;
+    }
+    /* Other thread was first */
+    created->Release();
+    return current;
+}
+template<typename T, typename... Args>
+Event<T, Args...>::State::~State() {
+    while (Command* command = commands.Pop()) {
+        delete command;
+    }
+}
+template<typename T, typename... Args>
+uint32_t Event<T, Args...>::State::Add(Callback callback) {
+    if (EventDispatcher::IsOwnerThread()) {
+        const uint32_t slotId = nextOwnerId;
+        nextOwnerId += 2;
+        AddSlot(slotId, std::move(callback));
+        return slotId;
+    }
+
+    /* Posted subscription, other threads may be subscribing at the same time */
+    Command* command  = new Command();
+    command->kind     = Command::Kind::Subscribe;
+    command->id       = nextPostedId.fetch_add(2, std::memory_order_relaxed);
+    command->callback = std::move(callback);
+    const uint32_t slotId = command->id;
+    Push(command);
+    return slotId;
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::State::Unsubscribe(uint32_t slotId) {
+    if (EventDispatcher::IsOwnerThread()) {
+        RemoveSlot(slotId);
+    } else {
+        Command* command = new Command();
+        command->kind    = Command::Kind::Unsubscribe;
+        command->id      = slotId;
+        Push(command);
+    }
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::State::Post(Payload&& payload) {
+    Command* command = new Command();
+    command->kind    = Command::Kind::Trigger;
+    command->payload.emplace(std::move(payload));
+    Push(command);
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::State::Push(Command* command) {
+    commands.Push(command);
+    Schedule();
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::State::Kill() {
+    alive.store(false, std::memory_order_release);
+    slots.clear();
+    pending.clear();
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::State::DispatchPosted() {
+    /* Take everything out first, so callbacks posting to this event don't keep the loop going */
+    posted.clear();
+    while (Command* command = commands.Pop()) {
+        posted.push_back(command);
+    }
+    for (Command* command : posted) {
+        if (IsAlive()) {
+            switch (command->kind) {
+                case Command::Kind::Trigger:
+                    std::apply([this](auto& obj, auto&... args) { Dispatch(obj, args...); }, *command->payload);
+                    break;
+                case Command::Kind::Subscribe:
+                    AddSlot(command->id, std::move(command->callback));
+                    break;
+                case Command::Kind::Unsubscribe:
+                    RemoveSlot(command->id);
+                    break;
+            }
+        }
+        delete command;
+    }
+    posted.clear();
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::State::AddSlot(uint32_t slotId, Callback callback) {
+    if (dispatchDepth > 0) {
+        pending.push_back({ slotId, std::move(callback) });
+    } else {
+        slots.push_back({ slotId, std::move(callback) });
+    }
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::State::RemoveSlot(uint32_t slotId) {
+    for (size_t i = 0; i < slots.size(); ++i) {
+        if (slots[i].id != slotId) { continue; }
+
+        if (dispatchDepth > 0) {
+            /* Callback may be running right now, only mark it and remove after dispatch */
+            slots[i].id = 0;
+            hasRemoved = true;
+        } else {
+            if (i != slots.size() - 1) { slots[i] = std::move(slots.back()); }
+            slots.pop_back();
+        }
+        return;
+    }
+    for (size_t i = 0; i < pending.size(); ++i) {
+        if (pending[i].id != slotId) { continue; }
+
+        if (i != pending.size() - 1) { pending[i] = std::move(pending.back()); }
+        pending.pop_back();
+        return;
+    }
+}
+template<typename T, typename... Args>
+inline void Event<T, Args...>::State::Dispatch(T& obj, Args... args) {
+    struct DepthGuard {
+        State& owner;
+        explicit DepthGuard(State& owner) : owner(owner) { ++owner.dispatchDepth; }
+        ~DepthGuard() {
+            if (--owner.dispatchDepth == 0 && (owner.hasRemoved || !owner.pending.empty())) { owner.Flush(); }
+        }
+    } guard(*this);
+
+    /* Slots don't reallocate while dispatching, callbacks subscribed meanwhile go to pending */
+    const Slot* slot = slots.data();
+    const Slot* end  = slot + slots.size();
+    for (; slot != end; ++slot) {
+        if (slot->id != 0) { slot->callback(obj, args...); }
+    }
+}
+template<typename T, typename... Args>
+void Event<T, Args...>::State::Flush() {
+    if (hasRemoved) {
+        for (size_t i = 0; i < slots.size();) {
+            if (slots[i].id != 0) { ++i; continue; }
+
+            if (i != slots.size() - 1) { slots[i] = std::move(slots.back()); }
+            slots.pop_back();
+        }
+        hasRemoved = false;
+    }
+    for (Slot& slot : pending) {
+        slots.push_back(std::move(slot));
     }
+    pending.clear();
 }
 
 }
@@ -0,0 +1,188 @@
+/**
+ *  Check EventBus.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_EVENTBUS_H
+#define CORE_EVENTBUS_H
+
+#include "core/Essentials.h"
+#include "core/Event.h"
+#include "core/TickerPhases.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace core {
+
+/**
+ * Contiguous run of queued events handed to EventBus subscribers
+ */
+template<typename T>
+struct EventBatch {
+    const T* events { nullptr };
+    size_t   count  { 0 };
+
+    const T* begin() const { return events; }
+    const T* end()   const { return events + count; }
+    size_t   size()  const { return count; }
+
+    const T& operator[](size_t index) const { return events[index]; }
+};
+
+/**
+ * Type-erased EventChannel, lets EventBus drain channels of every type
+ */
+class IEventChannel {
+public:
+    virtual ~IEventChannel() = default;
+
+    /**
+     * Hand events queued since last drain of the phase to its subscribers
+     */
+    virtual void Drain(TickerPhase phase) = 0;
+};
+
+/**
+ * Ring buffer of queued events of type T
+ * @details Each drain phase keeps its own read cursor, events are dropped once every subscribed phase has read them.
+ * Events published while a phase is draining are handed out at its next drain
+ */
+template<typename T>
+class EventChannel : public IEventChannel {
+public:
+    using BatchCallback = typename Event<const EventBatch<T>>::Callback;
+
+    static EventChannel<T>& Get();
+
+    void Publish(const T& event);
+
+    void Subscribe(TickerPhase phase, BatchCallback callback);
+    [[nodiscard]] Subscription SubscribeScoped(TickerPhase phase, BatchCallback callback);
+
+    void Drain(TickerPhase phase) override;
+
+    /**
+     * @return Number of events not yet read by every subscribed phase
+     */
+    size_t Size() const;
+
+private:
+
+    struct alignas(T) Cell {
+        unsigned char bytes[sizeof(T)];
+    };
+
+    EventChannel();
+
+    void Grow();
+    void Subscribed(TickerPhase phase);
+
+    /** Moves tail past events every subscribed phase has read */
+    void UpdateTail();
+
+    /** Slot of absolute event index */
+    const T* At(uint64_t index) const;
+
+    unique<Cell[]> cells;
+
+    /** Power of two */
+    size_t capacity { 0 };
+
+    /** Absolute indices of the oldest kept and the next published event */
+    uint64_t tail  { 0 };
+    uint64_t write { 0 };
+
+    uint64_t cursors[tickerPhaseCount] { };
+
+    /** Batch handlers of each phase */
+    Event<const EventBatch<T>> onBatch[tickerPhaseCount];
+
+    TickerPhaseMask subscribedPhases { 0 };
+
+    /** Buffers replaced while draining, batches being handled may still point into them */
+    vector<unique<Cell[]>> retired;
+    uint32_t drainDepth { 0 };
+};
+
+/**
+ * Deferred alternative to Event: events are queued when published and handed out in batches at a chosen tick phase
+ * @details A burst of events costs one call per subscriber instead of one cascade per event, and a batch
+ * is a plain array that can be processed in parallel. Use Event when subscribers must react immediately.
+ * Events are drained before EarlyTick, Tick and LateTick modules of the main loop
+ * @note Owner thread only, see EventDispatcher. Other threads can post through an Event
+ */
+class EventBus {
+public:
+
+    /**
+     * Queue event until the next drain of every subscribed phase
+     * @details Events nobody subscribed to are dropped right away
+     * @tparam T - Trivially copyable event type
+     */
+    template<typename T>
+    static void Publish(const T& event);
+
+    /**
+     * Subscribe batch callback for the whole run
+     * @throw std::logic_error if phase is not one of the drain phases
+     */
+    template<typename T>
+    static void Subscribe(TickerPhase phase, typename EventChannel<T>::BatchCallback callback);
+
+    /**
+     * Subscribe batch callback until returned Subscription is destroyed
+     * @throw std::logic_error if phase is not one of the drain phases
+     */
+    template<typename T>
+    [[nodiscard]] static Subscription SubscribeScoped(TickerPhase phase, typename EventChannel<T>::BatchCallback callback);
+
+    /**
+     * Hand out every channel's events queued for the phase
+     */
+    static void Drain(TickerPhase phase);
+
+    /**
+     * Is phase drained by the main loop?
+     */
+    static bool IsDrainPhase(TickerPhase phase);
+
+private:
+    template<typename T> friend class EventChannel;
+
+    static void Register(IEventChannel* channel);
+
+    /** Throws if phase is not a drain phase or called from other than owner thread */
+    static void ValidateSubscribe(TickerPhase phase);
+    static void ValidatePublish();
+
+    /** Intentionally never destroyed, channels are never destroyed either */
+    static vector<IEventChannel*>& Channels();
+};
+
+} // namespace core
+
+#include "EventBus.tpp"
+
+#endif //CORE_EVENTBUS_H
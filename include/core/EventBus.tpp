@@ -0,0 +1,147 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "EventBus.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+namespace core {
+
+template<typename T>
+EventChannel<T>& EventChannel<T>::Get() {
+    static_assert(std::is_trivially_copyable<T>::value, "EventBus event T must be trivially copyable");
+
+    // Intentionally never destroyed, as EventBus channel list
+    static EventChannel<T>* channel = new EventChannel<T>();
+    return *channel;
+}
+template<typename T>
+EventChannel<T>::EventChannel() {
+    EventBus::Register(this);
+}
+template<typename T>
+void EventChannel<T>::Publish(const T& event) {
+    if (!subscribedPhases) { return; }
+
+    if (write - tail == capacity) { Grow(); }
+
+    ::new (static_cast<void*>(cells[write & (capacity - 1)].bytes)) T(event);
+    ++write;
+}
+template<typename T>
+void EventChannel<T>::Subscribe(TickerPhase phase, BatchCallback callback) {
+    Subscribed(phase);
+    onBatch[static_cast<size_t>(phase)].Subscribe(std::move(callback));
+}
+template<typename T>
+Subscription EventChannel<T>::SubscribeScoped(TickerPhase phase, BatchCallback callback) {
+    Subscribed(phase);
+    return onBatch[static_cast<size_t>(phase)].SubscribeScoped(std::move(callback));
+}
+template<typename T>
+void EventChannel<T>::Subscribed(TickerPhase phase) {
+    if (subscribedPhases & PhaseBit(phase)) { return; }
+
+    /* Phase starts reading from now on, it must not hold back events published before */
+    subscribedPhases |= PhaseBit(phase);
+    cursors[static_cast<size_t>(phase)] = write;
+}
+template<typename T>
+void EventChannel<T>::Drain(TickerPhase phase) {
+    if (!(subscribedPhases & PhaseBit(phase))) { return; }
+
+    struct DrainGuard {
+        EventChannel& owner;
+        explicit DrainGuard(EventChannel& owner) : owner(owner) { ++owner.drainDepth; }
+        ~DrainGuard() {
+            if (--owner.drainDepth == 0) { owner.retired.clear(); }
+            owner.UpdateTail();
+        }
+    } guard(*this);
+
+    uint64_t& cursor = cursors[static_cast<size_t>(phase)];
+    const uint64_t end = write;
+
+    /* Ring may wrap, then the phase gets two batches */
+    while (cursor != end) {
+        const size_t start = static_cast<size_t>(cursor & (capacity - 1));
+        const size_t count = static_cast<size_t>(std::min<uint64_t>(end - cursor, capacity - start));
+
+        const EventBatch<T> batch { At(cursor), count };
+        cursor += count;
+        onBatch[static_cast<size_t>(phase)].Trigger(batch);
+    }
+}
+template<typename T>
+size_t EventChannel<T>::Size() const {
+    return static_cast<size_t>(write - tail);
+}
+template<typename T>
+void EventChannel<T>::Grow() {
+    const size_t grownCapacity = capacity ? capacity * 2 : 64;
+    unique<Cell[]> grown(new Cell[grownCapacity]);
+
+    /* Absolute indices stay, only their slots change */
+    for (uint64_t i = tail; i != write; ++i) {
+        std::memcpy(grown[i & (grownCapacity - 1)].bytes, cells[i & (capacity - 1)].bytes, sizeof(T));
+    }
+    if (drainDepth > 0) {
+        retired.push_back(std::move(cells));
+    }
+    cells    = std::move(grown);
+    capacity = grownCapacity;
+}
+template<typename T>
+void EventChannel<T>::UpdateTail() {
+    uint64_t oldest = write;
+    for (size_t i = 0; i < tickerPhaseCount; ++i) {
+        if (subscribedPhases & PhaseBit(static_cast<TickerPhase>(i))) { oldest = std::min(oldest, cursors[i]); }
+    }
+    /* Trivially copyable, nothing to destroy */
+    tail = oldest;
+}
+template<typename T>
+const T* EventChannel<T>::At(uint64_t index) const {
+    return std::launder(reinterpret_cast<const T*>(cells[index & (capacity - 1)].bytes));
+}
+
+template<typename T>
+void EventBus::Publish(const T& event) {
+    ValidatePublish();
+    EventChannel<T>::Get().Publish(event);
+}
+template<typename T>
+void EventBus::Subscribe(TickerPhase phase, typename EventChannel<T>::BatchCallback callback) {
+    ValidateSubscribe(phase);
+    EventChannel<T>::Get().Subscribe(phase, std::move(callback));
+}
+template<typename T>
+Subscription EventBus::SubscribeScoped(TickerPhase phase, typename EventChannel<T>::BatchCallback callback) {
+    ValidateSubscribe(phase);
+    return EventChannel<T>::Get().SubscribeScoped(phase, std::move(callback));
+}
+
+}
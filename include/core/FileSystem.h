@@ -29,6 +29,46 @@
 
 namespace core {
 
+/**
+ * Read-only view of a whole file mapped into memory
+ * @details Pages are loaded by the OS on first access, nothing is copied up front
+ */
+class MappedFile {
+public:
+    /**
+     * Maps file into memory
+     * @throw std::runtime_error if file cannot be opened or mapped
+     */
+    explicit MappedFile(const string& path);
+    ~MappedFile();
+
+    /** Copying is not allowed */
+    MappedFile(const MappedFile&) = delete;
+
+    /** Copying is not allowed */
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @return Pointer to the first byte of the file, page-aligned
+     */
+    const unsigned char* GetData() const;
+
+    /**
+     * @return Size of the file in bytes
+     */
+    size_t GetSize() const;
+
+private:
+
+    const unsigned char* data { nullptr };
+    size_t               size { 0 };
+
+#ifdef _WIN32
+    void* file    { nullptr };
+    void* mapping { nullptr };
+#endif
+};
+
 class FileSystem {
 public:
 
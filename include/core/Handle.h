@@ -0,0 +1,142 @@
+/**
+ *  Check Handle.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_HANDLE_H
+#define CORE_HANDLE_H
+
+#include "Essentials.h"
+
+#include <limits>
+
+namespace core {
+
+/**
+ * Generational reference to an object of Referable type T
+ * @details Handle stays cheap to copy and never dangles: once referenced object is destroyed,
+ * its slot generation changes and every old handle resolves to nullptr
+ */
+template<typename T>
+struct Handle {
+    static constexpr uint32_t invalidIndex = std::numeric_limits<uint32_t>::max();
+
+    /** Slot of the referenced object */
+    uint32_t index      { invalidIndex };
+
+    /** Generation of the slot at the moment handle was created */
+    uint32_t generation { 0 };
+
+    /**
+     * Resolve handle to the object
+     * @return T* if object is alive, nullptr otherwise
+     */
+    T* Get() const;
+
+    /**
+     * Resolve handle to the component of the referenced object
+     * @tparam C - Component typename
+     * @return C* if object is alive and has component C, nullptr otherwise
+     */
+    template<typename C>
+    C* GetComponent() const;
+
+    /**
+     * Is referenced object alive?
+     */
+    bool IsValid() const;
+
+    /**
+     * Access referenced object
+     * @note Handle is expected to be valid
+     */
+    T* operator->() const;
+
+    explicit operator bool() const { return IsValid(); }
+
+    bool operator==(const Handle& rhs) const { return index == rhs.index && generation == rhs.generation; }
+    bool operator!=(const Handle& rhs) const { return !(*this == rhs); }
+};
+
+/**
+ * Helper superclass, registers objects in a slot map and gives them Handle
+ * @details Validating and resolving a handle is O(1), slots are recycled with increased generation
+ */
+template<typename T>
+class Referable {
+public:
+    Referable();
+    ~Referable();
+
+    /** Copying is not allowed */
+    Referable(const Referable&) = delete;
+
+    /** Copying is not allowed */
+    Referable& operator=(const Referable&) = delete;
+
+    /**
+     * @return Handle to this object
+     */
+    Handle<T> GetHandle() const;
+
+    /**
+     * @return T* if handle references alive object, nullptr otherwise
+     */
+    static T* Resolve(Handle<T> handle);
+
+    /**
+     * @return Number of alive objects of type T
+     */
+    static size_t Count();
+
+    /**
+     * Makes sure count more objects can be registered without allocating
+     */
+    static void Reserve(size_t count);
+
+private:
+
+    struct Slot {
+        T*       object     { nullptr };
+        uint32_t generation { 0 };
+        uint32_t nextFree   { Handle<T>::invalidIndex };
+    };
+
+    /**
+     * Slot array
+     * @note Intentionally never destroyed: objects owned by static containers unregister after function-local statics are gone
+     */
+    static vector<Slot>& Slots();
+
+    static uint32_t     freeHead;
+    static size_t       aliveCount;
+
+    Handle<T> handle;
+};
+
+} // namespace core
+
+#include "Handle.tpp"
+
+#endif //CORE_HANDLE_H
@@ -0,0 +1,108 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "Handle.h"
+
+namespace core {
+
+template<typename T>
+uint32_t Referable<T>::freeHead { Handle<T>::invalidIndex };
+
+template<typename T>
+size_t Referable<T>::aliveCount { 0 };
+
+template<typename T>
+T* Handle<T>::Get() const {
+    return Referable<T>::Resolve(*this);
+}
+template<typename T>
+template<typename C>
+C* Handle<T>::GetComponent() const {
+    T* object = Get();
+    return object ? object->template GetComponent<C>() : nullptr;
+}
+template<typename T>
+bool Handle<T>::IsValid() const {
+    return Get() != nullptr;
+}
+template<typename T>
+T* Handle<T>::operator->() const {
+    T* object = Get();
+    assert(object && "Dereferencing invalid handle");
+    return object;
+}
+
+template<typename T>
+vector<typename Referable<T>::Slot>& Referable<T>::Slots() {
+    static auto* slots = new vector<Slot>();
+    return *slots;
+}
+template<typename T>
+Referable<T>::Referable() {
+    vector<Slot>& slots = Slots();
+
+    if (freeHead != Handle<T>::invalidIndex) {
+        handle.index = freeHead;
+        freeHead = slots[freeHead].nextFree;
+    } else {
+        handle.index = static_cast<uint32_t>(slots.size());
+        slots.emplace_back();
+    }
+
+    Slot& slot = slots[handle.index];
+    slot.object = static_cast<T*>(this);
+    slot.nextFree = Handle<T>::invalidIndex;
+    handle.generation = slot.generation;
+    ++aliveCount;
+}
+template<typename T>
+Referable<T>::~Referable() {
+    Slot& slot = Slots()[handle.index];
+    slot.object = nullptr;
+    slot.generation++;
+    slot.nextFree = freeHead;
+    freeHead = handle.index;
+    --aliveCount;
+}
+template<typename T>
+Handle<T> Referable<T>::GetHandle() const {
+    return handle;
+}
+template<typename T>
+T* Referable<T>::Resolve(Handle<T> h) {
+    const vector<Slot>& slots = Slots();
+    if (h.index >= slots.size()) { return nullptr; }
+
+    const Slot& slot = slots[h.index];
+    return slot.generation == h.generation ? slot.object : nullptr;
+}
+template<typename T>
+size_t Referable<T>::Count() {
+    return aliveCount;
+}
+template<typename T>
+void Referable<T>::Reserve(size_t count) {
+    Slots().reserve(aliveCount + count);
+}
+
+} // namespace core
@@ -38,15 +38,79 @@ namespace core {
 class IComponent : public Object, public ITicker {
 public:
 
-    bool isActive = true;
+    /**
+     * Activates or deactivates component
+     * @details Inactive components are not ticked nor drawn, toggling is O(1)
+     */
+    void SetActive(bool active);
+
+    /**
+     * Is component ticked and drawn?
+     */
+    bool IsActive() const;
+
+    /**
+     * Records that component data was written
+     * @details Consumers compare versions to skip work on unchanged components, see Changed<T> query filter
+     */
+    void MarkChanged();
+
+    /**
+     * Get write version of component
+     * @note Changes on every MarkChanged() call, compare for equality only
+     */
+    uint32_t GetVersion() const;
+
+    /**
+     * Get change tick of the last MarkChanged() call
+     * @details Ticks grow monotonically and are shared by all components, so one tick
+     * remembered by a consumer tells which components were written since its last visit
+     */
+    uint64_t GetChangeTick() const;
+
+    /**
+     * Get tick stamped on components written from now on
+     */
+    static uint64_t CurrentChangeTick();
 
     /* Entity object this component is attached to */
     Entity*  entity { nullptr };
 
 protected:
+    friend class Entity;
+    template<typename T> friend class ComponentStorage;
+    template<typename ...Ts> friend class Query;
+
     explicit IComponent(Entity& parent, const string& name = "Unnamed");
     virtual ~IComponent();
 
+    /**
+     * Called after component was activated or deactivated
+     */
+    virtual void OnActiveChanged(bool active) { };
+
+    /**
+     * Starts a new change tick
+     * @return Last tick before the call, writes made later get a greater one
+     */
+    static uint64_t AdvanceChangeTick();
+
+private:
+
+    bool active { true };
+
+    /* Incremented on every write */
+    uint32_t version { 0 };
+
+    /* Change tick of the last write */
+    uint64_t changeTick { 0 };
+
+    /* Storage owning this component */
+    IComponentStorage* storage { nullptr };
+
+    /* Position of this component in its storage */
+    uint32_t storageIndex { 0 };
+
 };
 
 } // namespace core
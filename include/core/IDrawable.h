@@ -38,6 +38,12 @@ public:
     virtual void SetTransformMatrix(Matrix4& mtx) = 0;
     virtual void SetLight(Light& light) = 0;
 
+    /**
+     * Get bounding sphere in world space, center in xyz and radius in w
+     * @return false if drawable has no bounds and is never culled
+     */
+    virtual bool GetBoundingSphere(Vector4& sphere) { return false; }
+
 };
 
 }
@@ -32,8 +32,10 @@
 #include "Instantiable.h"
 #include "ObjectTag.h"
 #include "ITicker.h"
+#include "TickerPhases.h"
 #include "Logger.h"
 
+#include <algorithm>
 #include <utility>
 
 namespace core {
@@ -44,16 +46,42 @@ public:
 
     ObjectTag tag {GENERAL };
 
+    /**
+     * Get modules which do work in phase, in order of creation
+     * @note Modules created outside of CoreConfig are listed in every phase
+     */
+    static const vector<IModule*>& ForPhase(TickerPhase phase) {
+        return phaseInstances[static_cast<size_t>(phase)];
+    }
+
 protected:
+    friend class CoreConfig;
+
     explicit IModule(const string& moduleName = "Unnamed", ObjectTag moduleTag = GENERAL)
     : Object(moduleName + " module"), tag(moduleTag)
     {
-        Logger::Log(tag, INFO) << "Initialized " << name;
+        for (auto& modules : phaseInstances) { modules.push_back(this); }
+        Logger::Log(tag, INFO) << "Initialized " << GetName();
     };
     ~IModule() {
-        Logger::Log(tag, INFO) << "Destroyed " << name;
+        for (auto& modules : phaseInstances) { modules.erase(std::remove(modules.begin(), modules.end(), this), modules.end()); }
+        Logger::Log(tag, INFO) << "Destroyed " << GetName();
     }
 
+    /**
+     * Removes module from lists of phases not in mask
+     */
+    void SetPhases(TickerPhaseMask mask) {
+        for (size_t i = 0; i < tickerPhaseCount; ++i) {
+            if (mask & PhaseBit(static_cast<TickerPhase>(i))) { continue; }
+
+            auto& modules = phaseInstances[i];
+            modules.erase(std::remove(modules.begin(), modules.end(), this), modules.end());
+        }
+    }
+
+    static inline vector<IModule*> phaseInstances[tickerPhaseCount] { };
+
 };
 
 
@@ -0,0 +1,91 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_ISYSTEM_H
+#define CORE_ISYSTEM_H
+
+#include "Essentials.h"
+#include "ComponentType.h"
+#include "ITicker.h"
+#include "Object.h"
+
+namespace core {
+
+/**
+ * Base class for systems, run by SystemScheduler
+ * @details System declares component types it reads and writes in its constructor,
+ * systems which do not conflict on these types run concurrently
+ * @note System must not touch components it did not declare
+ */
+class ISystem : public Object, public ITicker {
+public:
+    virtual ~ISystem() = default;
+
+    /**
+     * @return Component types this system reads
+     */
+    const ComponentSignature& GetReads() const { return reads; }
+
+    /**
+     * @return Component types this system writes
+     */
+    const ComponentSignature& GetWrites() const { return writes; }
+
+    /**
+     * Can this system and other one not run at the same time?
+     * @details Systems conflict if either of them writes a type the other one reads or writes
+     */
+    bool ConflictsWith(const ISystem& other) const {
+        return writes.Intersects(other.reads) || writes.Intersects(other.writes) || other.writes.Intersects(reads);
+    }
+
+protected:
+    explicit ISystem(const string& systemName = "Unnamed")
+    : Object(systemName + " system") { };
+
+    /**
+     * Declare read access to components Ts
+     */
+    template<typename ...Ts>
+    void Reads() {
+        (reads.Set(ComponentType::Id<Ts>()), ...);
+    }
+
+    /**
+     * Declare write access to components Ts
+     */
+    template<typename ...Ts>
+    void Writes() {
+        (writes.Set(ComponentType::Id<Ts>()), ...);
+    }
+
+private:
+
+    ComponentSignature reads  { };
+    ComponentSignature writes { };
+
+};
+
+} // namespace core
+
+#endif //CORE_ISYSTEM_H
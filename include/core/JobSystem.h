@@ -0,0 +1,168 @@
+/**
+ *  Check JobSystem.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_JOBSYSTEM_H
+#define CORE_JOBSYSTEM_H
+
+#include "Essentials.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace core {
+
+/**
+ * Counts unfinished jobs
+ * @details Incremented when a job is scheduled with it, decremented when the job is finished,
+ * wait on it with JobSystem::Wait()
+ */
+class JobCounter {
+public:
+    JobCounter() = default;
+
+    /** Copying is not allowed */
+    JobCounter(const JobCounter&) = delete;
+
+    /** Copying is not allowed */
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    /**
+     * Are all jobs of this counter finished?
+     */
+    bool IsDone() const { return count.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<uint32_t> count { 0 };
+};
+
+/**
+ * Runs jobs on a pool of worker threads
+ * @details Every thread has its own queue: it takes newest jobs from its back,
+ * idle threads steal oldest jobs from the front of other queues.
+ * Threads that are not workers share queue of the thread that created the JobSystem
+ * @note Jobs must not throw
+ */
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    /**
+     * @param workerCount - Number of threads created in addition to the calling one
+     */
+    explicit JobSystem(uint32_t workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    /** Copying is not allowed */
+    JobSystem(const JobSystem&) = delete;
+
+    /** Copying is not allowed */
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    /**
+     * Queues job for execution
+     * @param counter - Counter to increment now and decrement once job is finished, can be nullptr
+     */
+    void Schedule(Job job, JobCounter* counter = nullptr);
+
+    /**
+     * Runs queued jobs on calling thread until all jobs of counter are finished
+     */
+    void Wait(const JobCounter& counter);
+
+    /**
+     * Calls function(i) for every i in [begin, end), splitting range into jobs,
+     * returns once every call is done
+     * @param grainSize - Number of indices per job, 0 picks one from the worker count
+     */
+    template<typename F>
+    void ParallelFor(size_t begin, size_t end, F&& function, size_t grainSize = 0);
+
+    /**
+     * @return Number of threads running jobs, including the one that created the JobSystem
+     */
+    uint32_t ThreadCount() const;
+
+    /**
+     * @return Number of hardware threads minus the calling one
+     */
+    static uint32_t DefaultWorkerCount();
+
+protected:
+
+    struct QueuedJob {
+        Job         function;
+        JobCounter* counter;
+    };
+
+    struct WorkQueue {
+        std::mutex            mutex;
+        std::deque<QueuedJob> jobs;
+    };
+
+    /**
+     * Takes a job from own queue or steals one from the others, then runs it
+     * @return false if every queue was empty
+     */
+    bool RunNext(uint32_t queueIndex);
+
+    /**
+     * Worker thread body
+     */
+    void WorkerLoop(uint32_t queueIndex);
+
+    /**
+     * @return Queue of the calling thread
+     */
+    uint32_t CurrentQueue() const;
+
+    /** Queue 0 belongs to the creating thread, others to workers */
+    vector<unique<WorkQueue>> queues  { };
+    vector<std::thread>       workers { };
+
+    /** Number of jobs waiting in all queues */
+    std::atomic<size_t>       queued   { 0 };
+
+    /** Number of workers sleeping on wake */
+    std::atomic<uint32_t>     sleeping { 0 };
+
+    std::atomic<bool>         stopping { false };
+
+    std::mutex                sleepMutex;
+    std::condition_variable   wake;
+
+};
+
+} // namespace core
+
+#include "JobSystem.tpp"
+
+#endif //CORE_JOBSYSTEM_H
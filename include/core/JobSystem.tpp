@@ -0,0 +1,51 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "JobSystem.h"
+
+#include <algorithm>
+
+namespace core {
+
+template<typename F>
+void JobSystem::ParallelFor(size_t begin, size_t end, F&& function, size_t grainSize) {
+    if (begin >= end) { return; }
+
+    const size_t count = end - begin;
+    if (grainSize == 0) {
+        grainSize = std::max<size_t>(1, count / (ThreadCount() * 4));
+    }
+
+    JobCounter counter;
+    for (size_t first = begin; first < end; first += grainSize) {
+        const size_t last = std::min(end, first + grainSize);
+        Schedule([&function, first, last] {
+            for (size_t i = first; i < last; ++i) {
+                function(i);
+            }
+        }, &counter);
+    }
+    Wait(counter);
+}
+
+} // namespace core
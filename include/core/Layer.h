@@ -26,12 +26,27 @@
 
 #include "core/Essentials.h"
 #include "core/IDrawable.h"
+#include "core/Handle.h"
 #include "core/Instantiable.h"
 #include "core/Object.h"
 #include "core/NamedObjectContainer.h"
 
 namespace core {
 
+/**
+ * Frustum culling counters of a camera, summed over its layers
+ */
+struct CullingStats {
+    /** Drawables considered for draw */
+    uint32_t total   { 0 };
+
+    /** Drawables submitted for draw */
+    uint32_t visible  { 0 };
+
+    /** Drawables inside of the frustum, hidden by occluders */
+    uint32_t occluded { 0 };
+};
+
 class Layer : public Object, public IDrawable, public NamedObjectContainer<Layer> {
 public:
     explicit Layer(const string& name);
@@ -51,7 +66,40 @@ public:
     template<typename T>
     bool IsLinked(T& obj);
 
+    /**
+     * Links entity which is being created
+     * @details Skips the check for duplicates, new entity can not be linked yet
+     */
+    void LinkCreated(Entity& entity);
+
+    /**
+     * Makes sure count more objects of type T can be linked without allocating
+     */
+    template<typename T>
+    void Reserve(size_t count);
+
+    /**
+     * Unlinks entity which is being destroyed
+     * @details When unlinking is deferred, entity handle is left to become stale,
+     * and the layer is compacted once unlinking is no longer deferred
+     */
+    void Drop(Entity& entity);
+
+    /**
+     * Defers unlinking of destroyed entities, to remove them from layers in one pass
+     * @details Passing false compacts every layer that dropped entities in the meantime
+     */
+    static void DeferUnlink(bool defer);
+
     void Draw() override;
+
+    /**
+     * Draws drawables of linked entities whose bounding spheres intersect the frustum
+     * @details Bounding spheres are gathered first and tested in one batch, drawables without bounds are always drawn
+     * @param stats - counters are increased, not reset
+     * @param occlusion - Rasterized occluders, spheres inside of the frustum are tested against it. Can be nullptr
+     */
+    void Draw(const Frustum& frustum, CullingStats& stats, const OcclusionBuffer* occlusion = nullptr);
     void SetProjectionMatrix(Matrix4& mtx) override;
     void SetTransformMatrix(Matrix4& mtx) override;
     void SetLight(Light& light) override;
@@ -60,12 +108,42 @@ protected:
     friend class Camera;
 
     template<typename T>
-    vector<T*>& GetContainerForType();
+    auto& GetContainerForType();
 
-    vector<Entity*> entities { };
+    /**
+     * Returns value Layer stores to refer to obj
+     * @details EntityHandle for entities, raw pointer otherwise
+     */
+    template<typename T>
+    static auto Reference(T& obj);
+
+    vector<EntityHandle> entities { };
     vector<Camera*> cameras  { };
     vector<Light*>  lights   { };
 
+    /** Bounded drawables gathered for culling, reused between draws */
+    vector<IDrawable*> cullCandidates { };
+
+    /** Bounding spheres of cullCandidates, one array per component */
+    vector<float>      cullSpheres[4] { };
+
+    /** Culling result of cullCandidates */
+    vector<uint8_t>    cullVisibility { };
+
+    /** Indices of cullCandidates inside of the frustum, tested for occlusion */
+    vector<uint32_t>   occludees { };
+
+    /** Boxes enclosing bounding spheres of occludees */
+    vector<Range3D>    occludeeBounds { };
+
+    /** Occlusion result of occludees */
+    vector<uint8_t>    occludeeVisibility { };
+
+    /** Does entities contain handles of destroyed entities? */
+    bool hasStaleEntities { false };
+
+    static bool unlinkDeferred;
+
 private:
 
     template<typename T>
@@ -22,6 +22,7 @@
  SOFTWARE.
  */
 #include "Logger.h"
+#include <algorithm>
 #include <iomanip>
 
 namespace core {
@@ -29,33 +30,38 @@ namespace core {
 template<typename T>
 void Layer::Link(T& obj) {
     assertSupportedType<T>();
-    vector<T*>& container = GetContainerForType<T>();
+    auto& container = GetContainerForType<T>();
 
     if (IsLinked(obj)) {
-        Logger::Log(INTERNAL, WARN_HERE) << "Layer " << std::quoted(name) << " is already linked with " << obj.GetInfo();
-        throw std::logic_error("Layer " + name + " is already linked with " + obj.GetInfo());
+        Logger::Log(INTERNAL, WARN_HERE) << "Layer " << std::quoted(GetName()) << " is already linked with " << obj.GetInfo();
+        throw std::logic_error("Layer " + GetName() + " is already linked with " + obj.GetInfo());
     }
 
-    container.push_back(&obj);
+    container.push_back(Reference(obj));
 }
 template<typename T>
 void Layer::Unlink(T& obj) {
     assertSupportedType<T>();
-    vector<T*>& container = GetContainerForType<T>();
+    auto& container = GetContainerForType<T>();
 
-    container.erase(std::remove_if(container.begin(),
-                                   container.end(),
-                                   [&](T* e) { return *e == obj; }), container.end());
+    container.erase(std::remove(container.begin(), container.end(), Reference(obj)), container.end());
 }
 template<typename T>
 bool Layer::IsLinked(T& obj) {
     assertSupportedType<T>();
-    vector<T*>& container = GetContainerForType<T>();
+    auto& container = GetContainerForType<T>();
 
-    auto item = std::find(container.begin(), container.end(), &obj);
+    auto item = std::find(container.begin(), container.end(), Reference(obj));
     return item != container.end();
 }
 template<typename T>
+void Layer::Reserve(size_t count) {
+    assertSupportedType<T>();
+    auto& container = GetContainerForType<T>();
+
+    container.reserve(container.size() + count);
+}
+template<typename T>
 void Layer::assertSupportedType() {
     static_assert(std::is_same<Entity, T>::value
                || std::is_same<Camera, T>::value
@@ -63,10 +69,15 @@ void Layer::assertSupportedType() {
                   "Cannot handle object of unsupported type");
 }
 template<typename T>
-vector<T*>& Layer::GetContainerForType() {
+auto& Layer::GetContainerForType() {
     if constexpr(std::is_same<Entity, T>::value) { return entities; }
-    if constexpr(std::is_same<Camera, T>::value) { return cameras; }
-    if constexpr(std::is_same<Light, T> ::value) { return lights; }
+    else if constexpr(std::is_same<Camera, T>::value) { return cameras; }
+    else if constexpr(std::is_same<Light, T> ::value) { return lights; }
+}
+template<typename T>
+auto Layer::Reference(T& obj) {
+    if constexpr(std::is_same<Entity, T>::value) { return obj.GetHandle(); }
+    else { return &obj; }
 }
 
 }
\ No newline at end of file
@@ -38,6 +38,7 @@
 #include "Magnum/Math/Bezier.h"
 #include "Magnum/Math/Angle.h"
 #include "Magnum/Math/Range.h"
+#include "Magnum/Math/Frustum.h"
 #include "Magnum/Math/Quaternion.h"
 
 using namespace Math::Literals;
@@ -197,6 +198,76 @@ using Magnum::Math::sqrt;
 using Magnum::Math::abs;
 using Magnum::Math::log;
 using Magnum::Math::log2;
+using Magnum::Math::dot;
+
+/**
+ * Instruction set used by batch math functions, picked once at runtime
+ */
+enum class SimdLevel {
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+/**
+ * Translation, rotation and scale of many objects, stored as one array per component
+ * @details rotation is {x, y, z, w} of unit quaternions
+ */
+struct TransformArrays {
+    const float* position[3] { };
+    const float* rotation[4] { };
+    const float* scale[3]    { };
+};
+
+/**
+ * Bounding spheres of many objects, stored as one array per component
+ */
+struct SphereArrays {
+    const float* center[3] { };
+    const float* radius    { };
+};
+
+/**
+ * @return Instruction set batch functions run with on this CPU
+ */
+SimdLevel GetSimdLevel();
+
+/**
+ * Restricts batch functions to instruction set level, used to compare kernels in tests and benchmarks
+ * @note Levels not supported by the CPU fall back to the best supported one, check GetSimdLevel() afterwards
+ */
+void SetSimdLevel(SimdLevel level);
+
+/**
+ * Composes translation * rotation * scaling matrix of every object
+ * @details Same result as Matrix4::from(rotation.toMatrix(), position) * Matrix4::scaling(scale)
+ */
+void ComposeTransforms(const TransformArrays& input, Matrix4* output, size_t count);
+
+/**
+ * Multiplies matrices pairwise, output[i] = lhs[i] * rhs[i]
+ * @note output may alias lhs or rhs
+ */
+void Multiply(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, size_t count);
+
+/**
+ * Extracts normal matrix of every transform
+ * @details Same result as Matrix4::normalMatrix(), cofactor matrix of the upper-left 3x3 part
+ */
+void ExtractNormalMatrices(const Matrix4* transforms, Matrix3x3* output, size_t count);
+
+/**
+ * Normalizes quaternions stored as one array per component, in place
+ */
+void NormalizeQuaternions(float* x, float* y, float* z, float* w, size_t count);
+
+/**
+ * Tests bounding spheres against frustum planes
+ * @details visible[i] is 1 if sphere i is inside of or intersects every plane, 0 otherwise.
+ * Spheres near frustum corners may be reported visible while being outside
+ * @return Number of visible spheres
+ */
+size_t CullSpheres(const Frustum& frustum, const SphereArrays& spheres, uint8_t* visible, size_t count);
 
 } // namespace Math
 
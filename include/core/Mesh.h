@@ -25,6 +25,7 @@
 #define CORE_MESH_H
 
 #include "Essentials.h"
+#include "Math.h"
 
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/Shaders/VertexColorGL.h>
@@ -41,12 +42,46 @@ class Mesh {
 public:
     explicit Mesh(const GL::Mesh* glMesh);
 
+    /**
+     * @param bounds - Box enclosing all vertices, in model space
+     * @param radius - Radius of sphere centered at the center of bounds, enclosing all vertices
+     */
+    Mesh(const GL::Mesh* glMesh, const Range3D& bounds, float radius);
+
     GL::Mesh* GetGLMesh();
 
+    /**
+     * Are bounds of the mesh known?
+     * @details Meshes without bounds are never culled
+     */
+    bool HasBounds() const;
+
+    /**
+     * Get box enclosing all vertices, in model space
+     */
+    const Range3D& GetBounds() const;
+
+    /**
+     * Get radius of sphere centered at the center of bounds, enclosing all vertices
+     */
+    float GetBoundingRadius() const;
+
+    /**
+     * Computes bounds of mesh vertex positions
+     * @return false if mesh has no positions
+     */
+    static bool ComputeBounds(const Trade::MeshData& data, Range3D& bounds, float& radius);
+
 protected:
 
     GL::Mesh* mesh;
 
+    /** Box enclosing all vertices */
+    Range3D   bounds { };
+
+    /** Radius of enclosing sphere, negative if bounds are unknown */
+    float     radius { -1.0f };
+
 };
 
 
@@ -55,7 +55,7 @@ protected:
     
     void SetProjectionMatrix(Matrix4& mtx) override;
     void SetTransformMatrix(Matrix4& mtx) override;
-    void SetNormalMatrix(Matrix4& mtx);
+    void SetNormalMatrix(const Matrix3x3& mtx);
     
     void SetPointLight(Light& light);
     void SetDirectionalLight(Light& light);
@@ -0,0 +1,89 @@
+/**
+ *  Check MpscQueue.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_MPSCQUEUE_H
+#define CORE_MPSCQUEUE_H
+
+#include <atomic>
+
+namespace core {
+
+/**
+ * Link of an intrusive MpscQueue, derive queued types from it
+ */
+struct MpscNode {
+    std::atomic<MpscNode*> next { nullptr };
+};
+
+/**
+ * Intrusive lock-free multi-producer single-consumer queue
+ * @details Push is wait-free and may be called from any thread, Pop only from a single consumer thread.
+ * Queue doesn't own its nodes. Node may be pushed again once it was popped
+ * @tparam T - Node type, must derive from MpscNode
+ */
+template<typename T>
+class MpscQueue {
+public:
+    MpscQueue();
+
+    /** Copying is not allowed */
+    MpscQueue(const MpscQueue&) = delete;
+
+    /** Copying is not allowed */
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Append node to the queue
+     * @note Thread safe
+     */
+    void Push(T* node);
+
+    /**
+     * Take the oldest node out of the queue
+     * @return nullptr if queue is empty, or if the next node is still being pushed by a producer
+     * @note Consumer thread only
+     */
+    T* Pop();
+
+private:
+
+    void PushNode(MpscNode* node);
+
+    /** Last pushed node, producers swap it */
+    alignas(64) std::atomic<MpscNode*> head;
+
+    /** Next node to pop, touched by consumer only */
+    alignas(64) MpscNode* tail;
+
+    /** Placeholder keeping the list non-empty */
+    MpscNode stub;
+};
+
+} // namespace core
+
+#include "MpscQueue.tpp"
+
+#endif //CORE_MPSCQUEUE_H
@@ -0,0 +1,77 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "MpscQueue.h"
+
+#include <type_traits>
+
+namespace core {
+
+template<typename T>
+MpscQueue<T>::MpscQueue() : head(&stub), tail(&stub) {
+    static_assert(std::is_base_of<MpscNode, T>::value, "MpscQueue node type must derive from MpscNode");
+}
+template<typename T>
+void MpscQueue<T>::Push(T* node) {
+    PushNode(node);
+}
+template<typename T>
+void MpscQueue<T>::PushNode(MpscNode* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    MpscNode* prev = head.exchange(node, std::memory_order_acq_rel);
+
+    /* Between exchange and this store the list is briefly cut, consumer sees it as empty past prev */
+    prev->next.store(node, std::memory_order_release);
+}
+template<typename T>
+T* MpscQueue<T>::Pop() {
+    MpscNode* first = tail;
+    MpscNode* next  = first->next.load(std::memory_order_acquire);
+
+    if (first == &stub) {
+        if (!next) { return nullptr; }
+
+        tail  = next;
+        first = next;
+        next  = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+        tail = next;
+        return static_cast<T*>(first);
+    }
+    if (first != head.load(std::memory_order_acquire)) {
+        /* Producer is in the middle of Push */
+        return nullptr;
+    }
+
+    /* first is the last node, put stub behind it so first can be handed out */
+    PushNode(&stub);
+    next = first->next.load(std::memory_order_acquire);
+    if (next) {
+        tail = next;
+        return static_cast<T*>(first);
+    }
+    return nullptr;
+}
+
+}
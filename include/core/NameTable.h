@@ -0,0 +1,60 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_NAMETABLE_H
+#define CORE_NAMETABLE_H
+
+#include "Essentials.h"
+
+namespace core {
+
+using NameId = uint32_t;
+
+/**
+ * Global table of interned names
+ * @details Every distinct name is stored once and identified by a NameId,
+ * so objects with the same name share the string instead of owning a copy.
+ * Id 0 is always the empty name
+ */
+class NameTable {
+public:
+
+    /**
+     * Get id of name, adding it to the table on first use
+     * @note Thread-safe. Names recently interned by the calling thread are found without locking,
+     * the table is locked only to look up other names and to add new ones
+     */
+    static NameId Intern(const string& name);
+
+    /**
+     * @return Name with given id
+     * @note Lock-free, returned reference stays valid for the lifetime of the program
+     * @throw std::out_of_range if id was not given out by Intern
+     */
+    static const string& Get(NameId id);
+
+};
+
+} // namespace core
+
+#endif //CORE_NAMETABLE_H
@@ -25,6 +25,7 @@
 #define CORE_OBJECTID_H
 
 #include "Essentials.h"
+#include "NameTable.h"
 
 #include <utility>
 #include <atomic>
@@ -33,6 +34,8 @@ namespace core {
 
 /**
  *  Base class of every countable class
+ *  @details Name is kept as an id in NameTable, objects with the same name share one string.
+ *  Creation and destruction are logged only when built with CORE_TRACE_LIFECYCLE
  */
 class Object {
 public:
@@ -45,7 +48,12 @@ public:
     /**
      * @return std::string Name of the object
      */
-    const string& GetName();
+    const string& GetName() const;
+
+    /**
+     * @return NameId Interned name of the object
+     */
+    NameId GetNameId() const;
 
     /**
      * @return uint32_t ID of the object
@@ -69,15 +77,14 @@ public:
 
 protected:
 
-    explicit Object(string name = "") noexcept;
+    explicit Object(const string& name = "");
     virtual ~Object();
 
-    string name;
-
 private:
 
     static std::atomic<uint32_t> objectCounter;
 
+    NameId nameId;
     uint32_t id;
 
 };
@@ -0,0 +1,86 @@
+/**
+ *  Check Prefab.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_PREFAB_H
+#define CORE_PREFAB_H
+
+#include "Essentials.h"
+#include "Entity.h"
+
+#include <functional>
+
+namespace core {
+
+/**
+ * Recipe of an Entity: its name, layer and set of components
+ * @details Used with Entity::SpawnBatch to create many identical entities at once
+ */
+class Prefab {
+public:
+    explicit Prefab(string name = "Entity", string layer = "Default");
+
+    /**
+     * Adds component T to the recipe, arguments are copied and passed to every created component
+     * @details Method chaining is available
+     * @return reference to this Prefab
+     */
+    template<typename T, typename ...Args>
+    Prefab& Add(Args... args);
+
+    const string& GetName() const;
+    const string& GetLayer() const;
+
+protected:
+    friend class Entity;
+
+    /**
+     * Adds components of the recipe to entity
+     */
+    void Build(Entity& entity) const;
+
+    /**
+     * Makes sure component storages can hold count more components
+     */
+    void Reserve(size_t count) const;
+
+    /**
+     * @return Number of components in the recipe
+     */
+    size_t Size() const;
+
+    string name;
+    string layer;
+
+    vector<std::function<void(Entity&)>> builders     { };
+    vector<std::function<void(size_t)>>  reservations { };
+
+};
+
+} // namespace core
+
+#include "Prefab.tpp"
+
+#endif //CORE_PREFAB_H
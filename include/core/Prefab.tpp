@@ -0,0 +1,45 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "Prefab.h"
+#include "ComponentStorage.h"
+
+#include <tuple>
+#include <utility>
+
+namespace core {
+
+template<typename T, typename ...Args>
+Prefab& Prefab::Add(Args... args) {
+    static_assert(std::is_base_of<IComponent, T>::value, "Component T must inherit from core::IComponent");
+
+    builders.emplace_back([arguments = std::make_tuple(std::move(args)...)](Entity& entity) {
+        std::apply([&](const Args&... a) { entity.AddComponent<T>(a...); }, arguments);
+    });
+    reservations.emplace_back([](size_t count) {
+        ComponentStorage<T>::Get().Reserve(count);
+    });
+    return *this;
+}
+
+} // namespace core
@@ -41,6 +41,8 @@
 #include <Magnum/MeshTools/CompressIndices.h>
 #include <Magnum/Shaders/PhongGL.h>
 
+#include <cmath>
+
 namespace core {
 
 typedef struct Rect {
@@ -48,23 +50,28 @@ typedef struct Rect {
     float w, h;
 } Rect;
 
+/*
+ * Magnum primitives fit in [-1, 1] on every axis,
+ * enclosing sphere radius is the distance to the furthest vertex from the origin
+ */
+
 struct Cube : public Mesh {
-    explicit Cube() : Mesh(&cubeMesh) { }
+    explicit Cube() : Mesh(&cubeMesh, { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } }, std::sqrt(3.0f)) { }
 
     static GL::Mesh cubeMesh;
 };
 struct Sphere : public Mesh {
-    explicit Sphere() : Mesh(&sphereMesh) { }
+    explicit Sphere() : Mesh(&sphereMesh, { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } }, 1.0f) { }
 
     static GL::Mesh sphereMesh;
 };
 struct Cone : public Mesh {
-    explicit Cone() : Mesh(&coneMesh) { }
+    explicit Cone() : Mesh(&coneMesh, { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } }, std::sqrt(2.0f)) { }
 
     static GL::Mesh coneMesh;
 };
 struct Cylinder : public Mesh {
-    explicit Cylinder() : Mesh(&cylinderMesh) { }
+    explicit Cylinder() : Mesh(&cylinderMesh, { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } }, std::sqrt(2.0f)) { }
 
     static GL::Mesh cylinderMesh;
 };
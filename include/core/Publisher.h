@@ -30,24 +30,69 @@
 #include <vector>
 #include <utility>
 #include <functional>
-#include <unordered_set>
+#include <cstdint>
 
 namespace core {
 
+/**
+ * Event name hashed with 64-bit FNV-1a
+ * @details Declare ids as constexpr, e.g. static constexpr EventId OnOpen = "OnOpen"_event, so names are hashed at compile time.
+ * Name is kept only for diagnostics and is expected to be a string literal
+ */
+struct EventId {
+    uint64_t    hash;
+    const char* name;
+
+    constexpr EventId(const char* name) : hash(Hash(name)), name(name) { }
+
+    /** 0 marks empty slots of Publisher table */
+    static constexpr uint64_t Hash(const char* name) {
+        uint64_t value = 14695981039346656037ull;
+        for (; *name; ++name) {
+            value = (value ^ static_cast<unsigned char>(*name)) * 1099511628211ull;
+        }
+        return value ? value : 1;
+    }
+
+    constexpr bool operator==(const EventId& rhs) const { return hash == rhs.hash; }
+    constexpr bool operator!=(const EventId& rhs) const { return hash != rhs.hash; }
+};
+
+constexpr EventId operator""_event(const char* name, size_t) {
+    return EventId(name);
+}
+
 class Publisher {
 public:
 
-    void SubscribeTo(const char* name, const std::function<void()>& callback);
-    bool HasEvent(const string& name);
+    void SubscribeTo(EventId id, const std::function<void()>& callback);
+    bool HasEvent(EventId id) const;
 
 protected:
     using callbackList = std::vector<std::function<void()>>;
-    using event = std::pair<string, callbackList>;
 
-    void AddEvent(const string& name);
-    void Trigger(const string& name);
+    struct event {
+        uint64_t     hash { 0 };
+        const char*  name { nullptr };
+        callbackList callbacks;
+    };
+
+    void AddEvent(EventId id);
+    void Trigger(EventId id);
+
+    /**
+     * Find slot of event in open-addressed table
+     * @return nullptr if publisher does not have the event
+     */
+    event* FindEvent(EventId id);
+    const event* FindEvent(EventId id) const;
+
+    /** Doubles table size and reinserts every event */
+    void Grow();
 
+    /** Power of two sized, linear probing, kept at most half full */
     std::vector<event> eventList;
+    size_t eventCount { 0 };
 
 };
 
@@ -0,0 +1,187 @@
+/**
+ *  Check Query.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_QUERY_H
+#define CORE_QUERY_H
+
+#include "Essentials.h"
+#include "ComponentType.h"
+#include "Entity.h"
+
+#include <tuple>
+#include <utility>
+
+namespace core {
+
+/**
+ * Type-erased interface of Query
+ * @details Every query is notified when an entity's set of components changes
+ */
+class IQuery {
+public:
+    virtual ~IQuery() = default;
+
+    /**
+     * @return Set of component types an entity must have to match the query
+     */
+    const ComponentSignature& GetSignature() const;
+
+    /**
+     * Moves entity in or out of every query whose match result changed
+     * @param previous - Signature of entity before the change
+     */
+    static void SignatureChanged(Entity& entity, const ComponentSignature& previous);
+
+    /**
+     * Removes entity from every query it matches
+     * @note Called from Entity destructor, before its components are released
+     */
+    static void EntityDestroyed(Entity& entity);
+
+protected:
+
+    IQuery();
+
+    virtual void Insert(Entity& entity) = 0;
+    virtual void Erase(Entity& entity) = 0;
+
+    /**
+     * Get all queries ever created
+     * @note Never destroyed, entities of static scenes are notified after other statics are gone
+     */
+    static vector<IQuery*>& Instances();
+
+    ComponentSignature signature { };
+
+};
+
+/**
+ * Query filter, matches entities only if component T was written since the consumer last visited them
+ * @details Compares change ticks set by IComponent::MarkChanged(), e.g. Query<Changed<Transform>, Renderer>.
+ * With several Changed terms, all of them have to be written between two visits.
+ * Every consumer keeps its own tick and passes it to Query::Each, so any number of systems can share one query
+ */
+template<typename T>
+struct Changed { };
+
+/**
+ * Component type of a query term, unwraps filters
+ */
+template<typename T>
+struct QueryTerm {
+    using Component = T;
+    static constexpr bool changed = false;
+};
+
+template<typename T>
+struct QueryTerm<Changed<T>> {
+    using Component = T;
+    static constexpr bool changed = true;
+};
+
+/**
+ * Cached set of entities having all of the components Ts
+ * @details Set is updated incrementally as components are added to and removed from entities.
+ * Matching components are stored as tightly packed rows, so iteration never looks components up
+ * @tparam Ts - Component typenames, optionally wrapped into Changed<T> filter
+ */
+template<typename ...Ts>
+class Query : public IQuery {
+public:
+
+    /** Copying is not allowed */
+    Query(const Query&) = delete;
+
+    /** Copying is not allowed */
+    Query& operator=(const Query&) = delete;
+
+    /**
+     * Get query for components Ts
+     * @note Query is created and filled on first call and is kept up to date afterwards
+     */
+    static Query<Ts...>& Get();
+
+    /**
+     * Calls function for every matching entity
+     * @param function - Callable taking components (Ts&...) or (Entity&, Ts&...), with filters unwrapped
+     * @note Entities destroyed while iterating may cause other entities to be skipped this time
+     */
+    template<typename F>
+    void Each(F&& function);
+
+    /**
+     * Calls function for every matching entity with Changed terms written since the previous visit
+     * @param lastVisit - Change tick of the consumer, 0 before its first visit. Updated by the call
+     * @param function - Callable taking components (Ts&...) or (Entity&, Ts&...), with filters unwrapped
+     * @note Writes made by the function itself are reported on the next visit
+     */
+    template<typename F>
+    void Each(uint64_t& lastVisit, F&& function);
+
+    /**
+     * @return Number of matching entities
+     */
+    size_t Size() const;
+
+protected:
+
+    Query();
+
+    void Insert(Entity& entity) override;
+    void Erase(Entity& entity) override;
+
+    /** Does any of the terms filter by changes? */
+    static constexpr bool filtered = (QueryTerm<Ts>::changed || ...);
+
+    struct Row {
+        Entity*                                               entity;
+        std::tuple<typename QueryTerm<Ts>::Component*...>     components;
+
+        /** Change tick at which entity started matching, it counts as changed until visited */
+        uint64_t                                              matched;
+    };
+
+    /**
+     * @return true if every Changed component of the row was written after lastVisit
+     */
+    static bool IsChanged(const Row& row, uint64_t lastVisit);
+
+    template<typename F>
+    static void Invoke(Row& row, F& function);
+
+    /** Matching entities with their components, densely packed */
+    vector<Row>      rows     { };
+
+    /** Row of each entity, indexed by EntityHandle::index */
+    vector<uint32_t> rowIndex { };
+
+};
+
+} // namespace core
+
+#include "Query.tpp"
+
+#endif //CORE_QUERY_H
@@ -0,0 +1,114 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "Query.h"
+#include "ComponentStorage.h"
+
+#include <type_traits>
+#include <utility>
+
+namespace core {
+
+template<typename ...Ts>
+Query<Ts...>& Query<Ts...>::Get() {
+    static_assert(sizeof...(Ts) > 0, "Query must have at least one component type");
+    static_assert((std::is_base_of<IComponent, typename QueryTerm<Ts>::Component>::value && ...), "Components Ts must inherit from core::IComponent");
+
+    // Intentionally never destroyed, same as ComponentStorage
+    static Query<Ts...>* query = new Query<Ts...>();
+    return *query;
+}
+template<typename ...Ts>
+Query<Ts...>::Query() {
+    (signature.Set(ComponentType::Id<typename QueryTerm<Ts>::Component>()), ...);
+
+    /* Every matching entity has the first component, so its storage lists all candidates */
+    using First = typename QueryTerm<std::tuple_element_t<0, std::tuple<Ts...>>>::Component;
+    for (First* component : ComponentStorage<First>::Get().GetComponents()) {
+        if (component->entity->GetSignature().Contains(signature)) {
+            Insert(*component->entity);
+        }
+    }
+}
+template<typename ...Ts>
+template<typename F>
+void Query<Ts...>::Each(F&& function) {
+    static_assert(!filtered, "Query with Changed terms is iterated with the consumer's change tick");
+
+    // Indexed loop, since entities might start matching while iterating
+    for (size_t i = 0; i < rows.size(); ++i) {
+        Invoke(rows[i], function);
+    }
+}
+template<typename ...Ts>
+template<typename F>
+void Query<Ts...>::Each(uint64_t& lastVisit, F&& function) {
+    /* Writes from now on get a greater tick and are left for the next visit */
+    const uint64_t previous = lastVisit;
+    lastVisit = IComponent::AdvanceChangeTick();
+
+    for (size_t i = 0; i < rows.size(); ++i) {
+        if (IsChanged(rows[i], previous)) { Invoke(rows[i], function); }
+    }
+}
+template<typename ...Ts>
+bool Query<Ts...>::IsChanged(const Row& row, uint64_t lastVisit) {
+    if (row.matched > lastVisit) { return true; }
+
+    return std::apply([&](auto*... components) {
+        return ((!QueryTerm<Ts>::changed || components->GetChangeTick() > lastVisit) && ...);
+    }, row.components);
+}
+template<typename ...Ts>
+template<typename F>
+void Query<Ts...>::Invoke(Row& row, F& function) {
+    std::apply([&](auto*... components) {
+        if constexpr(std::is_invocable<F, Entity&, typename QueryTerm<Ts>::Component&...>::value) {
+            function(*row.entity, *components...);
+        } else {
+            function(*components...);
+        }
+    }, row.components);
+}
+template<typename ...Ts>
+size_t Query<Ts...>::Size() const {
+    return rows.size();
+}
+template<typename ...Ts>
+void Query<Ts...>::Insert(Entity& entity) {
+    const uint32_t index = entity.GetHandle().index;
+    if (index >= rowIndex.size()) { rowIndex.resize(index + 1); }
+
+    rowIndex[index] = static_cast<uint32_t>(rows.size());
+    rows.push_back({ &entity, std::make_tuple(entity.GetComponent<typename QueryTerm<Ts>::Component>()...), IComponent::CurrentChangeTick() });
+}
+template<typename ...Ts>
+void Query<Ts...>::Erase(Entity& entity) {
+    const uint32_t row = rowIndex[entity.GetHandle().index];
+
+    rows[row] = rows.back();
+    rowIndex[rows[row].entity->GetHandle().index] = row;
+    rows.pop_back();
+}
+
+} // namespace core
@@ -0,0 +1,243 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_BOUNDINGVOLUMETREE_H
+#define CORE_BOUNDINGVOLUMETREE_H
+
+/**
+ *  Check BoundingVolumeTree.tpp for template definitions
+ */
+
+#include "core/Essentials.h"
+#include "core/Math.h"
+
+#include <limits>
+
+namespace core {
+
+/**
+ * Dynamic AABB tree
+ * @tparam T - Value stored with every box, returned by queries
+ * @details Leaves keep exact bounds of an object and fat bounds, enlarged by a margin,
+ * so small movements do not change the tree. Leaves are inserted next to the sibling
+ * with the lowest surface area cost and unbalanced nodes are rotated on the way up.
+ * Rebuild() recreates the whole tree top-down with binned surface area heuristic.
+ * Queries append values of hit leaves to a caller-provided vector, so reusing the vector
+ * between frames makes them allocation-free
+ * @note Queries are const and can run concurrently, modifications must not run concurrently with anything
+ */
+template<typename T>
+class BoundingVolumeTree {
+public:
+    static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+    /**
+     * @param margin - Fat bounds are enlarged by this distance on every side
+     */
+    explicit BoundingVolumeTree(float margin = 0.1f);
+
+    /**
+     * Add box to the tree
+     * @return Proxy id of the box, stays the same until Remove
+     */
+    uint32_t Insert(const Range3D& bounds, const T& value);
+
+    /**
+     * Remove box from the tree
+     */
+    void Remove(uint32_t proxy);
+
+    /**
+     * Update box bounds
+     * @return true if box left its fat bounds and was reinserted
+     */
+    bool Move(uint32_t proxy, const Range3D& bounds);
+
+    /**
+     * Recreate the tree with binned surface area heuristic
+     * @details Incremental inserts keep the tree balanced, but not optimal.
+     * Rebuild after loading many objects at once or when queries get slower
+     */
+    void Rebuild();
+
+    /**
+     * Remove every box
+     */
+    void Clear();
+
+    const T&       GetValue(uint32_t proxy) const;
+
+    /**
+     * @return Exact bounds of the box
+     */
+    const Range3D& GetBounds(uint32_t proxy) const;
+
+    /**
+     * @return Number of boxes in the tree
+     */
+    size_t         Size() const;
+
+    /**
+     * @return Height of the tree, 0 if empty or has a single box
+     */
+    uint32_t       GetHeight() const;
+
+    /**
+     * Find boxes overlapping with box
+     */
+    void QueryOverlap(const Range3D& box, vector<T>& result) const;
+
+    /**
+     * Find boxes overlapping with each box of the batch
+     * @param offsets - Results of boxes[i] are result[offsets[i]] to result[offsets[i + 1]], offsets.size() is boxes.size() + 1
+     */
+    void QueryOverlap(const vector<Range3D>& boxes, vector<T>& result, vector<uint32_t>& offsets) const;
+
+    /**
+     * Find boxes overlapping with sphere
+     */
+    void QuerySphere(const Vector3& center, float radius, vector<T>& result) const;
+
+    /**
+     * Find boxes hit by the ray segment
+     * @param direction - Ray direction, does not need to be normalized
+     * @param maxDistance - Length of the segment, in units of direction length
+     * @note Results are not sorted by distance
+     */
+    void QueryRay(const Vector3& origin, const Vector3& direction, float maxDistance, vector<T>& result) const;
+
+    /**
+     * Find boxes inside of or intersecting with frustum
+     * @details Planes a node is fully inside of are not tested again for its children
+     */
+    void QueryFrustum(const Frustum& frustum, vector<T>& result) const;
+
+private:
+
+    struct Node {
+        /** Exact bounds, used only by leaves */
+        Range3D  bounds;
+
+        /** Enlarged bounds for leaves, union of children fat bounds for branches */
+        Range3D  fatBounds;
+
+        T        value    { };
+
+        /** Parent node, next free node if node is not used */
+        uint32_t parent   { none };
+        uint32_t left     { none };
+        uint32_t right    { none };
+
+        /** Leaves have height 0, free nodes -1 */
+        int32_t  height   { -1 };
+
+        bool IsLeaf() const { return left == none; }
+    };
+
+    /**
+     * Traversal stack, stays on the call stack unless the tree is very deep
+     */
+    class Stack {
+    public:
+        void Push(uint32_t node, uint32_t mask = 0);
+        bool Pop(uint32_t& node, uint32_t& mask);
+
+    private:
+        static constexpr size_t inlineSize = 128;
+
+        uint32_t nodes[inlineSize];
+        uint32_t masks[inlineSize];
+        size_t   size { 0 };
+
+        vector<std::pair<uint32_t, uint32_t>> overflow;
+    };
+
+    uint32_t AllocateNode();
+    void     FreeNode(uint32_t node);
+
+    void     InsertLeaf(uint32_t leaf);
+    void     RemoveLeaf(uint32_t leaf);
+
+    /**
+     * Rotate node if its children heights differ by more than 1
+     * @return Node taking place of the given one
+     */
+    uint32_t Balance(uint32_t node);
+
+    /**
+     * Recompute bounds and height of the branch from its children
+     */
+    void     Refit(uint32_t node);
+
+    /**
+     * Build subtree of leaves in range [begin, end)
+     * @return Root node of the subtree
+     */
+    uint32_t Build(uint32_t* begin, uint32_t* end, uint32_t depth);
+
+    /**
+     * @throw std::out_of_range if proxy is not a box in the tree
+     */
+    void     AssertProxy(uint32_t proxy) const;
+
+    Range3D  Fatten(const Range3D& bounds) const;
+
+    static Range3D Join(const Range3D& a, const Range3D& b);
+
+    /** Half of the surface area, good enough for comparing costs */
+    static float   HalfArea(const Range3D& bounds);
+    static bool    Contains(const Range3D& outer, const Range3D& inner);
+    static bool    Overlaps(const Range3D& a, const Range3D& b);
+    static float   DistanceSquared(const Range3D& bounds, const Vector3& point);
+    static bool    RayHits(const Range3D& bounds, const Vector3& origin, const Vector3& direction,
+                           const Vector3& inverseDirection, float maxDistance);
+
+    /**
+     * Test bounds against frustum planes in mask
+     * @return false if bounds are fully outside of a plane
+     * @details Planes bounds are fully inside of are removed from the mask
+     */
+    static bool    FrustumHits(const Frustum& frustum, const Range3D& bounds, uint32_t& mask);
+
+    /** Subtrees deeper than this are split by median, so the traversal stack stays small */
+    static constexpr uint32_t maxSahDepth = 32;
+
+    static constexpr uint32_t binCount    = 16;
+
+    float        margin;
+
+    vector<Node> nodes;
+
+    uint32_t     root     { none };
+    uint32_t     freeList { none };
+    size_t       leafCount { 0 };
+
+    /** Leaves collected for Rebuild, reused between rebuilds */
+    vector<uint32_t> leaves;
+};
+
+} // namespace core
+
+#include "BoundingVolumeTree.tpp"
+
+#endif //CORE_BOUNDINGVOLUMETREE_H
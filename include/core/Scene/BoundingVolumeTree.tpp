@@ -0,0 +1,585 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "BoundingVolumeTree.h"
+#include "core/Logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace core {
+
+template<typename T>
+BoundingVolumeTree<T>::BoundingVolumeTree(float margin)
+: margin(margin)
+{ }
+template<typename T>
+void BoundingVolumeTree<T>::Stack::Push(uint32_t node, uint32_t mask) {
+    if (size < inlineSize) {
+        nodes[size] = node;
+        masks[size] = mask;
+        ++size;
+        return;
+    }
+    overflow.emplace_back(node, mask);
+}
+template<typename T>
+bool BoundingVolumeTree<T>::Stack::Pop(uint32_t& node, uint32_t& mask) {
+    /* Overflow only grows while inline part is full, so its entries are always the newest */
+    if (!overflow.empty()) {
+        node = overflow.back().first;
+        mask = overflow.back().second;
+        overflow.pop_back();
+        return true;
+    }
+    if (size == 0) { return false; }
+
+    --size;
+    node = nodes[size];
+    mask = masks[size];
+    return true;
+}
+template<typename T>
+uint32_t BoundingVolumeTree<T>::Insert(const Range3D& bounds, const T& value) {
+    const uint32_t leaf = AllocateNode();
+    Node& node = nodes[leaf];
+    node.bounds    = bounds;
+    node.fatBounds = Fatten(bounds);
+    node.value     = value;
+    node.height    = 0;
+
+    InsertLeaf(leaf);
+    ++leafCount;
+    return leaf;
+}
+template<typename T>
+void BoundingVolumeTree<T>::Remove(uint32_t proxy) {
+    AssertProxy(proxy);
+
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    --leafCount;
+}
+template<typename T>
+bool BoundingVolumeTree<T>::Move(uint32_t proxy, const Range3D& bounds) {
+    AssertProxy(proxy);
+
+    const Range3D fatBounds = Fatten(bounds);
+    nodes[proxy].bounds = bounds;
+
+    /* Fat bounds that became much larger than needed (e.g. after scaling down) are tightened as well */
+    if (Contains(nodes[proxy].fatBounds, bounds) && HalfArea(nodes[proxy].fatBounds) <= 4.0f * HalfArea(fatBounds)) {
+        return false;
+    }
+
+    RemoveLeaf(proxy);
+    nodes[proxy].fatBounds = fatBounds;
+    InsertLeaf(proxy);
+    return true;
+}
+template<typename T>
+void BoundingVolumeTree<T>::Rebuild() {
+    leaves.clear();
+    for (uint32_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i].height == 0) {
+            leaves.push_back(i);
+        } else if (nodes[i].height > 0) {
+            FreeNode(i);
+        }
+    }
+
+    if (leaves.empty()) {
+        root = none;
+        return;
+    }
+    root = Build(leaves.data(), leaves.data() + leaves.size(), 0);
+    nodes[root].parent = none;
+}
+template<typename T>
+void BoundingVolumeTree<T>::Clear() {
+    nodes.clear();
+    root      = none;
+    freeList  = none;
+    leafCount = 0;
+}
+template<typename T>
+const T& BoundingVolumeTree<T>::GetValue(uint32_t proxy) const {
+    AssertProxy(proxy);
+    return nodes[proxy].value;
+}
+template<typename T>
+const Range3D& BoundingVolumeTree<T>::GetBounds(uint32_t proxy) const {
+    AssertProxy(proxy);
+    return nodes[proxy].bounds;
+}
+template<typename T>
+size_t BoundingVolumeTree<T>::Size() const {
+    return leafCount;
+}
+template<typename T>
+uint32_t BoundingVolumeTree<T>::GetHeight() const {
+    return root == none ? 0 : static_cast<uint32_t>(nodes[root].height);
+}
+template<typename T>
+void BoundingVolumeTree<T>::QueryOverlap(const Range3D& box, vector<T>& result) const {
+    if (root == none) { return; }
+
+    Stack stack;
+    stack.Push(root);
+
+    uint32_t index, mask;
+    while (stack.Pop(index, mask)) {
+        const Node& node = nodes[index];
+        if (node.IsLeaf()) {
+            if (Overlaps(node.bounds, box)) { result.push_back(node.value); }
+            continue;
+        }
+        if (!Overlaps(node.fatBounds, box)) { continue; }
+
+        stack.Push(node.left);
+        stack.Push(node.right);
+    }
+}
+template<typename T>
+void BoundingVolumeTree<T>::QueryOverlap(const vector<Range3D>& boxes, vector<T>& result, vector<uint32_t>& offsets) const {
+    offsets.clear();
+    offsets.reserve(boxes.size() + 1);
+    offsets.push_back(static_cast<uint32_t>(result.size()));
+
+    for (const Range3D& box : boxes) {
+        QueryOverlap(box, result);
+        offsets.push_back(static_cast<uint32_t>(result.size()));
+    }
+}
+template<typename T>
+void BoundingVolumeTree<T>::QuerySphere(const Vector3& center, float radius, vector<T>& result) const {
+    if (root == none) { return; }
+
+    const float radiusSquared = radius * radius;
+
+    Stack stack;
+    stack.Push(root);
+
+    uint32_t index, mask;
+    while (stack.Pop(index, mask)) {
+        const Node& node = nodes[index];
+        if (node.IsLeaf()) {
+            if (DistanceSquared(node.bounds, center) <= radiusSquared) { result.push_back(node.value); }
+            continue;
+        }
+        if (DistanceSquared(node.fatBounds, center) > radiusSquared) { continue; }
+
+        stack.Push(node.left);
+        stack.Push(node.right);
+    }
+}
+template<typename T>
+void BoundingVolumeTree<T>::QueryRay(const Vector3& origin, const Vector3& direction, float maxDistance, vector<T>& result) const {
+    if (root == none) { return; }
+
+    const Vector3 inverseDirection {
+        direction.x() != 0.0f ? 1.0f / direction.x() : 0.0f,
+        direction.y() != 0.0f ? 1.0f / direction.y() : 0.0f,
+        direction.z() != 0.0f ? 1.0f / direction.z() : 0.0f
+    };
+
+    Stack stack;
+    stack.Push(root);
+
+    uint32_t index, mask;
+    while (stack.Pop(index, mask)) {
+        const Node& node = nodes[index];
+        if (node.IsLeaf()) {
+            if (RayHits(node.bounds, origin, direction, inverseDirection, maxDistance)) { result.push_back(node.value); }
+            continue;
+        }
+        if (!RayHits(node.fatBounds, origin, direction, inverseDirection, maxDistance)) { continue; }
+
+        stack.Push(node.left);
+        stack.Push(node.right);
+    }
+}
+template<typename T>
+void BoundingVolumeTree<T>::QueryFrustum(const Frustum& frustum, vector<T>& result) const {
+    if (root == none) { return; }
+
+    constexpr uint32_t allPlanes = (1u << 6) - 1;
+
+    Stack stack;
+    stack.Push(root, allPlanes);
+
+    uint32_t index, mask;
+    while (stack.Pop(index, mask)) {
+        const Node& node = nodes[index];
+
+        /* Empty mask means the parent is fully inside, so is every box below it */
+        if (mask != 0 && !FrustumHits(frustum, node.IsLeaf() ? node.bounds : node.fatBounds, mask)) { continue; }
+
+        if (node.IsLeaf()) {
+            result.push_back(node.value);
+            continue;
+        }
+        stack.Push(node.left, mask);
+        stack.Push(node.right, mask);
+    }
+}
+template<typename T>
+uint32_t BoundingVolumeTree<T>::AllocateNode() {
+    if (freeList == none) {
+        nodes.emplace_back();
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+    const uint32_t node = freeList;
+    freeList = nodes[node].parent;
+    nodes[node] = Node { };
+    return node;
+}
+template<typename T>
+void BoundingVolumeTree<T>::FreeNode(uint32_t node) {
+    nodes[node].parent = freeList;
+    nodes[node].left   = none;
+    nodes[node].right  = none;
+    nodes[node].height = -1;
+    freeList = node;
+}
+template<typename T>
+void BoundingVolumeTree<T>::InsertLeaf(uint32_t leaf) {
+    if (root == none) {
+        root = leaf;
+        nodes[root].parent = none;
+        return;
+    }
+
+    /* Descend towards the sibling with the lowest cost of the new parent plus area added to its ancestors */
+    const Range3D leafBounds = nodes[leaf].fatBounds;
+    uint32_t index = root;
+    while (!nodes[index].IsLeaf()) {
+        const Node& node = nodes[index];
+
+        const float area            = HalfArea(node.fatBounds);
+        const float combinedArea    = HalfArea(Join(node.fatBounds, leafBounds));
+        const float cost            = 2.0f * combinedArea;
+        const float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto childCost = [&](uint32_t child) {
+            const Node& childNode = nodes[child];
+            const float joinedArea = HalfArea(Join(leafBounds, childNode.fatBounds));
+            return (childNode.IsLeaf() ? joinedArea : joinedArea - HalfArea(childNode.fatBounds)) + inheritanceCost;
+        };
+        const float leftCost  = childCost(node.left);
+        const float rightCost = childCost(node.right);
+
+        if (cost < leftCost && cost < rightCost) { break; }
+
+        index = leftCost < rightCost ? node.left : node.right;
+    }
+
+    const uint32_t sibling   = index;
+    const uint32_t oldParent = nodes[sibling].parent;
+    const uint32_t newParent = AllocateNode();
+
+    nodes[newParent].parent = oldParent;
+    nodes[newParent].left   = sibling;
+    nodes[newParent].right  = leaf;
+    nodes[sibling].parent   = newParent;
+    nodes[leaf].parent      = newParent;
+    Refit(newParent);
+
+    if (oldParent == none) {
+        root = newParent;
+    } else if (nodes[oldParent].left == sibling) {
+        nodes[oldParent].left = newParent;
+    } else {
+        nodes[oldParent].right = newParent;
+    }
+
+    for (index = oldParent; index != none; index = nodes[index].parent) {
+        index = Balance(index);
+        Refit(index);
+    }
+}
+template<typename T>
+void BoundingVolumeTree<T>::RemoveLeaf(uint32_t leaf) {
+    if (leaf == root) {
+        root = none;
+        return;
+    }
+
+    const uint32_t parent      = nodes[leaf].parent;
+    const uint32_t grandParent = nodes[parent].parent;
+    const uint32_t sibling     = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+    nodes[leaf].parent = none;
+    FreeNode(parent);
+
+    if (grandParent == none) {
+        root = sibling;
+        nodes[sibling].parent = none;
+        return;
+    }
+
+    if (nodes[grandParent].left == parent) {
+        nodes[grandParent].left = sibling;
+    } else {
+        nodes[grandParent].right = sibling;
+    }
+    nodes[sibling].parent = grandParent;
+
+    for (uint32_t index = grandParent; index != none; index = nodes[index].parent) {
+        index = Balance(index);
+        Refit(index);
+    }
+}
+template<typename T>
+uint32_t BoundingVolumeTree<T>::Balance(uint32_t a) {
+    if (nodes[a].IsLeaf() || nodes[a].height < 2) { return a; }
+
+    const uint32_t b = nodes[a].left;
+    const uint32_t c = nodes[a].right;
+    const int32_t balance = nodes[c].height - nodes[b].height;
+
+    if (balance >= -1 && balance <= 1) { return a; }
+
+    /* Taller child takes place of a, a takes place of taller child's smaller child */
+    const uint32_t up = balance > 1 ? c : b;
+    const uint32_t f  = nodes[up].left;
+    const uint32_t g  = nodes[up].right;
+
+    nodes[up].left   = a;
+    nodes[up].parent = nodes[a].parent;
+    nodes[a].parent  = up;
+
+    if (nodes[up].parent == none) {
+        root = up;
+    } else if (nodes[nodes[up].parent].left == a) {
+        nodes[nodes[up].parent].left = up;
+    } else {
+        nodes[nodes[up].parent].right = up;
+    }
+
+    const uint32_t keep  = nodes[f].height > nodes[g].height ? f : g;
+    const uint32_t moved = keep == f ? g : f;
+
+    nodes[up].right     = keep;
+    nodes[moved].parent = a;
+    if (up == c) {
+        nodes[a].right = moved;
+    } else {
+        nodes[a].left  = moved;
+    }
+
+    Refit(a);
+    Refit(up);
+    return up;
+}
+template<typename T>
+void BoundingVolumeTree<T>::Refit(uint32_t node) {
+    Node& branch = nodes[node];
+    const Node& left  = nodes[branch.left];
+    const Node& right = nodes[branch.right];
+
+    branch.fatBounds = Join(left.fatBounds, right.fatBounds);
+    branch.height    = 1 + std::max(left.height, right.height);
+}
+template<typename T>
+uint32_t BoundingVolumeTree<T>::Build(uint32_t* begin, uint32_t* end, uint32_t depth) {
+    const size_t count = static_cast<size_t>(end - begin);
+    if (count == 1) { return *begin; }
+
+    Vector3 centroidMin = nodes[*begin].fatBounds.center();
+    Vector3 centroidMax = centroidMin;
+    for (uint32_t* leaf = begin + 1; leaf != end; ++leaf) {
+        const Vector3 center = nodes[*leaf].fatBounds.center();
+        centroidMin = Math::min(centroidMin, center);
+        centroidMax = Math::max(centroidMax, center);
+    }
+
+    const Vector3 extent = centroidMax - centroidMin;
+    const int axis = extent.x() >= extent.y() && extent.x() >= extent.z() ? 0 : (extent.y() >= extent.z() ? 1 : 2);
+
+    uint32_t* middle = begin;
+    if (extent[axis] > 0.0f && depth < maxSahDepth) {
+        const float scale = binCount / extent[axis];
+        auto binOf = [&](uint32_t leaf) {
+            const auto bin = static_cast<uint32_t>((nodes[leaf].fatBounds.center()[axis] - centroidMin[axis]) * scale);
+            return std::min(bin, binCount - 1);
+        };
+
+        Range3D  binBounds[binCount];
+        uint32_t binCounts[binCount] { };
+        for (uint32_t* leaf = begin; leaf != end; ++leaf) {
+            const uint32_t bin = binOf(*leaf);
+            binBounds[bin] = binCounts[bin] == 0 ? nodes[*leaf].fatBounds : Join(binBounds[bin], nodes[*leaf].fatBounds);
+            ++binCounts[bin];
+        }
+
+        /* rightCost[i] is cost of bins [i, binCount), splits are between bins i - 1 and i */
+        float    rightCost[binCount] { };
+        Range3D  accumulated;
+        uint32_t accumulatedCount = 0;
+        for (uint32_t i = binCount - 1; i > 0; --i) {
+            if (binCounts[i] != 0) {
+                accumulated = accumulatedCount == 0 ? binBounds[i] : Join(accumulated, binBounds[i]);
+                accumulatedCount += binCounts[i];
+            }
+            rightCost[i] = accumulatedCount == 0 ? 0.0f : HalfArea(accumulated) * static_cast<float>(accumulatedCount);
+        }
+
+        float    bestCost  = std::numeric_limits<float>::max();
+        uint32_t bestSplit = 0;
+        accumulatedCount = 0;
+        for (uint32_t i = 1; i < binCount; ++i) {
+            if (binCounts[i - 1] != 0) {
+                accumulated = accumulatedCount == 0 ? binBounds[i - 1] : Join(accumulated, binBounds[i - 1]);
+                accumulatedCount += binCounts[i - 1];
+            }
+            if (accumulatedCount == 0 || accumulatedCount == count) { continue; }
+
+            const float cost = HalfArea(accumulated) * static_cast<float>(accumulatedCount) + rightCost[i];
+            if (cost < bestCost) {
+                bestCost  = cost;
+                bestSplit = i;
+            }
+        }
+
+        if (bestSplit != 0) {
+            middle = std::partition(begin, end, [&](uint32_t leaf) { return binOf(leaf) < bestSplit; });
+        }
+    }
+
+    if (middle == begin || middle == end) {
+        middle = begin + count / 2;
+        std::nth_element(begin, middle, end, [&](uint32_t lhs, uint32_t rhs) {
+            return nodes[lhs].fatBounds.center()[axis] < nodes[rhs].fatBounds.center()[axis];
+        });
+    }
+
+    const uint32_t left  = Build(begin, middle, depth + 1);
+    const uint32_t right = Build(middle, end, depth + 1);
+
+    const uint32_t node = AllocateNode();
+    nodes[node].left    = left;
+    nodes[node].right   = right;
+    nodes[left].parent  = node;
+    nodes[right].parent = node;
+    Refit(node);
+    return node;
+}
+template<typename T>
+void BoundingVolumeTree<T>::AssertProxy(uint32_t proxy) const {
+    if (proxy >= nodes.size() || nodes[proxy].height != 0) {
+        Logger::Log(INTERNAL, ERR_HERE) << "Proxy " << proxy << " is not in the bounding volume tree";
+        throw std::out_of_range("Proxy " + std::to_string(proxy) + " is not in the bounding volume tree");
+    }
+}
+template<typename T>
+Range3D BoundingVolumeTree<T>::Fatten(const Range3D& bounds) const {
+    const Vector3 offset { margin, margin, margin };
+    return { bounds.min() - offset, bounds.max() + offset };
+}
+template<typename T>
+Range3D BoundingVolumeTree<T>::Join(const Range3D& a, const Range3D& b) {
+    return { Math::min(a.min(), b.min()), Math::max(a.max(), b.max()) };
+}
+template<typename T>
+float BoundingVolumeTree<T>::HalfArea(const Range3D& bounds) {
+    const Vector3 size = bounds.max() - bounds.min();
+    return size.x() * size.y() + size.y() * size.z() + size.z() * size.x();
+}
+template<typename T>
+bool BoundingVolumeTree<T>::Contains(const Range3D& outer, const Range3D& inner) {
+    for (int i = 0; i < 3; ++i) {
+        if (inner.min()[i] < outer.min()[i] || inner.max()[i] > outer.max()[i]) { return false; }
+    }
+    return true;
+}
+template<typename T>
+bool BoundingVolumeTree<T>::Overlaps(const Range3D& a, const Range3D& b) {
+    for (int i = 0; i < 3; ++i) {
+        if (a.max()[i] < b.min()[i] || b.max()[i] < a.min()[i]) { return false; }
+    }
+    return true;
+}
+template<typename T>
+float BoundingVolumeTree<T>::DistanceSquared(const Range3D& bounds, const Vector3& point) {
+    float distance = 0.0f;
+    for (int i = 0; i < 3; ++i) {
+        const float below = bounds.min()[i] - point[i];
+        const float above = point[i] - bounds.max()[i];
+        if (below > 0.0f) {
+            distance += below * below;
+        } else if (above > 0.0f) {
+            distance += above * above;
+        }
+    }
+    return distance;
+}
+template<typename T>
+bool BoundingVolumeTree<T>::RayHits(const Range3D& bounds, const Vector3& origin, const Vector3& direction,
+                                    const Vector3& inverseDirection, float maxDistance) {
+    float first = 0.0f;
+    float last  = maxDistance;
+    for (int i = 0; i < 3; ++i) {
+        /* Ray parallel to the slab hits it only if it starts inside */
+        if (direction[i] == 0.0f) {
+            if (origin[i] < bounds.min()[i] || origin[i] > bounds.max()[i]) { return false; }
+            continue;
+        }
+
+        float enter = (bounds.min()[i] - origin[i]) * inverseDirection[i];
+        float exit  = (bounds.max()[i] - origin[i]) * inverseDirection[i];
+        if (enter > exit) { std::swap(enter, exit); }
+
+        first = std::max(first, enter);
+        last  = std::min(last, exit);
+        if (first > last) { return false; }
+    }
+    return true;
+}
+template<typename T>
+bool BoundingVolumeTree<T>::FrustumHits(const Frustum& frustum, const Range3D& bounds, uint32_t& mask) {
+    for (uint32_t i = 0; i < 6; ++i) {
+        if ((mask & (1u << i)) == 0) { continue; }
+
+        const Vector4 plane = frustum[i];
+
+        /* Corner furthest along the plane normal decides if bounds are outside, the nearest one if inside */
+        const Vector3 outer {
+            plane.x() >= 0.0f ? bounds.max().x() : bounds.min().x(),
+            plane.y() >= 0.0f ? bounds.max().y() : bounds.min().y(),
+            plane.z() >= 0.0f ? bounds.max().z() : bounds.min().z()
+        };
+        if (Math::dot(plane.xyz(), outer) + plane.w() < 0.0f) { return false; }
+
+        const Vector3 inner {
+            plane.x() >= 0.0f ? bounds.min().x() : bounds.max().x(),
+            plane.y() >= 0.0f ? bounds.min().y() : bounds.max().y(),
+            plane.z() >= 0.0f ? bounds.min().z() : bounds.max().z()
+        };
+        if (Math::dot(plane.xyz(), inner) + plane.w() >= 0.0f) { mask &= ~(1u << i); }
+    }
+    return true;
+}
+
+} // namespace core
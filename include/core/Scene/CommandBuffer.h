@@ -0,0 +1,164 @@
+/**
+ *  Check CommandBuffer.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_COMMANDBUFFER_H
+#define CORE_COMMANDBUFFER_H
+
+#include "core/Essentials.h"
+#include "core/Entity.h"
+
+#include <functional>
+#include <mutex>
+
+namespace core {
+
+/**
+ * Entity spawned by a CommandBuffer, which does not exist until the buffer is played back
+ * @note Only valid within the buffer it was returned from, until next playback
+ */
+struct DeferredEntity {
+    uint32_t index;
+};
+
+/**
+ * Records structural changes of entities and applies them later, in one batch
+ * @details Every thread records into its own buffer, so systems running in parallel
+ * can spawn and destroy entities. Buffers are played back by SceneModule once per frame,
+ * after LateTick, when nothing else iterates entities or components
+ */
+class CommandBuffer {
+public:
+
+    /**
+     * Get command buffer of the calling thread
+     */
+    static CommandBuffer& Get();
+
+    /**
+     * Plays back buffers of all threads, in order of their creation
+     * @details Every buffer is played back even if one throws, the first exception is rethrown afterwards
+     * @note Must be called when no other thread touches entities
+     */
+    static void PlaybackAll();
+
+    /**
+     * Records creation of new engine-owned Entity
+     * @param parent - Parent of the entity, root of the "Default" scene if empty
+     * @param layer - Name of the layer to link entity with
+     * @return Placeholder for the entity, to be used with other commands of this buffer
+     * @note Command is skipped if parent is destroyed by the time of playback
+     */
+    DeferredEntity Spawn(const string& name = "Entity", EntityHandle parent = { }, const string& layer = "Default");
+
+    /**
+     * Records creation of new engine-owned Entity under an entity spawned by this buffer
+     * @note Command is skipped if parent is skipped or destroyed by the time of playback
+     */
+    DeferredEntity Spawn(const string& name, DeferredEntity parent, const string& layer = "Default");
+
+    /**
+     * Records creation of component T, arguments are copied
+     * @note Command is skipped if entity is destroyed by the time of playback
+     */
+    template<typename T, typename ...Args>
+    void AddComponent(EntityHandle entity, Args... args);
+
+    /**
+     * Records creation of component T on an entity spawned by this buffer, arguments are copied
+     */
+    template<typename T, typename ...Args>
+    void AddComponent(DeferredEntity entity, Args... args);
+
+    /**
+     * Records Entity::Destroy call
+     */
+    void Destroy(EntityHandle entity);
+
+    /**
+     * Records Entity::Destroy call on an entity spawned by this buffer
+     */
+    void Destroy(DeferredEntity entity);
+
+    /**
+     * Records Entity::SetLayer call
+     */
+    void SetLayer(EntityHandle entity, const string& layer);
+
+    /**
+     * Records Entity::SetLayer call on an entity spawned by this buffer
+     */
+    void SetLayer(DeferredEntity entity, const string& layer);
+
+    /**
+     * Applies and clears recorded commands
+     * @details Commands recorded before the call are always consumed: if one of them throws,
+     * the rest are still applied and the first exception is rethrown afterwards
+     */
+    void Playback();
+
+    /**
+     * @return Is there nothing to play back?
+     */
+    bool IsEmpty();
+
+protected:
+
+    CommandBuffer() = default;
+
+    using Command = std::function<void(CommandBuffer&)>;
+
+    /**
+     * Appends command to the buffer
+     */
+    void Record(Command command);
+
+    /**
+     * @return Entity spawned by this buffer during current playback, nullptr if it was destroyed already
+     */
+    Entity* Resolve(DeferredEntity entity) const;
+
+    /** Recorded commands, in order */
+    vector<Command>      commands  { };
+
+    /** Entities spawned in current playback, indexed by DeferredEntity::index, invalid if spawn was skipped */
+    vector<EntityHandle> spawned   { };
+
+    /** Number of Spawn commands recorded since last playback */
+    uint32_t             spawnCount { 0 };
+
+    std::mutex           mutex;
+
+    /** Buffers of all threads */
+    static vector<unique<CommandBuffer>> buffers;
+    static std::mutex                    buffersMutex;
+
+};
+
+} // namespace core
+
+#include "CommandBuffer.tpp"
+
+#endif //CORE_COMMANDBUFFER_H
@@ -0,0 +1,135 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_OCCLUSIONBUFFER_H
+#define CORE_OCCLUSIONBUFFER_H
+
+#include "core/Essentials.h"
+#include "core/Math.h"
+
+namespace core {
+
+/**
+ * Low resolution depth buffer for CPU occlusion culling
+ * @details Each frame occluders are added with Begin() and AddOccluder(), rasterized into the buffer
+ * with Rasterize() and then bounds of other objects are tested against it. An object is hidden
+ * if every pixel its projected bounds cover is nearer than the nearest point of the bounds.
+ * Rasterization splits the buffer into bands of rows, tests split the objects, both run on the JobSystem.
+ * Depth is NDC z, smaller is nearer
+ * @note Occluder geometry has to lie inside of the drawn geometry, otherwise visible objects can be culled.
+ * Occluder triangles crossing the near plane are skipped, objects crossing it are always visible
+ */
+class OcclusionBuffer {
+public:
+    /**
+     * @param width - Width in pixels, rounded up to a multiple of 4
+     */
+    explicit OcclusionBuffer(JobSystem& jobSystem, uint32_t width = 256, uint32_t height = 128);
+
+    /**
+     * Removes occluders of the previous frame
+     * @param viewProjection - Matrix transforming world space into clip space
+     */
+    void Begin(const Matrix4& viewProjection);
+
+    /**
+     * Adds box as an occluder
+     * @param transform - Matrix transforming box into world space
+     */
+    void AddOccluder(const Matrix4& transform, const Range3D& box);
+
+    /**
+     * Adds indexed triangles as an occluder
+     * @param transform - Matrix transforming vertices into world space
+     */
+    void AddOccluder(const Matrix4& transform, const Vector3* vertices, const uint32_t* indices, size_t indexCount);
+
+    /**
+     * Clears the buffer and rasterizes all added occluders
+     */
+    void Rasterize();
+
+    /**
+     * Is any part of world space bounds not hidden by occluders?
+     * @note Expects Rasterize() to be called after the last AddOccluder()
+     */
+    bool IsVisible(const Range3D& bounds) const;
+
+    /**
+     * Tests many bounds, visible[i] is 1 if bounds[i] is visible, 0 otherwise
+     * @return Number of visible bounds
+     */
+    size_t TestVisibility(const Range3D* bounds, uint8_t* visible, size_t count) const;
+
+    /**
+     * @return Number of occluder triangles added since Begin()
+     */
+    size_t GetTriangleCount() const;
+
+    uint32_t     GetWidth() const;
+    uint32_t     GetHeight() const;
+
+    /**
+     * Get depth of every pixel, row by row from the bottom of the screen
+     */
+    const float* GetDepth() const;
+
+private:
+
+    /** Triangle projected to pixel coordinates */
+    struct Triangle {
+        float x[3];
+        float y[3];
+        float z[3];
+    };
+
+    /**
+     * Projects triangle and adds it, unless it is degenerate or crosses the near plane
+     */
+    void AddTriangle(const Vector4& a, const Vector4& b, const Vector4& c);
+
+    /**
+     * Rasterizes triangle into rows [rowBegin, rowEnd)
+     */
+    void RasterizeTriangle(const Triangle& triangle, uint32_t rowBegin, uint32_t rowEnd);
+
+    /** Rows rasterized by a single job */
+    static constexpr uint32_t bandHeight = 16;
+
+    /** Bounds tested by a single job */
+    static constexpr size_t   testGrainSize = 256;
+
+    JobSystem&       jobSystem;
+
+    uint32_t         width;
+    uint32_t         height;
+
+    Matrix4          viewProjection { };
+
+    vector<float>    depth;
+    vector<Triangle> triangles;
+};
+
+} // namespace core
+
+#endif //CORE_OCCLUSIONBUFFER_H
@@ -32,13 +32,17 @@
 #include <Magnum/GL/Renderer.h>
 #include <Magnum/GL/Texture.h>
 #include <Magnum/GL/TextureFormat.h>
+#include <Magnum/Trade/ImageData.h>
+#include <Magnum/Trade/MeshData.h>
 #include <Magnum/Trade/PhongMaterialData.h>
 #include <Magnum/Trade/SceneData.h>
+#include <Magnum/Trade/TextureData.h>
 
 #include <core/Logger.h>
 #include <core/Scene/Scene.h>
 #include <core/Entity.h>
 #include <core/Material.h>
+#include <core/Math.h>
 
 #include <optional>
 
@@ -82,12 +86,44 @@ public:
     
     /** Scene meshes */
     vector<optional<GL::Mesh>>            meshes;
+
+    /** Bounds of scene meshes, in model space */
+    vector<Range3D>                       meshBounds;
+
+    /** Enclosing sphere radii of scene meshes, negative if unknown */
+    vector<float>                         meshRadii;
     
     /** Scene object names */
     vector<string>                        names;
+
+    /** Path of the imported file */
+    string                                path;
+
+    /** Message of SceneImporter::Read, logged by SceneImporter::Upload */
+    struct Message {
+        LogLevel level;
+        LogPlace place;
+        string   text;
+    };
+
+    /** Messages not yet logged */
+    vector<Message>                       messages;
+
+    /** Texture descriptions read from file, cleared on upload */
+    vector<optional<Trade::TextureData>>  textureData;
+
+    /** Texture images read from file, indexed like textureData, cleared on upload */
+    vector<optional<Trade::ImageData2D>>  imageData;
+
+    /** Meshes read from file, cleared on upload */
+    vector<optional<Trade::MeshData>>     meshData;
+
+    /** Whether textures and meshes were created by SceneImporter::Upload */
+    bool                                  uploaded { false };
     
 
 protected:
+    friend class SceneSnapshot;
     
     /**
      * Add entity and its children to container
@@ -0,0 +1,154 @@
+/**
+ *  Check SceneHierarchy.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_SCENEHIERARCHY_H
+#define CORE_SCENEHIERARCHY_H
+
+#include "core/Essentials.h"
+#include "core/Handle.h"
+
+#include <atomic>
+
+namespace core {
+
+/**
+ * Flat storage of the Scene Graph of objects of type T
+ * @details Links are kept in parallel arrays indexed by node (parent, first child, next sibling, depth),
+ * while nodes themselves are kept in pre-order, so parents always come before their children
+ * and every subtree occupies a contiguous range. Walking the whole hierarchy is a linear scan.
+ * Reparenting moves a single contiguous range, destroyed nodes leave gaps which are compacted lazily
+ */
+template<typename T>
+class SceneHierarchy {
+public:
+    static constexpr uint32_t none = Handle<T>::invalidIndex;
+
+    /**
+     * Adds node as a new root at the end of the hierarchy
+     * @param node - index of the node, unique among alive objects
+     */
+    static void Insert(uint32_t node, T* object);
+
+    /**
+     * Removes node from the hierarchy
+     * @note Node is expected to have no children left
+     */
+    static void Remove(uint32_t node);
+
+    /**
+     * Moves node together with its subtree under a new parent
+     * @details Cost is linear in the distance the subtree is moved by
+     * @param parent - new parent node, SceneHierarchy::none makes node a root
+     * @throw std::logic_error if parent is inside of the node's subtree
+     */
+    static void SetParent(uint32_t node, uint32_t parent);
+
+    static uint32_t GetParent(uint32_t node);
+    static uint32_t GetFirstChild(uint32_t node);
+    static uint32_t GetNextSibling(uint32_t node);
+    static uint32_t GetDepth(uint32_t node);
+
+    /**
+     * Get index of node in hierarchy order
+     * @note Changes whenever hierarchy is reparented or compacted
+     */
+    static uint32_t GetPosition(uint32_t node);
+
+    /**
+     * Get number of entries node's subtree spans in hierarchy order, node included
+     * @note Destroyed descendants may still be accounted until compaction
+     */
+    static uint32_t GetSubtreeSize(uint32_t node);
+    static T*       GetObject(uint32_t node);
+
+    /**
+     * Calls function on every object of the hierarchy, parents are visited before their children
+     * @tparam F - callable with signature void(T&)
+     * @note Hierarchy is not allowed to be reparented while walking
+     */
+    template<typename F>
+    static void Each(F&& function);
+
+    /**
+     * Calls function on node and all of its descendants, parents are visited before their children
+     * @tparam F - callable with signature void(T&)
+     * @note Disjoint subtrees can be walked concurrently
+     */
+    template<typename F>
+    static void EachInSubtree(uint32_t node, F&& function);
+
+    /**
+     * Makes sure count more nodes can be inserted without allocating
+     */
+    static void Reserve(size_t count);
+
+private:
+
+    struct Storage {
+        /** Per node links, indexed by node */
+        vector<uint32_t> parent;
+        vector<uint32_t> firstChild;
+        vector<uint32_t> lastChild;
+        vector<uint32_t> nextSibling;
+        vector<uint32_t> previousSibling;
+        vector<uint32_t> depth;
+
+        /** Number of entries the node's subtree occupies in order, including gaps */
+        vector<uint32_t> subtreeSize;
+
+        /** Index of the node in order */
+        vector<uint32_t> position;
+
+        vector<T*>       objects;
+
+        /** Nodes in pre-order, removed nodes are left as gaps */
+        vector<uint32_t> order;
+
+        size_t gaps      { 0 };
+        std::atomic<size_t> iterating { 0 };
+    };
+
+    /**
+     * Hierarchy storage
+     * @note Intentionally never destroyed, same as Referable slots
+     */
+    static Storage& Data();
+
+    /** Removes node from the children list of its parent */
+    static void UnlinkSibling(Storage& data, uint32_t node);
+
+    /** Adds delta to subtree size of node and all of its ancestors */
+    static void GrowAncestors(Storage& data, uint32_t node, int64_t delta);
+
+    /** Removes gaps from order and recomputes subtree sizes */
+    static void Compact(Storage& data);
+};
+
+} // namespace core
+
+#include "SceneHierarchy.tpp"
+
+#endif //CORE_SCENEHIERARCHY_H
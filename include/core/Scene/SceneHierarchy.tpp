@@ -0,0 +1,258 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_SCENEHIERARCHY_TPP
+#define CORE_SCENEHIERARCHY_TPP
+
+#include "SceneHierarchy.h"
+#include "core/Logger.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace core {
+
+template<typename T>
+typename SceneHierarchy<T>::Storage& SceneHierarchy<T>::Data() {
+    static auto* data = new Storage();
+    return *data;
+}
+template<typename T>
+void SceneHierarchy<T>::Insert(uint32_t node, T* object) {
+    Storage& data = Data();
+
+    if (node >= data.objects.size()) {
+        const size_t size = static_cast<size_t>(node) + 1;
+        data.parent.resize(size, none);
+        data.firstChild.resize(size, none);
+        data.lastChild.resize(size, none);
+        data.nextSibling.resize(size, none);
+        data.previousSibling.resize(size, none);
+        data.depth.resize(size, 0);
+        data.subtreeSize.resize(size, 0);
+        data.position.resize(size, none);
+        data.objects.resize(size, nullptr);
+    }
+
+    data.parent[node]          = none;
+    data.firstChild[node]      = none;
+    data.lastChild[node]       = none;
+    data.nextSibling[node]     = none;
+    data.previousSibling[node] = none;
+    data.depth[node]           = 0;
+    data.subtreeSize[node]     = 1;
+    data.position[node]        = static_cast<uint32_t>(data.order.size());
+    data.objects[node]         = object;
+
+    data.order.push_back(node);
+}
+template<typename T>
+void SceneHierarchy<T>::Remove(uint32_t node) {
+    Storage& data = Data();
+
+    /* Node stays accounted in subtree sizes of its ancestors as a gap, until the next compaction */
+    UnlinkSibling(data, node);
+    data.order[data.position[node]] = none;
+    data.position[node] = none;
+    data.objects[node]  = nullptr;
+    data.parent[node]   = none;
+
+    if (++data.gaps > 64 && data.gaps * 2 > data.order.size() && data.iterating == 0) {
+        Compact(data);
+    }
+}
+template<typename T>
+void SceneHierarchy<T>::SetParent(uint32_t node, uint32_t parent) {
+    Storage& data = Data();
+    if (data.parent[node] == parent) { return; }
+
+    const uint32_t from  = data.position[node];
+    const uint32_t count = data.subtreeSize[node];
+
+    uint32_t target = static_cast<uint32_t>(data.order.size());
+    if (parent != none) {
+        const uint32_t parentPosition = data.position[parent];
+        if (parentPosition >= from && parentPosition < from + count) {
+            Logger::Log(SCENE, ERR_HERE) << "Cannot parent " << data.objects[node]->GetInfo() << " to its own descendant";
+            throw std::logic_error("Cannot parent object to its own descendant");
+        }
+        target = parentPosition + data.subtreeSize[parent];
+    }
+
+    UnlinkSibling(data, node);
+    GrowAncestors(data, data.parent[node], -static_cast<int64_t>(count));
+
+    /* Move the subtree range right behind the last descendant of new parent */
+    uint32_t begin, end, moved;
+    if (target > from) {
+        std::rotate(data.order.begin() + from, data.order.begin() + from + count, data.order.begin() + target);
+        begin = from;
+        end   = target;
+        moved = target - count;
+    } else {
+        std::rotate(data.order.begin() + target, data.order.begin() + from, data.order.begin() + from + count);
+        begin = target;
+        end   = from + count;
+        moved = target;
+    }
+    for (uint32_t i = begin; i < end; ++i) {
+        if (data.order[i] != none) { data.position[data.order[i]] = i; }
+    }
+
+    data.parent[node] = parent;
+    if (parent != none) {
+        data.previousSibling[node] = data.lastChild[parent];
+        if (data.lastChild[parent] != none) {
+            data.nextSibling[data.lastChild[parent]] = node;
+        } else {
+            data.firstChild[parent] = node;
+        }
+        data.lastChild[parent] = node;
+    }
+    GrowAncestors(data, parent, count);
+
+    const uint32_t depth = parent != none ? data.depth[parent] + 1 : 0;
+    const int64_t  delta = static_cast<int64_t>(depth) - data.depth[node];
+    if (delta != 0) {
+        for (uint32_t i = moved; i < moved + count; ++i) {
+            const uint32_t descendant = data.order[i];
+            if (descendant != none) { data.depth[descendant] = static_cast<uint32_t>(data.depth[descendant] + delta); }
+        }
+    }
+}
+template<typename T>
+uint32_t SceneHierarchy<T>::GetParent(uint32_t node) {
+    return Data().parent[node];
+}
+template<typename T>
+uint32_t SceneHierarchy<T>::GetFirstChild(uint32_t node) {
+    return Data().firstChild[node];
+}
+template<typename T>
+uint32_t SceneHierarchy<T>::GetNextSibling(uint32_t node) {
+    return Data().nextSibling[node];
+}
+template<typename T>
+uint32_t SceneHierarchy<T>::GetDepth(uint32_t node) {
+    return Data().depth[node];
+}
+template<typename T>
+uint32_t SceneHierarchy<T>::GetPosition(uint32_t node) {
+    return Data().position[node];
+}
+template<typename T>
+uint32_t SceneHierarchy<T>::GetSubtreeSize(uint32_t node) {
+    return Data().subtreeSize[node];
+}
+template<typename T>
+T* SceneHierarchy<T>::GetObject(uint32_t node) {
+    return node != none ? Data().objects[node] : nullptr;
+}
+template<typename T>
+template<typename F>
+void SceneHierarchy<T>::Each(F&& function) {
+    Storage& data = Data();
+
+    ++data.iterating;
+    for (size_t i = 0; i < data.order.size(); ++i) {
+        if (data.order[i] != none) { function(*data.objects[data.order[i]]); }
+    }
+    --data.iterating;
+}
+template<typename T>
+template<typename F>
+void SceneHierarchy<T>::EachInSubtree(uint32_t node, F&& function) {
+    Storage& data = Data();
+
+    ++data.iterating;
+    const size_t begin = data.position[node];
+    const size_t end   = begin + data.subtreeSize[node];
+    for (size_t i = begin; i < end; ++i) {
+        if (data.order[i] != none) { function(*data.objects[data.order[i]]); }
+    }
+    --data.iterating;
+}
+template<typename T>
+void SceneHierarchy<T>::Reserve(size_t count) {
+    Storage& data = Data();
+
+    const size_t nodes = data.objects.size() + count;
+    data.parent.reserve(nodes);
+    data.firstChild.reserve(nodes);
+    data.lastChild.reserve(nodes);
+    data.nextSibling.reserve(nodes);
+    data.previousSibling.reserve(nodes);
+    data.depth.reserve(nodes);
+    data.subtreeSize.reserve(nodes);
+    data.position.reserve(nodes);
+    data.objects.reserve(nodes);
+    data.order.reserve(data.order.size() + count);
+}
+template<typename T>
+void SceneHierarchy<T>::UnlinkSibling(Storage& data, uint32_t node) {
+    const uint32_t parent   = data.parent[node];
+    const uint32_t previous = data.previousSibling[node];
+    const uint32_t next     = data.nextSibling[node];
+
+    if (previous != none) {
+        data.nextSibling[previous] = next;
+    } else if (parent != none) {
+        data.firstChild[parent] = next;
+    }
+    if (next != none) {
+        data.previousSibling[next] = previous;
+    } else if (parent != none) {
+        data.lastChild[parent] = previous;
+    }
+
+    data.previousSibling[node] = none;
+    data.nextSibling[node]     = none;
+}
+template<typename T>
+void SceneHierarchy<T>::GrowAncestors(Storage& data, uint32_t node, int64_t delta) {
+    for (; node != none; node = data.parent[node]) {
+        data.subtreeSize[node] = static_cast<uint32_t>(data.subtreeSize[node] + delta);
+    }
+}
+template<typename T>
+void SceneHierarchy<T>::Compact(Storage& data) {
+    data.order.erase(std::remove(data.order.begin(), data.order.end(), none), data.order.end());
+    data.gaps = 0;
+
+    for (uint32_t i = 0; i < data.order.size(); ++i) {
+        data.position[data.order[i]]    = i;
+        data.subtreeSize[data.order[i]] = 1;
+    }
+
+    /* Children come after parents, so walking backwards accumulates complete subtrees */
+    for (size_t i = data.order.size(); i-- > 0;) {
+        const uint32_t node = data.order[i];
+        if (data.parent[node] != none) {
+            data.subtreeSize[data.parent[node]] += data.subtreeSize[node];
+        }
+    }
+}
+
+}
+
+#endif //CORE_SCENEHIERARCHY_TPP
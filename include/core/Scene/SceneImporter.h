@@ -40,10 +40,29 @@ public:
 
     /**
      * Imports and returns pointer to core::SceneData
+     * @details Same as SceneImporter::Read followed by SceneImporter::Upload
+     * @note Has to be called on the main thread
      * @param filepath - path to scene file
      * @return core::SceneData* data
      */
     shared<SceneData> Import(const string& filepath);
+
+    /**
+     * Reads scene file into core::SceneData without creating GPU resources
+     * @details Texture images and meshes are kept in SceneData until SceneImporter::Upload,
+     * messages are kept in SceneData::messages instead of being logged,
+     * so reading touches no engine state and is safe to call from any thread
+     * @param filepath - path to scene file
+     * @throws std::logic_error if failed to initialize the importer
+     * @throws std::runtime_error if fails to open file or to load its scene
+     */
+    shared<SceneData> Read(const string& filepath);
+
+    /**
+     * Creates textures and meshes of data read with SceneImporter::Read and logs its messages
+     * @note Has to be called on the main thread, does nothing if data is already uploaded
+     */
+    static void Upload(SceneData& data);
     
 protected:
     
@@ -87,14 +106,14 @@ protected:
     void ImportMaterials(SceneData& data);
     
     /**
-     * Add Texture data to SceneData
+     * Add Texture images to SceneData, textures are created by SceneImporter::Upload
      * @note expects that importer is initialized
      * @see SceneImporter::Import
      */
     void ImportTextures(SceneData& data);
     
     /**
-     * Add Mesh data to SceneData
+     * Add Mesh data and bounds to SceneData, meshes are compiled by SceneImporter::Upload
      * @note expects that importer is initialized
      * @see SceneImporter::Import
      */
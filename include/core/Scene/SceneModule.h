@@ -25,13 +25,18 @@
 #define CORE_SCENEMODULE_H
 
 #include "core/IModule.h"
+#include "core/Core.h"
 #include "core/Entity.h"
 #include "core/CameraList.h"
+#include "core/Scene/SystemScheduler.h"
+#include "core/Scene/TransformSystem.h"
 
 namespace core {
 
 /**
- * Passes all core::ITicker calls to every active entity,
+ * Passes all core::ITicker calls to every component storage, then to systems,
+ * Recomputes invalidated transforms before cameras draw,
+ * Plays back command buffers after LateTick,
  * Manages cameras list
  *
  * @dependencies None
@@ -41,6 +46,16 @@ class SceneModule : public IModule {
 public:
     SceneModule();
 
+    /**
+     * Creates new system, run every phase after the components
+     * @tparam T - System typename, must inherit from core::ISystem
+     * @return Reference to created system
+     */
+    template<typename T, typename ...Args>
+    T& AddSystem(Args&&... args) {
+        return scheduler.Add<T>(std::forward<Args>(args)...);
+    }
+
 protected:
 
     void Start() override;
@@ -51,6 +66,9 @@ protected:
     void Stop() override;
 
     CameraList cameraList { };
+
+    SystemScheduler scheduler { Core::GetJobSystem() };
+    TransformSystem transforms { Core::GetJobSystem() };
     
     shared<Scene> defaultScene;
     
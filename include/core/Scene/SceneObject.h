@@ -28,47 +28,55 @@
 #define CORE_SCENEOBJECT_H
 
 #include "core/Essentials.h"
+#include "core/Handle.h"
+#include "SceneHierarchy.h"
 
 namespace core {
 
 /**
  * Manages Scene Graph parent/child relationships
+ * @details Relations are stored in flat SceneHierarchy<T> arrays, indexed by handle slot,
+ * T is expected to be Referable<T>. Object joins the hierarchy on its first SetParent call
  */
 template<typename T>
 class SceneObject {
 public:
-    SceneObject(shared<T> parent);
+    SceneObject() = default;
     virtual ~SceneObject();
     
     /**
-     * Get shared ptr to parent
-     * @return shared ptr to parent if exists, nullptr otherwise
+     * Get pointer to parent
+     * @return pointer to parent if exists, nullptr otherwise
      */
-    shared<T> GetParent();
+    T* GetParent();
     
     /**
-     * Get reference to all children array
+     * Get handles to all children, in order of parenting
      */
-    vector<shared<T>>& GetChildren();
+    vector<Handle<T>> GetChildren() const;
+
+    /**
+     * Get number of ancestors of this object
+     */
+    uint32_t GetDepth() const;
     
     /**
      * Sets object as current parent
+     * @details Removes this object from children of previous parent
+     * @param newParent - new parent, invalid handle detaches object from its parent
      */
-    void SetParent(shared<T> newParent);
+    void SetParent(Handle<T> newParent);
     
     /**
-     * Recursively derstroy all children
-     * @details calls shared<T>::reset on every child object
+     * Recursively destroy all children
+     * @details calls T::Destroy(Handle<T>) on every child object
      */
     void DestroyChildren();
 
-protected:
-    
-    /** Pointer to current parent */
-    weak<T> parent;
-    
-    /** Vector of all children of this object */
-    vector<shared<T>> children;
+private:
+
+    /** Node of this object in SceneHierarchy<T> */
+    uint32_t node { SceneHierarchy<T>::none };
 
 };
 
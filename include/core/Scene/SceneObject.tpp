@@ -28,33 +28,50 @@
 
 namespace core {
 
-template<typename T>
-SceneObject<T>::SceneObject(shared<T> parent)
-: parent(parent)
-{
-
-}
 template<typename T>
 SceneObject<T>::~SceneObject() {
-
+    if (node != SceneHierarchy<T>::none) {
+        SceneHierarchy<T>::Remove(node);
+    }
 }
 template<typename T>
-shared<T> SceneObject<T>::GetParent() {
-    return !parent.expired() ? parent.lock() : nullptr;
+T* SceneObject<T>::GetParent() {
+    if (node == SceneHierarchy<T>::none) { return nullptr; }
+    return SceneHierarchy<T>::GetObject(SceneHierarchy<T>::GetParent(node));
 }
 template<typename T>
-vector<shared<T>>& SceneObject<T>::GetChildren() {
+vector<Handle<T>> SceneObject<T>::GetChildren() const {
+    vector<Handle<T>> children;
+    if (node == SceneHierarchy<T>::none) { return children; }
+
+    for (uint32_t child = SceneHierarchy<T>::GetFirstChild(node);
+         child != SceneHierarchy<T>::none;
+         child = SceneHierarchy<T>::GetNextSibling(child)) {
+        children.push_back(SceneHierarchy<T>::GetObject(child)->GetHandle());
+    }
     return children;
 }
 template<typename T>
-void SceneObject<T>::SetParent(shared<T> newParent) {
-    parent = newParent;
+uint32_t SceneObject<T>::GetDepth() const {
+    return node != SceneHierarchy<T>::none ? SceneHierarchy<T>::GetDepth(node) : 0;
+}
+template<typename T>
+void SceneObject<T>::SetParent(Handle<T> newParent) {
+    if (node == SceneHierarchy<T>::none) {
+        T* self = static_cast<T*>(this);
+        node = self->GetHandle().index;
+        SceneHierarchy<T>::Insert(node, self);
+    }
+
+    T* parent = newParent.Get();
+    SceneHierarchy<T>::SetParent(node, parent ? parent->GetHandle().index : SceneHierarchy<T>::none);
 }
 template<typename T>
 void SceneObject<T>::DestroyChildren() {
-    for (auto& child : children) {
-        child->DestroyChildren();
-        child.reset();
+    /* Destroying a child detaches it from this object, so iterate over a copy */
+    vector<Handle<T>> destroyed = GetChildren();
+    for (Handle<T>& child : destroyed) {
+        T::Destroy(child);
     }
 }
 
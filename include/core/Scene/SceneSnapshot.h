@@ -0,0 +1,180 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_SCENESNAPSHOT_H
+#define CORE_SCENESNAPSHOT_H
+
+#include "core/Essentials.h"
+#include "core/Handle.h"
+#include "core/Math.h"
+
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace core {
+
+/**
+ * Saves entity hierarchies into binary snapshot files and instantiates them back
+ * @details Snapshot is a header followed by a table of sections, every section is a flat array of records,
+ * referenced by offset from the start of the file, so the file is used in place after being memory-mapped.
+ * Sections: string table, entities in hierarchy order (parents before children),
+ * Transform data, Renderer asset references and asset paths.
+ * Numbers are stored in byte order of the machine which saved the snapshot, header records it
+ * and snapshots of the other byte order are rejected on load, as are other format versions
+ * @note Only Transform and Renderer components are persisted, other components have to be re-added by the game
+ */
+class SceneSnapshot {
+public:
+
+    /** Version written into saved snapshots, loading any other version fails */
+    static constexpr uint32_t version = 2;
+
+    /**
+     * Saves all descendants of root, root itself is not saved
+     * @throw std::logic_error if root is not a valid entity
+     * @throw std::runtime_error if file cannot be written
+     */
+    static void Save(const string& path, EntityHandle root);
+
+    /**
+     * Validated snapshot, records are read in place from the mapped file
+     * @details File stays mapped as long as any copy of Decoded exists
+     */
+    struct Decoded {
+        /** Text in the string table */
+        struct StringRef {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        struct EntityRecord {
+            /** Index of parent record, Handle<Entity>::invalidIndex for top-level entities */
+            uint32_t  parent;
+            StringRef name;
+            StringRef layer;
+        };
+
+        struct TransformRecord {
+            uint32_t entity;
+            float    position[3];
+            float    rotation[4];
+            float    scale[3];
+        };
+
+        struct RendererRecord {
+            uint32_t entity;
+            uint32_t asset;
+            uint32_t object;
+        };
+
+        struct AssetRecord {
+            StringRef path;
+        };
+
+        /** Records of one section */
+        template<typename T>
+        struct Records {
+            const T* data { nullptr };
+            size_t   size { 0 };
+
+            const T& operator[](size_t i) const { return data[i]; }
+        };
+
+        /**
+         * @return Text referenced by ref, bounds are checked by Decode
+         */
+        string String(StringRef ref) const;
+
+        shared<const MappedFile> file;
+        Records<char>            strings;
+        Records<EntityRecord>    entities;
+        Records<TransformRecord> transforms;
+        Records<RendererRecord>  renderers;
+        Records<AssetRecord>     assets;
+
+        /** Assets read by SceneSnapshot::ReadAssets, indexed like assets, null where not read */
+        vector<shared<SceneData>> readAssets;
+    };
+
+    /**
+     * State of an instantiation split over several calls
+     */
+    struct Progress {
+        size_t entities   { 0 };
+        size_t transforms { 0 };
+        size_t renderers  { 0 };
+
+        /** Spawned entities, in order of Decoded::entities records */
+        vector<EntityHandle> handles;
+
+        /** Spawned top-level entities */
+        vector<EntityHandle> roots;
+    };
+
+    /**
+     * Maps and validates snapshot, every record index and string reference is checked
+     * @details Touches no engine state, safe to call from any thread
+     * @throw std::runtime_error if file cannot be mapped or is not a valid snapshot of this version
+     */
+    static Decoded Decode(const string& path);
+
+    /**
+     * Reads assets referenced by decoded Renderers, which are not yet imported by this SceneSnapshot
+     * @details Only CPU side of the assets is read, GPU resources are created by Instantiate.
+     * Touches no engine state, safe to call from any thread. Importers of all snapshots are created
+     * and used one at a time under a process-wide lock, since Corrade plugin loading is not known
+     * to be thread-safe, so concurrent calls only overlap in decoding
+     * @throw std::runtime_error if an asset cannot be read
+     */
+    void ReadAssets(Decoded& decoded);
+
+    /**
+     * Spawns decoded entities under parent and adds their components, until everything is spawned or deadline passes
+     * @details Assets referenced by Renderers are imported once per path and kept by this SceneSnapshot,
+     * so it has to outlive the loaded entities. Assets read by ReadAssets are only uploaded here
+     * @note Has to be called on the main thread, call again with the same progress to continue
+     * @return true once everything is instantiated
+     */
+    bool Instantiate(const Decoded& decoded, Progress& progress, EntityHandle parent,
+                     std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::time_point::max());
+
+    /**
+     * Decodes snapshot and instantiates all of it under parent at once
+     * @return Handles to the top-level loaded entities
+     * @throw std::runtime_error if file cannot be mapped or is not a valid snapshot of this version
+     */
+    vector<EntityHandle> Load(const string& path, EntityHandle parent);
+
+private:
+
+    /** Imported assets by path, they own GPU data of loaded Models */
+    std::unordered_map<string, shared<SceneData>> assets;
+
+    /** Guards assets, ReadAssets checks them from job threads */
+    std::mutex assetsMutex;
+};
+
+} // namespace core
+
+#endif //CORE_SCENESNAPSHOT_H
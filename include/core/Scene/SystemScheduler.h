@@ -0,0 +1,114 @@
+/**
+ *  Check SystemScheduler.tpp for template definitions
+ */
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_SYSTEMSCHEDULER_H
+#define CORE_SYSTEMSCHEDULER_H
+
+#include "core/Essentials.h"
+#include "core/ISystem.h"
+#include "core/JobSystem.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+namespace core {
+
+/**
+ * Runs systems as jobs of the JobSystem
+ * @details On every run, a dependency graph is built from declared component access:
+ * of two conflicting systems, the one added first runs first. Systems that do not conflict
+ * run concurrently, calling thread helps the workers until every system is done.
+ */
+class SystemScheduler {
+public:
+    explicit SystemScheduler(JobSystem& jobSystem);
+
+    /** Copying is not allowed */
+    SystemScheduler(const SystemScheduler&) = delete;
+
+    /** Copying is not allowed */
+    SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+    /**
+     * Creates new system of type T, passing arguments to its constructor
+     * @return Reference to created system
+     */
+    template<typename T, typename ...Args>
+    T& Add(Args&&... args);
+
+    /**
+     * Calls phase function on every system, returns once all of them are done
+     * @param phase - ITicker function to call, e.g. &ITicker::Tick
+     * @throw First exception thrown by a system, after the others have finished
+     */
+    void Run(void (ITicker::*phase)());
+
+protected:
+
+    /**
+     * Rebuilds dependency graph of added systems
+     */
+    void BuildGraph();
+
+    /**
+     * Schedules job running system, which then schedules its dependents
+     */
+    void Schedule(uint32_t id, JobCounter& counter);
+
+    struct Node {
+        /** Systems waiting for this one */
+        vector<uint32_t> dependents   { };
+
+        /** Number of systems this one waits for */
+        uint32_t         dependencies { 0 };
+    };
+
+    JobSystem&                       jobSystem;
+
+    vector<unique<ISystem>>          systems { };
+    vector<Node>                     graph   { };
+
+    /** Number of dependencies not finished yet, per system */
+    unique<std::atomic<uint32_t>[]>  pending { };
+
+    /** Phase of current run */
+    void (ITicker::*phase)()                 { nullptr };
+
+    /** First exception thrown in current run */
+    std::exception_ptr               failure { };
+    std::mutex                       failureMutex;
+
+    /** Serializes runs from different threads */
+    std::mutex                       runMutex;
+
+};
+
+} // namespace core
+
+#include "SystemScheduler.tpp"
+
+#endif //CORE_SYSTEMSCHEDULER_H
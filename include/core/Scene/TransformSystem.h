@@ -0,0 +1,116 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_TRANSFORMSYSTEM_H
+#define CORE_TRANSFORMSYSTEM_H
+
+#include "core/Essentials.h"
+#include "core/Handle.h"
+#include "core/Math.h"
+
+#include <mutex>
+
+namespace core {
+
+/**
+ * Recomputes world matrices of invalidated transforms once per frame
+ * @details Transforms are not recomputed on every write, they are queued instead.
+ * On update only subtrees of queued transforms are walked, in hierarchy order,
+ * disjoint subtrees are processed in parallel on the JobSystem
+ */
+class TransformSystem {
+public:
+    explicit TransformSystem(JobSystem& jobSystem);
+
+    /**
+     * Queues entity's transform and all transforms below it for recomputation
+     * @note Thread-safe
+     */
+    static void Enqueue(EntityHandle entity);
+
+    /**
+     * Recomputes all queued subtrees, then updates Bounds and triggers Transform::OnTransformChange on every recomputed transform
+     * @details Local matrices of written transforms are composed in one SIMD batch before subtrees are walked,
+     * normal matrices of all recomputed transforms are extracted in one batch after that
+     */
+    void Update();
+
+private:
+
+    struct Queue {
+        std::mutex           mutex;
+        vector<EntityHandle> entities;
+    };
+
+    /**
+     * Queued entities
+     * @note Intentionally never destroyed: entities owned by static containers are reparented at static destruction
+     */
+    static Queue& Pending();
+
+    /** Recomputes world matrix of entity's transform, if it has one */
+    static void UpdateNode(Entity& entity);
+
+    /** Moves entity's Bounds in the spatial index and triggers Transform::OnTransformChange */
+    static void NotifyNode(Transform& transform);
+
+    /** Recomputes local matrices of all transforms in composed with one Math::ComposeTransforms call */
+    void ComposeLocalTransforms();
+
+    /** Recomputes normal matrices of all transforms in extracted with one Math::ExtractNormalMatrices call */
+    void ExtractNormalMatrices();
+
+    /** Subtrees smaller than this are not split between jobs */
+    static constexpr uint32_t splitSize = 256;
+
+    JobSystem& jobSystem;
+
+    /** Entities taken from the queue, reused between frames */
+    vector<EntityHandle> queued;
+
+    /** Hierarchy nodes of independent subtrees to recompute */
+    vector<uint32_t>     roots;
+
+    /** Nodes recomputed alone, while splitting large subtrees */
+    vector<uint32_t>     split;
+
+    /** Queued transforms with outdated local matrix, with their components laid out for batch composition */
+    struct {
+        vector<Transform*> transforms;
+        vector<float>      position[3];
+        vector<float>      rotation[4];
+        vector<float>      scale[3];
+        vector<Matrix4>    matrices;
+    } composed;
+
+    /** Recomputed transforms in hierarchy order, with their world matrices laid out for batch extraction */
+    struct {
+        vector<Transform*> transforms;
+        vector<Matrix4>    matrices;
+        vector<Matrix3x3>  normals;
+    } extracted;
+};
+
+} // namespace core
+
+#endif //CORE_TRANSFORMSYSTEM_H
@@ -0,0 +1,150 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_WORLDPARTITION_H
+#define CORE_WORLDPARTITION_H
+
+#include "core/Essentials.h"
+#include "core/Handle.h"
+#include "core/JobSystem.h"
+#include "core/Math.h"
+#include "core/Scene/SceneSnapshot.h"
+
+#include <chrono>
+#include <unordered_map>
+
+namespace core {
+
+/**
+ * Streams a world split into a grid of cells, each cell stored as a SceneSnapshot
+ * @details Cells closer to the focus than load radius are decoded and their assets are read on the JobSystem,
+ * then uploaded and instantiated on the main thread in time-budgeted steps.
+ * Cells further than unload radius are destroyed, also within the budget.
+ * Grid lies on the XZ plane, cell (x, y) spans [x * cellSize, (x + 1) * cellSize) along X
+ * and [y * cellSize, (y + 1) * cellSize) along Z
+ */
+class WorldPartition {
+public:
+    /**
+     * @param cellSize - Size of a cell edge
+     * @param loadRadius - Cells with center closer than this are loaded
+     * @param unloadRadius - Cells with center further than this are unloaded, expected to be >= loadRadius
+     * @param parent - Entity loaded cells are attached to
+     */
+    WorldPartition(float cellSize, float loadRadius, float unloadRadius, EntityHandle parent, JobSystem& jobSystem);
+
+    /**
+     * Waits for pending decodes, destroys all loaded cells
+     */
+    ~WorldPartition();
+
+    /** Copying is not allowed */
+    WorldPartition(const WorldPartition&) = delete;
+
+    /** Copying is not allowed */
+    WorldPartition& operator=(const WorldPartition&) = delete;
+
+    /**
+     * Registers snapshot file holding contents of a cell
+     * @throw std::logic_error if cell is already registered
+     */
+    void AddCell(Vector2i cell, const string& snapshotPath);
+
+    /**
+     * Starts and finishes streaming of cells around the focus
+     * @details Schedules decoding of cells entering load radius, then spends at most budget
+     * finalizing decoded cells and destroying cells outside of unload radius
+     * @note Has to be called on the main thread, once per frame
+     */
+    void Update(const Vector3& focus, std::chrono::microseconds budget);
+
+    /**
+     * Is cell fully instantiated?
+     */
+    bool IsLoaded(Vector2i cell) const;
+
+    /**
+     * Get cell containing point
+     */
+    Vector2i GetCell(const Vector3& point) const;
+
+private:
+
+    enum class CellState {
+        Unloaded,
+        Decoding,
+        Instantiating,
+        Loaded,
+        Unloading
+    };
+
+    struct Cell {
+        Vector2i  coordinates;
+        string    path;
+        CellState state { CellState::Unloaded };
+
+        /** Finished once decoded or failed is filled by the decoding job */
+        unique<JobCounter> decoding;
+
+        SceneSnapshot::Decoded  decoded;
+        SceneSnapshot::Progress progress;
+        string                  failure;
+
+        /** Entity all cell contents are attached to */
+        EntityHandle root;
+    };
+
+    static uint64_t Key(Vector2i cell);
+
+    /** Distance from focus to cell center, on the XZ plane */
+    float Distance(const Cell& cell, const Vector3& focus) const;
+
+    void StartDecoding(Cell& cell);
+
+    /**
+     * Instantiates decoded cell until deadline
+     * @return true once cell is loaded
+     */
+    bool Instantiate(Cell& cell, std::chrono::steady_clock::time_point deadline);
+
+    /**
+     * Destroys cell contents until deadline
+     * @return true once cell is unloaded
+     */
+    bool Unload(Cell& cell, std::chrono::steady_clock::time_point deadline);
+
+    const float  cellSize;
+    const float  loadRadius;
+    const float  unloadRadius;
+    EntityHandle parent;
+    JobSystem&   jobSystem;
+
+    std::unordered_map<uint64_t, Cell> cells;
+
+    /** Owns assets of all loaded cells */
+    SceneSnapshot snapshot;
+};
+
+} // namespace core
+
+#endif //CORE_WORLDPARTITION_H
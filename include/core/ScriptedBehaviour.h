@@ -30,17 +30,22 @@
 
 namespace core {
 
+/**
+ * Base class for user logic attached to Entity through Script<T>
+ * @note Public phase overrides are called statically bound by Script<T>, non-public ones through ITicker
+ */
 class ScriptedBehaviour : public ITicker {
 public:
     virtual ~ScriptedBehaviour() = default;
 
-    void SetEntity(Entity* e) {
+    void SetEntity(EntityHandle e) {
         entity = e;
     }
 
 protected:
 
-    Entity* entity { nullptr };
+    /** Entity this behaviour is attached to */
+    EntityHandle entity { };
 };
 
 }
@@ -0,0 +1,132 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#ifndef CORE_TICKERPHASES_H
+#define CORE_TICKERPHASES_H
+
+#include "ITicker.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace core {
+
+/**
+ * Update calls of ITicker
+ */
+enum class TickerPhase : uint8_t {
+    Start,
+    FixedTick,
+    EarlyTick,
+    Tick,
+    LateTick,
+    Stop,
+};
+
+constexpr std::size_t tickerPhaseCount = 6;
+
+/** Set of TickerPhase, one bit per phase */
+using TickerPhaseMask = uint8_t;
+
+constexpr TickerPhaseMask allTickerPhases = (1u << tickerPhaseCount) - 1;
+
+constexpr TickerPhaseMask PhaseBit(TickerPhase phase) {
+    return static_cast<TickerPhaseMask>(1u << static_cast<uint8_t>(phase));
+}
+
+/**
+ * ITicker member function called in phase
+ */
+constexpr void (ITicker::*PhaseFunction(TickerPhase phase))() {
+    switch (phase) {
+        case TickerPhase::Start:     return &ITicker::Start;
+        case TickerPhase::FixedTick: return &ITicker::FixedTick;
+        case TickerPhase::EarlyTick: return &ITicker::EarlyTick;
+        case TickerPhase::Tick:      return &ITicker::Tick;
+        case TickerPhase::LateTick:  return &ITicker::LateTick;
+        case TickerPhase::Stop:      return &ITicker::Stop;
+    }
+    return nullptr;
+}
+
+#define CORE_TICKER_PHASE_PROBE(Phase)                                                                              \
+    template<typename U, typename = void>                                                                           \
+    struct Phase##Probe : std::true_type { };                                                                       \
+    template<typename U>                                                                                            \
+    struct Phase##Probe<U, std::enable_if_t<std::is_same<decltype(&U::Phase), void (ITicker::*)()>::value>>         \
+        : std::false_type { };
+
+/**
+ * Finds out which ITicker functions T overrides
+ * @details Derives from T, so protected overrides are visible. Function is considered overridden
+ * unless it resolves to ITicker's own empty one, private overrides are always counted as overridden
+ */
+template<typename T>
+class TickerPhaseProbe : public T {
+    CORE_TICKER_PHASE_PROBE(Start)
+    CORE_TICKER_PHASE_PROBE(FixedTick)
+    CORE_TICKER_PHASE_PROBE(EarlyTick)
+    CORE_TICKER_PHASE_PROBE(Tick)
+    CORE_TICKER_PHASE_PROBE(LateTick)
+    CORE_TICKER_PHASE_PROBE(Stop)
+
+public:
+    static constexpr TickerPhaseMask Mask() {
+        using Self = TickerPhaseProbe<T>;
+        return (StartProbe<Self>::value     ? PhaseBit(TickerPhase::Start)     : 0)
+             | (FixedTickProbe<Self>::value ? PhaseBit(TickerPhase::FixedTick) : 0)
+             | (EarlyTickProbe<Self>::value ? PhaseBit(TickerPhase::EarlyTick) : 0)
+             | (TickProbe<Self>::value      ? PhaseBit(TickerPhase::Tick)      : 0)
+             | (LateTickProbe<Self>::value  ? PhaseBit(TickerPhase::LateTick)  : 0)
+             | (StopProbe<Self>::value      ? PhaseBit(TickerPhase::Stop)      : 0);
+    }
+};
+
+#undef CORE_TICKER_PHASE_PROBE
+
+/**
+ * Set of phases ITicker type T does work in
+ * @details Type can state its phases explicitly with static constexpr TickerPhaseMask tickerPhases member,
+ * final types are assumed to work in every phase
+ */
+template<typename T, typename = void>
+struct TickerPhases {
+    static_assert(std::is_base_of<ITicker, T>::value, "T must inherit from core::ITicker");
+
+    static constexpr TickerPhaseMask Detect() {
+        if constexpr(std::is_final<T>::value) { return allTickerPhases; }
+        else { return TickerPhaseProbe<T>::Mask(); }
+    }
+
+    static constexpr TickerPhaseMask mask = Detect();
+};
+
+template<typename T>
+struct TickerPhases<T, std::void_t<decltype(T::tickerPhases)>> {
+    static constexpr TickerPhaseMask mask = T::tickerPhases;
+};
+
+} // namespace core
+
+#endif //CORE_TICKERPHASES_H
@@ -43,6 +43,10 @@ public:
     View(const string& name, Vector2i pos = { }, Vector2i size = { });
     View(NoCreateT);
 
+    /**
+     * Triggered by Resize(), before anything is drawn into the resized framebuffer
+     * @details Attached cameras update their viewport here, ViewResized is published on EventBus afterwards
+     */
     Event<Vector2i> OnResize;
 
     /** Copying is not allowed */
@@ -73,6 +77,16 @@ protected:
 
 };
 
+/**
+ * Published on EventBus every time a View is resized
+ * @details Bursts of resizes, e.g. while a window is dragged, are handled once per drain.
+ * Delivered at the next drain, use View::OnResize for what has to match the view in the same frame
+ */
+struct ViewResized {
+    const View* view;
+    Vector2i    size;
+};
+
 } // namespace core
 
 #endif //CORE_VIEW_H
@@ -0,0 +1,89 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <core/Components/Bounds.h>
+#include <core/Components/Transform.h>
+#include <core/Entity.h>
+
+namespace core {
+
+Bounds::Bounds(Entity& parent, const Range3D& localBounds, const string& name)
+: IComponent(parent, name),
+  localBounds(localBounds)
+{
+    parent.assertRequiredComponent<Transform>(this);
+    transform = parent.GetComponent<Transform>();
+    UpdateWorldBounds(transform->GetWorldTransformMatrix());
+}
+Bounds::~Bounds() {
+    if (proxy != BoundingVolumeTree<EntityHandle>::none) {
+        GetIndex().Remove(proxy);
+    }
+}
+BoundingVolumeTree<EntityHandle>& Bounds::GetIndex() {
+    static auto* index = new BoundingVolumeTree<EntityHandle>();
+    return *index;
+}
+void Bounds::SetLocalBounds(const Range3D& bounds) {
+    localBounds = bounds;
+    UpdateWorldBounds(transform->GetWorldTransformMatrix());
+}
+const Range3D& Bounds::GetLocalBounds() const {
+    return localBounds;
+}
+const Range3D& Bounds::GetWorldBounds() const {
+    return worldBounds;
+}
+void Bounds::UpdateWorldBounds(const Matrix4& worldTransform) {
+    /* Transformed box is enclosed by the transformed center, extended by absolute values of the basis */
+    const Vector3 center = (localBounds.min() + localBounds.max()) * 0.5f;
+    const Vector3 extent = (localBounds.max() - localBounds.min()) * 0.5f;
+
+    const Vector3 worldCenter = worldTransform.transformPoint(center);
+    Vector3 worldExtent;
+    for (int row = 0; row < 3; ++row) {
+        worldExtent[row] = Math::abs(worldTransform[0][row]) * extent.x()
+                         + Math::abs(worldTransform[1][row]) * extent.y()
+                         + Math::abs(worldTransform[2][row]) * extent.z();
+    }
+    worldBounds = { worldCenter - worldExtent, worldCenter + worldExtent };
+    MarkChanged();
+
+    if (!IsActive()) { return; }
+
+    if (proxy == BoundingVolumeTree<EntityHandle>::none) {
+        proxy = GetIndex().Insert(worldBounds, entity->GetHandle());
+    } else {
+        GetIndex().Move(proxy, worldBounds);
+    }
+}
+void Bounds::OnActiveChanged(bool active) {
+    if (active) {
+        proxy = GetIndex().Insert(worldBounds, entity->GetHandle());
+    } else if (proxy != BoundingVolumeTree<EntityHandle>::none) {
+        GetIndex().Remove(proxy);
+        proxy = BoundingVolumeTree<EntityHandle>::none;
+    }
+}
+
+}
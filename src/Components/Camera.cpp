@@ -24,11 +24,16 @@
 #include <core/Components/Camera.h>
 #include <core/Components/Transform.h>
 #include <core/Components/Renderer.h>
+#include <core/Components/Occluder.h>
+#include <core/ComponentStorage.h>
+#include <core/Core.h>
 #include <core/Scene/SceneView.h>
 #include <core/Scene/Scene.h>
 #include <core/Color.h>
 #include <core/Math.h>
 
+#include <algorithm>
+
 namespace core {
 
 Camera::Camera(Entity& parent,
@@ -44,7 +49,7 @@ Camera::Camera(Entity& parent,
 {
     parent.assertRequiredComponent<Transform>(this);
     transform = parent.GetComponent<Transform>();
-    transformMtx = &transform->GetTransformMatrix();
+    transformMtx = &transform->GetWorldTransformMatrix();
     UpdatePerspectiveMatrix();
     CameraList::Get()->Register(this);
 }
@@ -61,30 +66,65 @@ Camera::Camera(Entity& parent,
 {
     parent.assertRequiredComponent<Transform>(this);
     transform = parent.GetComponent<Transform>();
-    transformMtx = &transform->GetTransformMatrix();
+    transformMtx = &transform->GetWorldTransformMatrix();
     UpdatePerspectiveMatrix();
     CameraList::Get()->Register(this);
 }
 Camera::~Camera() {
-    CameraList::Get()->Unregister(this);
+    if (IsActive()) { CameraList::Get()->Unregister(this); }
+}
+void Camera::OnActiveChanged(bool active) {
+    if (active) {
+        CameraList::Get()->Register(this);
+    } else {
+        CameraList::Get()->Unregister(this);
+    }
 }
 void Camera::Start() {
-    transform->OnTransformChange.Subscribe([&](Matrix4& mtx) {
+    transformSubscription = transform->OnTransformChange.SubscribeScoped([&](Matrix4& mtx) {
         SetTransformMatrix(mtx);
     });
-}
-void Camera::Tick() {
-
 }
 void Camera::Draw() {
     BindAttachedView();
-    
+
+    /* Layers draw with projectionMtx, so frustum taken from it matches what ends up on screen */
+    const Frustum frustum = Frustum::fromMatrix(projectionMtx);
+    cullingStats = { };
+
+    if (occlusionBuffer) {
+        occlusionBuffer->Begin(projectionMtx);
+
+        /* Active components come first in the storage, occluders of layers this camera does not draw are skipped */
+        const ComponentStorage<Occluder>& occluders = ComponentStorage<Occluder>::Get();
+        for (size_t i = 0; i < occluders.ActiveCount(); ++i) {
+            const Occluder* occluder = occluders.GetComponents()[i];
+            if (std::find(linkedLayers.begin(), linkedLayers.end(), occluder->entity->GetLayer()) == linkedLayers.end()) { continue; }
+
+            occlusionBuffer->AddOccluder(occluder->GetWorldTransformMatrix(), occluder->GetBox());
+        }
+        occlusionBuffer->Rasterize();
+    }
+
     for (const shared<Layer>& layer : linkedLayers) {
-        layer->Draw();
+        layer->Draw(frustum, cullingStats, occlusionBuffer.get());
     }
     
     BlitAttachedView();
 }
+const CullingStats& Camera::GetCullingStats() const {
+    return cullingStats;
+}
+void Camera::SetOcclusionCulling(bool enabled, uint32_t width, uint32_t height) {
+    if (enabled) {
+        occlusionBuffer = unique<OcclusionBuffer>(new OcclusionBuffer(Core::GetJobSystem(), width, height));
+    } else {
+        occlusionBuffer.reset();
+    }
+}
+const OcclusionBuffer* Camera::GetOcclusionBuffer() const {
+    return occlusionBuffer.get();
+}
 void Camera::SetViewport(Vector2i v) {
     if (v.x() == 0 || v.y() == 0) {
         Logger::Log(INTERNAL, ERR_HERE) << "Viewport dimensions " << v.x() << 'x' << v.y() << " are invalid";
@@ -141,8 +181,9 @@ void Camera::FixAspectRatio() {
 }
 void Camera::SetView(View& view) {
     attachedView = &view;
-    attachedView->OnResize.Subscribe([&](Vector2i& vec) {
-        SetViewport(vec);
+    /* Synchronous, frame drawn right after the resize already uses the new viewport */
+    resizeSubscription = attachedView->OnResize.SubscribeScoped([this](Vector2i& viewport) {
+        SetViewport(viewport);
     });
 }
 void Camera::UpdateLayersProjectionMatrix() {
@@ -0,0 +1,48 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <core/Components/Occluder.h>
+#include <core/Components/Transform.h>
+#include <core/Entity.h>
+
+namespace core {
+
+Occluder::Occluder(Entity& parent, const Range3D& box, const string& name)
+: IComponent(parent, name),
+  box(box)
+{
+    parent.assertRequiredComponent<Transform>(this);
+    transform = parent.GetComponent<Transform>();
+}
+void Occluder::SetBox(const Range3D& newBox) {
+    box = newBox;
+    MarkChanged();
+}
+const Range3D& Occluder::GetBox() const {
+    return box;
+}
+const Matrix4& Occluder::GetWorldTransformMatrix() const {
+    return transform->GetWorldTransformMatrix();
+}
+
+}
@@ -26,6 +26,8 @@
 #include <core/Components/Camera.h>
 #include <core/Model.h>
 
+#include <algorithm>
+
 namespace core {
 
 Renderer::Renderer(Entity& parent, const shared<Model>& model, const string& name)
@@ -34,18 +36,47 @@ Renderer::Renderer(Entity& parent, const shared<Model>& model, const string& nam
 {
     parent.assertRequiredComponent<Transform>(this);
     transform = parent.GetComponent<Transform>();
-    SetTransformMatrix(transform->GetTransformMatrix());
-    transform->OnTransformChange.Subscribe([&](Matrix4& mtx) { SetTransformMatrix(mtx); });
+    SetTransformMatrix(transform->GetWorldTransformMatrix());
+    uploadedVersion = transform->GetVersion();
+}
+void Renderer::SetSource(const Source& newSource) {
+    source = newSource;
+}
+const Renderer::Source& Renderer::GetSource() const {
+    return source;
 }
 void Renderer::Draw() {
+    /** Upload transform only if it was written since last upload */
+    if (transform->GetVersion() != uploadedVersion) {
+        /* Normal matrix was extracted with the world matrix by TransformSystem */
+        model->SetTransformMatrix(transform->GetWorldTransformMatrix());
+        model->SetNormalMatrix(transform->GetNormalMatrix());
+        uploadedVersion = transform->GetVersion();
+    }
     model->Draw();
 }
+bool Renderer::GetBoundingSphere(Vector4& sphere) {
+    const shared<Mesh>& mesh = model->GetMesh();
+    if (!mesh || !mesh->HasBounds()) { return false; }
+
+    if (!hasBoundingSphere || transform->GetVersion() != boundingSphereVersion) {
+        const Matrix4& world = transform->GetWorldTransformMatrix();
+
+        /* Radius grows with the largest axis scale */
+        const float scale = Math::sqrt(std::max({ world[0].xyz().dot(), world[1].xyz().dot(), world[2].xyz().dot() }));
+        boundingSphere = { world.transformPoint(mesh->GetBounds().center()), mesh->GetBoundingRadius() * scale };
+        boundingSphereVersion = transform->GetVersion();
+        hasBoundingSphere = true;
+    }
+    sphere = boundingSphere;
+    return true;
+}
 void Renderer::SetProjectionMatrix(Matrix4& mtx) {
     model->SetProjectionMatrix(mtx);
 }
 void Renderer::SetTransformMatrix(Matrix4& mtx) {
     model->SetTransformMatrix(mtx);
-    model->SetNormalMatrix(mtx);
+    model->SetNormalMatrix(mtx.normalMatrix());
 }
 void Renderer::SetLight(Light& light) {
     switch (light.GetLightType()) {
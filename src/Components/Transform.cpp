@@ -22,27 +22,41 @@
  SOFTWARE.
  */
 #include <core/Components/Transform.h>
+#include <core/Scene/TransformSystem.h>
 #include <core/Entity.h>
 #include <core/Math.h>
 
 namespace core {
 
 Transform::Transform(Entity& entity, const string& name)
-: IComponent(entity, name), parentTransform(const_cast<Matrix4*>(&Math::identityMatrix)) {
+: IComponent(entity, name) {
     entity.assertExistingComponent<Transform>();
-    
-    if (entity.GetParent() && entity.GetParent()->HasComponent<Transform>()) {
-        SetParent(entity.GetParent()->GetComponent<Transform>());
-    }
+    Invalidate();
+}
+void Transform::UpdateTransform() {
+    localDirty = true;
+    Invalidate();
 }
-void Transform::Tick() {
+void Transform::Invalidate() {
+    /* Only the first writer since last update enqueues, writers might run on several jobs */
+    if (queued.exchange(true, std::memory_order_acq_rel)) { return; }
 
+    TransformSystem::Enqueue(entity->GetHandle());
 }
-void Transform::UpdateTransform() {
-    localTransform = (*parentTransform) * Matrix4::from(rotation.toMatrix(), position) * Matrix4::scaling(scale);
-    OnTransformChange.Trigger(localTransform);
+void Transform::UpdateWorldTransform() {
+    Entity* parent = entity->GetParent();
+    Transform* parentTransform = parent ? parent->GetComponent<Transform>() : nullptr;
+    worldTransform = parentTransform ? parentTransform->worldTransform * GetTransformMatrix() : GetTransformMatrix();
+    MarkChanged();
+}
+const Matrix3x3& Transform::GetNormalMatrix() const {
+    return normalMatrix;
 }
 Matrix4& Transform::GetTransformMatrix() {
+    if (localDirty) {
+        localTransform = Matrix4::from(rotation.toMatrix(), position) * Matrix4::scaling(scale);
+        localDirty = false;
+    }
     return localTransform;
 }
 Vector3& Transform::GetPosition() {
@@ -54,9 +68,6 @@ Quaternion& Transform::GetRotation() {
 Vector3& Transform::GetScale() {
     return scale;
 }
-void Transform::SetParent(Transform* parent) {
-    parentTransform = &parent->GetTransformMatrix();
-}
 void Transform::SetPosition(Vector3& vec) {
     position = vec;
     UpdateTransform();
@@ -106,7 +117,7 @@ void Transform::Scale(Vector3&& vec) {
     SetScale(scale * vec);
 }
 Matrix4& Transform::GetWorldTransformMatrix() {
-    throw std::logic_error("Not yet implmented");
+    return worldTransform;
 }
 
 }
\ No newline at end of file
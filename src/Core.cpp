@@ -22,6 +22,7 @@
  SOFTWARE.
  */
 #include <core/Core.h>
+#include <core/JobSystem.h>
 
 #include <memory>
 
@@ -41,6 +42,14 @@ IModule* Core::GetModule(int32_t id) {
     }
     return static_cast<IModule*>(it->second->Get());
 };
+JobSystem& Core::GetJobSystem() {
+    Core* core = Get();
+    if ( !core || !core->jobSystem ) {
+        Logger::Log(INTERNAL, ERR_HERE) << "Job system requested before Core was built";
+        throw std::logic_error("Job system requested before Core was built");
+    }
+    return *core->jobSystem;
+}
 Core &Core::operator=(Core &&other) noexcept {
     return *this;
 }
@@ -43,8 +43,13 @@ uint16_t CoreConfig::CoreInfo::majorVersion { CORE_MAJOR_VERSION };
 uint16_t CoreConfig::CoreInfo::minorVersion { CORE_MINOR_VERSION };
 uint16_t CoreConfig::CoreInfo::patchVersion { CORE_PATCH_VERSION };
 
+CoreConfig& CoreConfig::SetWorkerCount(uint32_t count) {
+    workerCount = count;
+    return *this;
+}
 unique<Core> CoreConfig::Build() {
     unique<Core> coreContaner = std::unique_ptr<Core>(new Core);
+    coreContaner->jobSystem = make_unique<JobSystem>(workerCount);
     std::stack<initializer_fn*> initializers;
 
     std::unordered_set<int> unmarkedNodes;
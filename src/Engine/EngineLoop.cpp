@@ -23,6 +23,8 @@
  */
 #include <core/Engine/EngineLoop.h>
 #include <core/Engine/EngineModule.h>
+#include <core/Event.h>
+#include <core/EventBus.h>
 
 #include <SDL.h>
 #include <SDL_syswm.h>
@@ -38,12 +40,18 @@ EngineLoop::EngineLoop(InputModule* inputModule) : inputModule(inputModule) {
 }
 int32_t EngineLoop::Enter() {
 
+    /** Events triggered on the fixed tick thread are delivered on this one */
+    EventDispatcher::Get().BindToThisThread();
+
     std::thread fixedLoopThread(&EngineLoop::FixedTickLoop, this);
 
     while ( isRunning ) {
 
         EngineClock::MarkLoopStart();
 
+        /** Deliver events posted from other threads since last frame */
+        EventDispatcher::Get().DispatchPosted();
+
         /** Called before the frame is drawn */
         this->EarlyTickModules();
 
@@ -62,35 +70,49 @@ int32_t EngineLoop::Enter() {
 
     fixedLoopThread.join();
 
+    EventDispatcher::Get().DispatchPosted();
+
     return 0;
 }
 void EngineLoop::StartModules() {
-    std::for_each(IModule::instances.begin(), IModule::instances.end(), [&](IModule* module) {
+    const auto& modules = IModule::ForPhase(TickerPhase::Start);
+    std::for_each(modules.begin(), modules.end(), [&](IModule* module) {
         module->Start();
     });
 }
 void EngineLoop::StopModules() {
-    std::for_each(IModule::instances.begin(), IModule::instances.end(), [&](IModule* module) {
+    const auto& modules = IModule::ForPhase(TickerPhase::Stop);
+    std::for_each(modules.begin(), modules.end(), [&](IModule* module) {
         module->Stop();
     });
 }
 void EngineLoop::EarlyTickModules() {
-    std::for_each(IModule::instances.begin(), IModule::instances.end(), [&](IModule* module) {
+    EventBus::Drain(TickerPhase::EarlyTick);
+
+    const auto& modules = IModule::ForPhase(TickerPhase::EarlyTick);
+    std::for_each(modules.begin(), modules.end(), [&](IModule* module) {
         module->EarlyTick();
     });
 }
 void EngineLoop::TickModules() {
-    std::for_each(IModule::instances.begin(), IModule::instances.end(), [&](IModule* module) {
+    EventBus::Drain(TickerPhase::Tick);
+
+    const auto& modules = IModule::ForPhase(TickerPhase::Tick);
+    std::for_each(modules.begin(), modules.end(), [&](IModule* module) {
         module->Tick();
     });
 }
 void EngineLoop::LateTickModules() {
-    std::for_each(IModule::instances.begin(), IModule::instances.end(), [&](IModule* module) {
+    EventBus::Drain(TickerPhase::LateTick);
+
+    const auto& modules = IModule::ForPhase(TickerPhase::LateTick);
+    std::for_each(modules.begin(), modules.end(), [&](IModule* module) {
         module->LateTick();
     });
 }
 void EngineLoop::FixedTickModules() {
-    std::for_each(IModule::instances.begin(), IModule::instances.end(), [&](IModule* module) {
+    const auto& modules = IModule::ForPhase(TickerPhase::FixedTick);
+    std::for_each(modules.begin(), modules.end(), [&](IModule* module) {
         module->FixedTick();
     });
 }
@@ -22,47 +22,90 @@
  SOFTWARE.
  */
 #include <core/Components/Camera.h>
+#include <core/Components/Transform.h>
 #include <core/Scene/SceneImporter.h>
 #include <core/Model.h>
 #include <core/Entity.h>
+#include <core/Query.h>
+#include <core/Prefab.h>
 #include <core/Logger.h>
 
 #include <utility>
 
 namespace core {
 
-Entity::Entity(const string& name, shared<Entity> parent, shared<Layer> layer)
-: Object(name), SceneObject(std::move(parent)), layer(layer)
+namespace {
+
+/**
+ * Memory blocks of destroyed entities
+ * @note Intentionally never destroyed: spawned children of Scene roots are released at static destruction
+ */
+vector<void*>& RecycledBlocks() {
+    static auto* blocks = new vector<void*>();
+    return *blocks;
+}
+
+}
+
+Entity::Entity(const string& name, EntityHandle parent, shared<Layer> layer)
+: Object(name), layer(layer)
 {
-    layer->Link(*this);
+    layer->LinkCreated(*this);
+    SetParent(parent);
 }
 Entity::~Entity() {
-    layer->Unlink(*this);
+    DestroyChildren();
+    layer->Drop(*this);
+    IQuery::EntityDestroyed(*this);
+
+    /** Release components in reverse order, so dependent components go before their requirements */
+    for (auto it = components.bases.rbegin(); it != components.bases.rend(); ++it) {
+        (*it)->storage->Release(*it);
+    }
 }
 bool Entity::operator!=(const Entity &rhs) const {
     return !(rhs == *this);
 }
 void Entity::Start() {
-    std::for_each(components.tickers.begin(), components.tickers.end(), [&](ITicker* t) { t->Start(); });
+    const auto& tickers = components.tickers[static_cast<size_t>(TickerPhase::Start)];
+    std::for_each(tickers.begin(), tickers.end(), [&](ITicker* t) { t->Start(); });
 }
 void Entity::FixedTick() {
-    std::for_each(components.tickers.begin(), components.tickers.end(), [&](ITicker* t) { t->FixedTick(); });
+    const auto& tickers = components.tickers[static_cast<size_t>(TickerPhase::FixedTick)];
+    std::for_each(tickers.begin(), tickers.end(), [&](ITicker* t) { t->FixedTick(); });
 }
 void Entity::EarlyTick() {
-    std::for_each(components.tickers.begin(), components.tickers.end(), [&](ITicker* t) { t->EarlyTick(); });
+    const auto& tickers = components.tickers[static_cast<size_t>(TickerPhase::EarlyTick)];
+    std::for_each(tickers.begin(), tickers.end(), [&](ITicker* t) { t->EarlyTick(); });
 }
 void Entity::Tick() {
-    std::for_each(components.tickers.begin(), components.tickers.end(), [&](ITicker* t) { t->Tick(); });
+    const auto& tickers = components.tickers[static_cast<size_t>(TickerPhase::Tick)];
+    std::for_each(tickers.begin(), tickers.end(), [&](ITicker* t) { t->Tick(); });
 }
 void Entity::LateTick() {
-    std::for_each(components.tickers.begin(), components.tickers.end(), [&](ITicker* t) { t->LateTick(); });
+    const auto& tickers = components.tickers[static_cast<size_t>(TickerPhase::LateTick)];
+    std::for_each(tickers.begin(), tickers.end(), [&](ITicker* t) { t->LateTick(); });
 }
 void Entity::Stop() {
-    std::for_each(components.tickers.begin(), components.tickers.end(), [&](ITicker* t) { t->Stop(); });
+    const auto& tickers = components.tickers[static_cast<size_t>(TickerPhase::Stop)];
+    std::for_each(tickers.begin(), tickers.end(), [&](ITicker* t) { t->Stop(); });
 }
 bool Entity::operator==(const Entity &rhs) const {
     return this->GetId() == rhs.GetId();
 }
+const ComponentSignature& Entity::GetSignature() const {
+    return components.signature;
+}
+void Entity::SetParent(EntityHandle parent) {
+    SceneObject<Entity>::SetParent(parent);
+
+    if (auto* transform = GetComponent<Transform>()) {
+        transform->Invalidate();
+    }
+}
+void Entity::SignatureChanged(const ComponentSignature& previous) {
+    IQuery::SignatureChanged(*this, previous);
+}
 void Entity::SetLayer(const string& name) {
     shared<Layer> newLayer = Layer::Get(name);
     layer->Unlink(*this);
@@ -77,5 +120,65 @@ void Entity::Destroy(shared<Entity>& entity) {
     entity->DestroyChildren();
     entity.reset();
 }
+EntityHandle Entity::Spawn(const string& name, EntityHandle parent, shared<Layer> layer) {
+    auto* entity = new Entity(name, parent, std::move(layer));
+    entity->spawned = true;
+    return entity->GetHandle();
+}
+vector<EntityHandle> Entity::SpawnBatch(const Prefab& prefab, size_t count, EntityHandle parent) {
+    shared<Layer> layer = Layer::Get(prefab.GetLayer());
+
+    Reserve(count);
+    Referable<Entity>::Reserve(count);
+    prefab.Reserve(count);
+    layer->Reserve<Entity>(count);
+    SceneHierarchy<Entity>::Reserve(count);
+
+    vector<EntityHandle> handles;
+    handles.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        auto* entity = new Entity(prefab.GetName(), parent, layer);
+        entity->spawned = true;
+        entity->components.bases.reserve(prefab.Size());
+        prefab.Build(*entity);
+        handles.push_back(entity->GetHandle());
+    }
+    return handles;
+}
+void Entity::Reserve(size_t count) {
+    vector<void*>& blocks = RecycledBlocks();
+    if (blocks.size() >= count) { return; }
+
+    /* Reserved memory is never released, blocks are recycled instead */
+    const size_t missing = count - blocks.size();
+    auto* chunk = static_cast<unsigned char*>(::operator new(missing * sizeof(Entity)));
+
+    blocks.reserve(count);
+    for (size_t i = missing; i > 0; --i) {
+        blocks.push_back(chunk + (i - 1) * sizeof(Entity));
+    }
+}
+void* Entity::operator new(size_t size) {
+    vector<void*>& blocks = RecycledBlocks();
+    if (blocks.empty()) {
+        return ::operator new(size);
+    }
+    void* block = blocks.back();
+    blocks.pop_back();
+    return block;
+}
+void Entity::operator delete(void* memory) {
+    RecycledBlocks().push_back(memory);
+}
+void Entity::Destroy(EntityHandle handle) {
+    Entity* entity = handle.Get();
+    if (!entity) { return; }
+
+    if (entity->spawned) {
+        delete entity;
+    } else {
+        entity->SetParent({ });
+    }
+}
 
 } // namespace core
\ No newline at end of file
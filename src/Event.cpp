@@ -0,0 +1,108 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "core/Event.h"
+
+namespace core {
+
+void IEventState::Retain() {
+    references.fetch_add(1, std::memory_order_relaxed);
+}
+void IEventState::Release() {
+    if (references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+bool IEventState::IsAlive() const {
+    return alive.load(std::memory_order_acquire);
+}
+void IEventState::Schedule() {
+    /* Already queued: dispatcher clears the flag before draining, so it will see this command */
+    if (scheduled.exchange(true, std::memory_order_acq_rel)) { return; }
+
+    Retain();
+    EventDispatcher::Get().Schedule(this);
+}
+
+EventDispatcher& EventDispatcher::Get() {
+    /* Events may be destroyed by other statics, so dispatcher is never destroyed */
+    static auto* dispatcher = new EventDispatcher();
+    return *dispatcher;
+}
+void EventDispatcher::BindToThisThread() {
+    /* New value per bind, so a thread that owned events before is not the owner anymore */
+    threadBinding = binding.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+void EventDispatcher::DispatchPosted() {
+    batch.clear();
+    while (IEventState* state = ready.Pop()) {
+        batch.push_back(state);
+    }
+    for (IEventState* state : batch) {
+        /* Cleared before draining, commands pushed from now on schedule the state again */
+        state->scheduled.exchange(false, std::memory_order_acq_rel);
+        state->DispatchPosted();
+        state->Release();
+    }
+    batch.clear();
+}
+void EventDispatcher::Schedule(IEventState* state) {
+    ready.Push(state);
+}
+
+Subscription::Subscription(IEventState* state, uint32_t id)
+    : state(state)
+    , id(id) { }
+
+Subscription::Subscription(Subscription&& other) noexcept
+    : state(other.state)
+    , id(other.id) {
+    other.state = nullptr;
+    other.id    = 0;
+}
+Subscription& Subscription::operator=(Subscription&& other) noexcept {
+    if (this != &other) {
+        Reset();
+        state = other.state;
+        id    = other.id;
+        other.state = nullptr;
+        other.id    = 0;
+    }
+    return *this;
+}
+Subscription::~Subscription() {
+    Reset();
+}
+void Subscription::Reset() {
+    if (state) {
+        if (state->IsAlive()) { state->Unsubscribe(id); }
+        state->Release();
+    }
+    state = nullptr;
+    id    = 0;
+}
+bool Subscription::IsConnected() const {
+    return state && state->IsAlive();
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include "core/EventBus.h"
+#include "core/Logger.h"
+
+#include <stdexcept>
+
+namespace core {
+
+void EventBus::Drain(TickerPhase phase) {
+    for (IEventChannel* channel : Channels()) {
+        channel->Drain(phase);
+    }
+}
+bool EventBus::IsDrainPhase(TickerPhase phase) {
+    return phase == TickerPhase::EarlyTick || phase == TickerPhase::Tick || phase == TickerPhase::LateTick;
+}
+void EventBus::Register(IEventChannel* channel) {
+    Channels().push_back(channel);
+}
+void EventBus::ValidateSubscribe(TickerPhase phase) {
+    if (!IsDrainPhase(phase)) {
+        Logger::Log(INTERNAL, ERR_HERE) << "EventBus is drained only before EarlyTick, Tick and LateTick";
+        throw std::logic_error("EventBus is drained only before EarlyTick, Tick and LateTick");
+    }
+    ValidatePublish();
+}
+void EventBus::ValidatePublish() {
+    if (!EventDispatcher::IsOwnerThread()) {
+        Logger::Log(INTERNAL, ERR_HERE) << "EventBus can only be used from the main loop thread";
+        throw std::logic_error("EventBus can only be used from the main loop thread");
+    }
+}
+vector<IEventChannel*>& EventBus::Channels() {
+    static auto* channels = new vector<IEventChannel*>();
+    return *channels;
+}
+
+}
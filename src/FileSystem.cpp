@@ -24,8 +24,80 @@
 #include <core/FileSystem.h>
 #include <fstream>
 
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
 namespace core {
 
+#ifdef _WIN32
+MappedFile::MappedFile(const string& path) {
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        Logger::Log(IMPORT, ERR_HERE) << "Failed to open file at " << path;
+        throw std::runtime_error("Failed to open file at " + path);
+    }
+
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    size = static_cast<size_t>(fileSize.QuadPart);
+    if (size == 0) { return; }
+
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    data = mapping ? static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+    if (!data) {
+        if (mapping) { CloseHandle(mapping); }
+        CloseHandle(file);
+        Logger::Log(IMPORT, ERR_HERE) << "Failed to map file at " << path;
+        throw std::runtime_error("Failed to map file at " + path);
+    }
+}
+MappedFile::~MappedFile() {
+    if (data)    { UnmapViewOfFile(data); }
+    if (mapping) { CloseHandle(mapping); }
+    if (file)    { CloseHandle(file); }
+}
+#else
+MappedFile::MappedFile(const string& path) {
+    const int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        Logger::Log(IMPORT, ERR_HERE) << "Failed to open file at " << path;
+        throw std::runtime_error("Failed to open file at " + path);
+    }
+
+    struct stat status { };
+    fstat(descriptor, &status);
+    size = static_cast<size_t>(status.st_size);
+
+    /* Mapping stays valid after the descriptor is closed */
+    void* mapped = size > 0 ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0) : nullptr;
+    close(descriptor);
+
+    if (mapped == MAP_FAILED) {
+        Logger::Log(IMPORT, ERR_HERE) << "Failed to map file at " << path;
+        throw std::runtime_error("Failed to map file at " + path);
+    }
+    data = static_cast<const unsigned char*>(mapped);
+}
+MappedFile::~MappedFile() {
+    if (data) { munmap(const_cast<unsigned char*>(data), size); }
+}
+#endif
+const unsigned char* MappedFile::GetData() const {
+    return data;
+}
+size_t MappedFile::GetSize() const {
+    return size;
+}
+
+
 int64_t FileSystem::GetFileSize(const string& path) {
     std::ifstream file(path, std::ifstream::ate | std::ifstream::binary);
     return file.tellg();
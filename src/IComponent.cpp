@@ -22,14 +22,50 @@
  SOFTWARE.
  */
 #include <core/IComponent.h>
+#include <core/ComponentStorage.h>
+
+#include <atomic>
 
 namespace core {
 
-IComponent::IComponent(Entity& parent, const string& name) : Object(name + " component"), entity(&parent) {
+namespace {
+
+/* Starts at 1, so consumers that never visited (tick 0) see every component as changed */
+std::atomic<uint64_t> changeTicks { 1 };
+
+}
+
+IComponent::IComponent(Entity& parent, const string& name) : Object(name), entity(&parent) {
 
 }
 IComponent::~IComponent() {
 
 }
+void IComponent::SetActive(bool value) {
+    if (active == value) { return; }
+
+    active = value;
+    if (storage) { storage->SetActive(this, value); }
+    OnActiveChanged(value);
+}
+bool IComponent::IsActive() const {
+    return active;
+}
+void IComponent::MarkChanged() {
+    ++version;
+    changeTick = changeTicks.load(std::memory_order_relaxed);
+}
+uint32_t IComponent::GetVersion() const {
+    return version;
+}
+uint64_t IComponent::GetChangeTick() const {
+    return changeTick;
+}
+uint64_t IComponent::CurrentChangeTick() {
+    return changeTicks.load(std::memory_order_relaxed);
+}
+uint64_t IComponent::AdvanceChangeTick() {
+    return changeTicks.fetch_add(1, std::memory_order_relaxed);
+}
 
 }
\ No newline at end of file
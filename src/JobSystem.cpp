@@ -0,0 +1,151 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <core/JobSystem.h>
+
+namespace core {
+
+namespace {
+
+/** JobSystem the calling thread is a worker of */
+thread_local const JobSystem* currentSystem { nullptr };
+
+/** Queue of the calling worker thread */
+thread_local uint32_t currentQueue { 0 };
+
+/** Spins an idle worker does before going to sleep */
+constexpr uint32_t idleSpinCount = 64;
+
+}
+
+JobSystem::JobSystem(uint32_t workerCount) {
+    for (uint32_t i = 0; i < workerCount + 1; ++i) {
+        queues.push_back(make_unique<WorkQueue>());
+    }
+    workers.reserve(workerCount);
+    for (uint32_t i = 1; i <= workerCount; ++i) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> guard(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    std::for_each(workers.begin(), workers.end(), [&](std::thread& worker) { worker.join(); });
+}
+void JobSystem::Schedule(Job job, JobCounter* counter) {
+    if (counter) { counter->count.fetch_add(1, std::memory_order_relaxed); }
+
+    WorkQueue& queue = *queues[CurrentQueue()];
+    {
+        std::lock_guard<std::mutex> guard(queue.mutex);
+        queue.jobs.push_back({ std::move(job), counter });
+    }
+    queued++;
+
+    if (sleeping > 0) {
+        std::lock_guard<std::mutex> guard(sleepMutex);
+        wake.notify_one();
+    }
+}
+void JobSystem::Wait(const JobCounter& counter) {
+    const uint32_t queueIndex = CurrentQueue();
+
+    while (!counter.IsDone()) {
+        if (!RunNext(queueIndex)) {
+            std::this_thread::yield();
+        }
+    }
+}
+uint32_t JobSystem::ThreadCount() const {
+    return static_cast<uint32_t>(queues.size());
+}
+uint32_t JobSystem::DefaultWorkerCount() {
+    const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+bool JobSystem::RunNext(uint32_t queueIndex) {
+    if (queued == 0) { return false; }
+
+    QueuedJob job;
+    bool found = false;
+
+    /** Newest job from own queue, it is likely still in cache */
+    {
+        WorkQueue& own = *queues[queueIndex];
+        std::lock_guard<std::mutex> guard(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+
+    /** Oldest job from other queues */
+    for (uint32_t i = 1; !found && i < queues.size(); ++i) {
+        WorkQueue& victim = *queues[(queueIndex + i) % queues.size()];
+        std::lock_guard<std::mutex> guard(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            found = true;
+        }
+    }
+    if (!found) { return false; }
+
+    queued--;
+    job.function();
+    if (job.counter) { job.counter->count.fetch_sub(1, std::memory_order_acq_rel); }
+
+    return true;
+}
+void JobSystem::WorkerLoop(uint32_t queueIndex) {
+    currentSystem = this;
+    currentQueue  = queueIndex;
+
+    uint32_t idleSpins = 0;
+    while (!stopping) {
+        if (RunNext(queueIndex)) {
+            idleSpins = 0;
+            continue;
+        }
+        if (++idleSpins < idleSpinCount) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleeping++;
+        wake.wait(lock, [&] { return stopping || queued > 0; });
+        sleeping--;
+        idleSpins = 0;
+    }
+}
+uint32_t JobSystem::CurrentQueue() const {
+    return currentSystem == this ? currentQueue : 0;
+}
+
+} // namespace core
@@ -26,12 +26,15 @@
 #include <core/Entity.h>
 #include <core/LayerLinked.h>
 #include <core/Components/Camera.h>
+#include <core/Scene/OcclusionBuffer.h>
 
 #include <algorithm>
 #include <iomanip>
 
 namespace core {
 
+bool Layer::unlinkDeferred { false };
+
 Layer::Layer(const string &name)
 : Object(name)
 {
@@ -40,10 +43,36 @@ Layer::Layer(const string &name)
         throw std::runtime_error("Layer " + name + " already exists");
     }
 }
+void Layer::LinkCreated(Entity& entity) {
+    entities.push_back(entity.GetHandle());
+}
+void Layer::Drop(Entity& entity) {
+    if (unlinkDeferred) {
+        hasStaleEntities = true;
+    } else {
+        Unlink(entity);
+    }
+}
+void Layer::DeferUnlink(bool defer) {
+    unlinkDeferred = defer;
+    if (defer) { return; }
+
+    for (shared<Layer>& layer : container) {
+        if (!layer->hasStaleEntities) { continue; }
+
+        auto& entities = layer->entities;
+        entities.erase(std::remove_if(entities.begin(),
+                                      entities.end(),
+                                      [](EntityHandle e) { return !e.IsValid(); }), entities.end());
+        layer->hasStaleEntities = false;
+    }
+}
 void Layer::Draw() {
 
     /** For every entity attached to this layer */
-    for (Entity* entity : entities) {
+    for (EntityHandle handle : entities) {
+        Entity* entity = handle.Get();
+        if (!entity) { continue; }
 
         /** Draw each IDrawable attached to the Entity */
         for (IDrawable* drawable : entity->components.drawables) {
@@ -53,22 +82,91 @@ void Layer::Draw() {
     }
 
 }
+void Layer::Draw(const Frustum& frustum, CullingStats& stats, const OcclusionBuffer* occlusion) {
+    cullCandidates.clear();
+    for (vector<float>& component : cullSpheres) {
+        component.clear();
+    }
+
+    uint32_t unbounded = 0;
+    for (EntityHandle handle : entities) {
+        Entity* entity = handle.Get();
+        if (!entity) { continue; }
+
+        for (IDrawable* drawable : entity->components.drawables) {
+            Vector4 sphere;
+            if (!drawable->GetBoundingSphere(sphere)) {
+                drawable->Draw();
+                ++unbounded;
+                continue;
+            }
+            cullCandidates.push_back(drawable);
+            for (size_t i = 0; i < 4; ++i) {
+                cullSpheres[i].push_back(sphere[i]);
+            }
+        }
+    }
+
+    Math::SphereArrays spheres;
+    spheres.center[0] = cullSpheres[0].data();
+    spheres.center[1] = cullSpheres[1].data();
+    spheres.center[2] = cullSpheres[2].data();
+    spheres.radius    = cullSpheres[3].data();
+
+    cullVisibility.resize(cullCandidates.size());
+    size_t visible = Math::CullSpheres(frustum, spheres, cullVisibility.data(), cullCandidates.size());
+
+    if (occlusion && visible != 0) {
+        occludees.clear();
+        occludeeBounds.clear();
+        for (uint32_t i = 0; i < cullCandidates.size(); ++i) {
+            if (!cullVisibility[i]) { continue; }
+
+            const Vector3 center { cullSpheres[0][i], cullSpheres[1][i], cullSpheres[2][i] };
+            const Vector3 radius { cullSpheres[3][i], cullSpheres[3][i], cullSpheres[3][i] };
+            occludees.push_back(i);
+            occludeeBounds.push_back({ center - radius, center + radius });
+        }
+
+        occludeeVisibility.resize(occludees.size());
+        const size_t unoccluded = occlusion->TestVisibility(occludeeBounds.data(), occludeeVisibility.data(), occludees.size());
+        for (size_t i = 0; i < occludees.size(); ++i) {
+            cullVisibility[occludees[i]] = occludeeVisibility[i];
+        }
+
+        stats.occluded += static_cast<uint32_t>(visible - unoccluded);
+        visible = unoccluded;
+    }
+
+    for (size_t i = 0; i < cullCandidates.size(); ++i) {
+        if (cullVisibility[i]) { cullCandidates[i]->Draw(); }
+    }
+
+    stats.total   += unbounded + static_cast<uint32_t>(cullCandidates.size());
+    stats.visible += unbounded + static_cast<uint32_t>(visible);
+}
 void Layer::SetProjectionMatrix(Matrix4& mtx) {
-    for (Entity* entity : entities) {
+    for (EntityHandle handle : entities) {
+        Entity* entity = handle.Get();
+        if (!entity) { continue; }
         for (IDrawable* drawable : entity->components.drawables) {
             drawable->SetProjectionMatrix(mtx);
         }
     }
 }
 void Layer::SetTransformMatrix(Matrix4& mtx) {
-    for (Entity* entity : entities) {
+    for (EntityHandle handle : entities) {
+        Entity* entity = handle.Get();
+        if (!entity) { continue; }
         for (IDrawable* drawable : entity->components.drawables) {
             drawable->SetTransformMatrix(mtx);
         }
     }
 }
 void Layer::SetLight(Light& light) {
-    for (Entity* entity : entities) {
+    for (EntityHandle handle : entities) {
+        Entity* entity = handle.Get();
+        if (!entity) { continue; }
         for (IDrawable* drawable : entity->components.drawables) {
             drawable->SetLight(light);
         }
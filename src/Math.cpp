@@ -0,0 +1,521 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <core/Math.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define CORE_MATH_X86
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #include <intrin.h>
+        #define CORE_MATH_TARGET(isa)
+    #else
+        #define CORE_MATH_TARGET(isa) __attribute__((target(isa)))
+    #endif
+#endif
+
+namespace core {
+
+namespace Math {
+
+namespace {
+
+/*
+ * Scalar kernels, also used for the remainders of SIMD kernels.
+ * Operations are kept in the same order as in SIMD kernels, so results match bit for bit
+ */
+void ComposeTransformsScalar(const TransformArrays& in, Matrix4* output, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const float x = in.rotation[0][i], y = in.rotation[1][i], z = in.rotation[2][i], w = in.rotation[3][i];
+        const float xx = x * x, yy = y * y, zz = z * z;
+        const float xy = x * y, xz = x * z, yz = y * z;
+        const float xw = x * w, yw = y * w, zw = z * w;
+        const float sx = in.scale[0][i], sy = in.scale[1][i], sz = in.scale[2][i];
+
+        float* m = output[i].data();
+        m[0]  = (1.0f - 2.0f * (yy + zz)) * sx;
+        m[1]  = 2.0f * (xy + zw) * sx;
+        m[2]  = 2.0f * (xz - yw) * sx;
+        m[3]  = 0.0f;
+        m[4]  = 2.0f * (xy - zw) * sy;
+        m[5]  = (1.0f - 2.0f * (xx + zz)) * sy;
+        m[6]  = 2.0f * (yz + xw) * sy;
+        m[7]  = 0.0f;
+        m[8]  = 2.0f * (xz + yw) * sz;
+        m[9]  = 2.0f * (yz - xw) * sz;
+        m[10] = (1.0f - 2.0f * (xx + yy)) * sz;
+        m[11] = 0.0f;
+        m[12] = in.position[0][i];
+        m[13] = in.position[1][i];
+        m[14] = in.position[2][i];
+        m[15] = 1.0f;
+    }
+}
+
+void MultiplyScalar(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        output[i] = lhs[i] * rhs[i];
+    }
+}
+
+void ExtractNormalMatricesScalar(const Matrix4* transforms, Matrix3x3* output, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        output[i] = transforms[i].normalMatrix();
+    }
+}
+
+void NormalizeQuaternionsScalar(float* x, float* y, float* z, float* w, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const float length = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + w[i] * w[i]);
+        x[i] /= length;
+        y[i] /= length;
+        z[i] /= length;
+        w[i] /= length;
+    }
+}
+
+/** Frustum planes with unit normals, one array per component */
+struct FrustumPlanes {
+    float x[6];
+    float y[6];
+    float z[6];
+    float w[6];
+};
+
+size_t CullSpheresScalar(const FrustumPlanes& planes, const SphereArrays& in, uint8_t* visible, size_t begin, size_t end) {
+    size_t visibleCount = 0;
+    for (size_t i = begin; i < end; ++i) {
+        const float x = in.center[0][i], y = in.center[1][i], z = in.center[2][i];
+        const float negativeRadius = -in.radius[i];
+
+        bool inside = true;
+        for (int p = 0; p < 6; ++p) {
+            const float distance = planes.x[p] * x + planes.y[p] * y + planes.z[p] * z + planes.w[p];
+            inside = inside && distance >= negativeRadius;
+        }
+        visible[i] = inside ? 1 : 0;
+        visibleCount += visible[i];
+    }
+    return visibleCount;
+}
+
+#ifdef CORE_MATH_X86
+
+/**
+ * Stores column of 4 consecutive matrices, given as its rows across the matrices
+ */
+CORE_MATH_TARGET("sse4.1")
+inline void StoreColumn(float* matrices, size_t column, __m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_storeu_ps(matrices + 0  + column * 4, r0);
+    _mm_storeu_ps(matrices + 16 + column * 4, r1);
+    _mm_storeu_ps(matrices + 32 + column * 4, r2);
+    _mm_storeu_ps(matrices + 48 + column * 4, r3);
+}
+
+CORE_MATH_TARGET("sse4.1")
+void ComposeTransformsSSE41(const TransformArrays& in, Matrix4* output, size_t count) {
+    const __m128 one  = _mm_set1_ps(1.0f);
+    const __m128 two  = _mm_set1_ps(2.0f);
+    const __m128 zero = _mm_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(in.rotation[0] + i), y = _mm_loadu_ps(in.rotation[1] + i);
+        const __m128 z = _mm_loadu_ps(in.rotation[2] + i), w = _mm_loadu_ps(in.rotation[3] + i);
+        const __m128 xx = _mm_mul_ps(x, x), yy = _mm_mul_ps(y, y), zz = _mm_mul_ps(z, z);
+        const __m128 xy = _mm_mul_ps(x, y), xz = _mm_mul_ps(x, z), yz = _mm_mul_ps(y, z);
+        const __m128 xw = _mm_mul_ps(x, w), yw = _mm_mul_ps(y, w), zw = _mm_mul_ps(z, w);
+        const __m128 sx = _mm_loadu_ps(in.scale[0] + i), sy = _mm_loadu_ps(in.scale[1] + i);
+        const __m128 sz = _mm_loadu_ps(in.scale[2] + i);
+
+        float* matrices = output[i].data();
+        StoreColumn(matrices, 0,
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, zw)), sx),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, yw)), sx),
+                    zero);
+        StoreColumn(matrices, 1,
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, zw)), sy),
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, xw)), sy),
+                    zero);
+        StoreColumn(matrices, 2,
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, yw)), sz),
+                    _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, xw)), sz),
+                    _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+                    zero);
+        StoreColumn(matrices, 3,
+                    _mm_loadu_ps(in.position[0] + i),
+                    _mm_loadu_ps(in.position[1] + i),
+                    _mm_loadu_ps(in.position[2] + i),
+                    one);
+    }
+    ComposeTransformsScalar(in, output, i, count);
+}
+
+CORE_MATH_TARGET("sse4.1")
+void MultiplySSE41(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float* a = lhs[i].data();
+        const float* b = rhs[i].data();
+        float*       o = output[i].data();
+
+        const __m128 a0 = _mm_loadu_ps(a),     a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+
+        /* Column j of the product only reads column j of rhs, so output may alias rhs */
+        for (size_t j = 0; j < 16; j += 4) {
+            const __m128 column = _mm_loadu_ps(b + j);
+            __m128 result = _mm_mul_ps(a0, _mm_shuffle_ps(column, column, 0x00));
+            result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_shuffle_ps(column, column, 0x55)));
+            result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_shuffle_ps(column, column, 0xAA)));
+            result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_shuffle_ps(column, column, 0xFF)));
+            _mm_storeu_ps(o + j, result);
+        }
+    }
+}
+
+CORE_MATH_TARGET("sse4.1")
+void ExtractNormalMatricesSSE41(const Matrix4* transforms, Matrix3x3* output, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const float* m = transforms[i].data();
+
+        /* Gather columns of 4 matrices, so every vector holds one component across the matrices */
+        __m128 ax = _mm_loadu_ps(m),      ay = _mm_loadu_ps(m + 16), az = _mm_loadu_ps(m + 32), aw = _mm_loadu_ps(m + 48);
+        __m128 bx = _mm_loadu_ps(m + 4),  by = _mm_loadu_ps(m + 20), bz = _mm_loadu_ps(m + 36), bw = _mm_loadu_ps(m + 52);
+        __m128 cx = _mm_loadu_ps(m + 8),  cy = _mm_loadu_ps(m + 24), cz = _mm_loadu_ps(m + 40), cw = _mm_loadu_ps(m + 56);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+        _MM_TRANSPOSE4_PS(cx, cy, cz, cw);
+
+        /* Cofactor matrix columns are b x c, c x a and a x b */
+        alignas(16) float columns[9][4];
+        _mm_store_ps(columns[0], _mm_sub_ps(_mm_mul_ps(by, cz), _mm_mul_ps(bz, cy)));
+        _mm_store_ps(columns[1], _mm_sub_ps(_mm_mul_ps(bz, cx), _mm_mul_ps(bx, cz)));
+        _mm_store_ps(columns[2], _mm_sub_ps(_mm_mul_ps(bx, cy), _mm_mul_ps(by, cx)));
+        _mm_store_ps(columns[3], _mm_sub_ps(_mm_mul_ps(cy, az), _mm_mul_ps(cz, ay)));
+        _mm_store_ps(columns[4], _mm_sub_ps(_mm_mul_ps(cz, ax), _mm_mul_ps(cx, az)));
+        _mm_store_ps(columns[5], _mm_sub_ps(_mm_mul_ps(cx, ay), _mm_mul_ps(cy, ax)));
+        _mm_store_ps(columns[6], _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+        _mm_store_ps(columns[7], _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+        _mm_store_ps(columns[8], _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+
+        for (size_t k = 0; k < 4; ++k) {
+            float* o = output[i + k].data();
+            for (size_t e = 0; e < 9; ++e) {
+                o[e] = columns[e][k];
+            }
+        }
+    }
+    ExtractNormalMatricesScalar(transforms, output, i, count);
+}
+
+CORE_MATH_TARGET("sse4.1")
+void NormalizeQuaternionsSSE41(float* x, float* y, float* z, float* w, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 qx = _mm_loadu_ps(x + i), qy = _mm_loadu_ps(y + i);
+        const __m128 qz = _mm_loadu_ps(z + i), qw = _mm_loadu_ps(w + i);
+
+        __m128 dot = _mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy));
+        dot = _mm_add_ps(dot, _mm_mul_ps(qz, qz));
+        dot = _mm_add_ps(dot, _mm_mul_ps(qw, qw));
+        const __m128 length = _mm_sqrt_ps(dot);
+
+        _mm_storeu_ps(x + i, _mm_div_ps(qx, length));
+        _mm_storeu_ps(y + i, _mm_div_ps(qy, length));
+        _mm_storeu_ps(z + i, _mm_div_ps(qz, length));
+        _mm_storeu_ps(w + i, _mm_div_ps(qw, length));
+    }
+    NormalizeQuaternionsScalar(x, y, z, w, i, count);
+}
+
+CORE_MATH_TARGET("sse4.1")
+size_t CullSpheresSSE41(const FrustumPlanes& planes, const SphereArrays& in, uint8_t* visible, size_t count) {
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+
+    size_t i = 0;
+    size_t visibleCount = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128 x = _mm_loadu_ps(in.center[0] + i);
+        const __m128 y = _mm_loadu_ps(in.center[1] + i);
+        const __m128 z = _mm_loadu_ps(in.center[2] + i);
+        const __m128 negativeRadius = _mm_xor_ps(_mm_loadu_ps(in.radius + i), signMask);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.x[p]), x), _mm_mul_ps(_mm_set1_ps(planes.y[p]), y));
+            distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(planes.z[p]), z));
+            distance = _mm_add_ps(distance, _mm_set1_ps(planes.w[p]));
+            inside   = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeRadius));
+        }
+
+        const int mask = _mm_movemask_ps(inside);
+        for (size_t lane = 0; lane < 4; ++lane) {
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+            visibleCount += visible[i + lane];
+        }
+    }
+    return visibleCount + CullSpheresScalar(planes, in, visible, i, count);
+}
+
+CORE_MATH_TARGET("avx2")
+void ComposeTransformsAVX2(const TransformArrays& in, Matrix4* output, size_t count) {
+    const __m256 one  = _mm256_set1_ps(1.0f);
+    const __m256 two  = _mm256_set1_ps(2.0f);
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(in.rotation[0] + i), y = _mm256_loadu_ps(in.rotation[1] + i);
+        const __m256 z = _mm256_loadu_ps(in.rotation[2] + i), w = _mm256_loadu_ps(in.rotation[3] + i);
+        const __m256 xx = _mm256_mul_ps(x, x), yy = _mm256_mul_ps(y, y), zz = _mm256_mul_ps(z, z);
+        const __m256 xy = _mm256_mul_ps(x, y), xz = _mm256_mul_ps(x, z), yz = _mm256_mul_ps(y, z);
+        const __m256 xw = _mm256_mul_ps(x, w), yw = _mm256_mul_ps(y, w), zw = _mm256_mul_ps(z, w);
+        const __m256 sx = _mm256_loadu_ps(in.scale[0] + i), sy = _mm256_loadu_ps(in.scale[1] + i);
+        const __m256 sz = _mm256_loadu_ps(in.scale[2] + i);
+
+        /* Rows of every column across 8 matrices, last row is constant */
+        const __m256 rows[4][3] = {
+            { _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(yy, zz))), sx),
+              _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xy, zw)), sx),
+              _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xz, yw)), sx) },
+            { _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(xy, zw)), sy),
+              _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, zz))), sy),
+              _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(yz, xw)), sy) },
+            { _mm256_mul_ps(_mm256_mul_ps(two, _mm256_add_ps(xz, yw)), sz),
+              _mm256_mul_ps(_mm256_mul_ps(two, _mm256_sub_ps(yz, xw)), sz),
+              _mm256_mul_ps(_mm256_sub_ps(one, _mm256_mul_ps(two, _mm256_add_ps(xx, yy))), sz) },
+            { _mm256_loadu_ps(in.position[0] + i),
+              _mm256_loadu_ps(in.position[1] + i),
+              _mm256_loadu_ps(in.position[2] + i) }
+        };
+
+        float* matrices = output[i].data();
+        for (size_t column = 0; column < 4; ++column) {
+            const __m128 last = column == 3 ? _mm_set1_ps(1.0f) : _mm_setzero_ps();
+            StoreColumn(matrices, column,
+                        _mm256_castps256_ps128(rows[column][0]),
+                        _mm256_castps256_ps128(rows[column][1]),
+                        _mm256_castps256_ps128(rows[column][2]),
+                        last);
+            StoreColumn(matrices + 64, column,
+                        _mm256_extractf128_ps(rows[column][0], 1),
+                        _mm256_extractf128_ps(rows[column][1], 1),
+                        _mm256_extractf128_ps(rows[column][2], 1),
+                        last);
+        }
+    }
+    ComposeTransformsScalar(in, output, i, count);
+}
+
+CORE_MATH_TARGET("avx2")
+void MultiplyAVX2(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const float* a = lhs[i].data();
+        const float* b = rhs[i].data();
+        float*       o = output[i].data();
+
+        /* Both halves hold the same lhs column, so two product columns are computed at once */
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 4));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 8));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(a + 12));
+
+        for (size_t j = 0; j < 16; j += 8) {
+            const __m256 columns = _mm256_loadu_ps(b + j);
+            __m256 result = _mm256_mul_ps(a0, _mm256_shuffle_ps(columns, columns, 0x00));
+            result = _mm256_add_ps(result, _mm256_mul_ps(a1, _mm256_shuffle_ps(columns, columns, 0x55)));
+            result = _mm256_add_ps(result, _mm256_mul_ps(a2, _mm256_shuffle_ps(columns, columns, 0xAA)));
+            result = _mm256_add_ps(result, _mm256_mul_ps(a3, _mm256_shuffle_ps(columns, columns, 0xFF)));
+            _mm256_storeu_ps(o + j, result);
+        }
+    }
+}
+
+CORE_MATH_TARGET("avx2")
+void NormalizeQuaternionsAVX2(float* x, float* y, float* z, float* w, size_t count) {
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 qx = _mm256_loadu_ps(x + i), qy = _mm256_loadu_ps(y + i);
+        const __m256 qz = _mm256_loadu_ps(z + i), qw = _mm256_loadu_ps(w + i);
+
+        __m256 dot = _mm256_add_ps(_mm256_mul_ps(qx, qx), _mm256_mul_ps(qy, qy));
+        dot = _mm256_add_ps(dot, _mm256_mul_ps(qz, qz));
+        dot = _mm256_add_ps(dot, _mm256_mul_ps(qw, qw));
+        const __m256 length = _mm256_sqrt_ps(dot);
+
+        _mm256_storeu_ps(x + i, _mm256_div_ps(qx, length));
+        _mm256_storeu_ps(y + i, _mm256_div_ps(qy, length));
+        _mm256_storeu_ps(z + i, _mm256_div_ps(qz, length));
+        _mm256_storeu_ps(w + i, _mm256_div_ps(qw, length));
+    }
+    NormalizeQuaternionsScalar(x, y, z, w, i, count);
+}
+
+CORE_MATH_TARGET("avx2")
+size_t CullSpheresAVX2(const FrustumPlanes& planes, const SphereArrays& in, uint8_t* visible, size_t count) {
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+    size_t i = 0;
+    size_t visibleCount = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256 x = _mm256_loadu_ps(in.center[0] + i);
+        const __m256 y = _mm256_loadu_ps(in.center[1] + i);
+        const __m256 z = _mm256_loadu_ps(in.center[2] + i);
+        const __m256 negativeRadius = _mm256_xor_ps(_mm256_loadu_ps(in.radius + i), signMask);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m256 distance = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.x[p]), x), _mm256_mul_ps(_mm256_set1_ps(planes.y[p]), y));
+            distance = _mm256_add_ps(distance, _mm256_mul_ps(_mm256_set1_ps(planes.z[p]), z));
+            distance = _mm256_add_ps(distance, _mm256_set1_ps(planes.w[p]));
+            inside   = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeRadius, _CMP_GE_OQ));
+        }
+
+        const int mask = _mm256_movemask_ps(inside);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            visible[i + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+            visibleCount += visible[i + lane];
+        }
+    }
+    return visibleCount + CullSpheresScalar(planes, in, visible, i, count);
+}
+
+SimdLevel DetectSimdLevel() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    const bool sse41   = (info[2] & (1 << 19)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx     = (info[2] & (1 << 28)) != 0;
+
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse41 = __builtin_cpu_supports("sse4.1");
+    const bool avx2  = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2)  { return SimdLevel::AVX2; }
+    if (sse41) { return SimdLevel::SSE41; }
+    return SimdLevel::Scalar;
+}
+
+#else
+
+SimdLevel DetectSimdLevel() {
+    return SimdLevel::Scalar;
+}
+
+#endif
+
+SimdLevel& ActiveSimdLevel() {
+    static SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+}
+
+SimdLevel GetSimdLevel() {
+    return ActiveSimdLevel();
+}
+void SetSimdLevel(SimdLevel level) {
+    static const SimdLevel supported = DetectSimdLevel();
+    ActiveSimdLevel() = std::min(level, supported);
+}
+void ComposeTransforms(const TransformArrays& input, Matrix4* output, size_t count) {
+#ifdef CORE_MATH_X86
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX2:  ComposeTransformsAVX2(input, output, count);  return;
+        case SimdLevel::SSE41: ComposeTransformsSSE41(input, output, count); return;
+        default: break;
+    }
+#endif
+    ComposeTransformsScalar(input, output, 0, count);
+}
+void Multiply(const Matrix4* lhs, const Matrix4* rhs, Matrix4* output, size_t count) {
+#ifdef CORE_MATH_X86
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX2:  MultiplyAVX2(lhs, rhs, output, count);  return;
+        case SimdLevel::SSE41: MultiplySSE41(lhs, rhs, output, count); return;
+        default: break;
+    }
+#endif
+    MultiplyScalar(lhs, rhs, output, 0, count);
+}
+void ExtractNormalMatrices(const Matrix4* transforms, Matrix3x3* output, size_t count) {
+#ifdef CORE_MATH_X86
+    /* Gathering columns dominates here, wider registers do not pay off, so AVX2 uses SSE4.1 kernel */
+    if (GetSimdLevel() != SimdLevel::Scalar) {
+        ExtractNormalMatricesSSE41(transforms, output, count);
+        return;
+    }
+#endif
+    ExtractNormalMatricesScalar(transforms, output, 0, count);
+}
+void NormalizeQuaternions(float* x, float* y, float* z, float* w, size_t count) {
+#ifdef CORE_MATH_X86
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX2:  NormalizeQuaternionsAVX2(x, y, z, w, count);  return;
+        case SimdLevel::SSE41: NormalizeQuaternionsSSE41(x, y, z, w, count); return;
+        default: break;
+    }
+#endif
+    NormalizeQuaternionsScalar(x, y, z, w, 0, count);
+}
+size_t CullSpheres(const Frustum& frustum, const SphereArrays& spheres, uint8_t* visible, size_t count) {
+    /* Unit normals make plane distances comparable with radii */
+    FrustumPlanes planes;
+    for (int p = 0; p < 6; ++p) {
+        const Vector4 plane  = frustum[p];
+        const float   length = plane.xyz().length();
+        planes.x[p] = plane.x() / length;
+        planes.y[p] = plane.y() / length;
+        planes.z[p] = plane.z() / length;
+        planes.w[p] = plane.w() / length;
+    }
+
+#ifdef CORE_MATH_X86
+    switch (GetSimdLevel()) {
+        case SimdLevel::AVX2:  return CullSpheresAVX2(planes, spheres, visible, count);
+        case SimdLevel::SSE41: return CullSpheresSSE41(planes, spheres, visible, count);
+        default: break;
+    }
+#endif
+    return CullSpheresScalar(planes, spheres, visible, 0, count);
+}
+
+} // namespace Math
+
+} // namespace core
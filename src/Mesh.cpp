@@ -23,6 +23,11 @@
  */
 #include <core/Mesh.h>
 
+#include <Corrade/Containers/Array.h>
+
+#include <algorithm>
+#include <cmath>
+
 namespace core {
 
 GL::Mesh* Mesh::GetGLMesh() {
@@ -33,5 +38,43 @@ Mesh::Mesh(const GL::Mesh* glMesh)
 {
 
 }
+Mesh::Mesh(const GL::Mesh* glMesh, const Range3D& bounds, float radius)
+: mesh(const_cast<GL::Mesh*>(glMesh)),
+  bounds(bounds),
+  radius(radius)
+{
 
-}
\ No newline at end of file
+}
+bool Mesh::HasBounds() const {
+    return radius >= 0.0f;
+}
+const Range3D& Mesh::GetBounds() const {
+    return bounds;
+}
+float Mesh::GetBoundingRadius() const {
+    return radius;
+}
+bool Mesh::ComputeBounds(const Trade::MeshData& data, Range3D& bounds, float& radius) {
+    if (!data.hasAttribute(Trade::MeshAttribute::Position) || data.vertexCount() == 0) { return false; }
+
+    const Containers::Array<Vector3> positions = data.positions3DAsArray();
+
+    Vector3 min = positions[0];
+    Vector3 max = positions[0];
+    for (const Vector3& position : positions) {
+        min = Math::min(min, position);
+        max = Math::max(max, position);
+    }
+    bounds = { min, max };
+
+    /* Sphere around the box center, tighter than the box diagonal for round meshes */
+    const Vector3 center = bounds.center();
+    float radiusSquared = 0.0f;
+    for (const Vector3& position : positions) {
+        radiusSquared = std::max(radiusSquared, (position - center).dot());
+    }
+    radius = std::sqrt(radiusSquared);
+    return true;
+}
+
+}
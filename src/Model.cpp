@@ -54,8 +54,8 @@ void Model::Draw() {
 void Model::SetProjectionMatrix(Matrix4& mtx) {
     projectionUniform.setData({ Shaders::ProjectionUniform3D{ }.setProjectionMatrix(mtx) });
 }
-void Model::SetNormalMatrix(Matrix4& mtx) {
-    drawUniform.setData({ Shaders::PhongDrawUniform{ }.setNormalMatrix(mtx.normalMatrix()) });
+void Model::SetNormalMatrix(const Matrix3x3& mtx) {
+    drawUniform.setData({ Shaders::PhongDrawUniform{ }.setNormalMatrix(mtx) });
 }
 void Model::SetTransformMatrix(Matrix4& mtx) {
     transformUniform.setData({ Shaders::TransformationUniform3D{ }.setTransformationMatrix(mtx) });
@@ -0,0 +1,129 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <core/NameTable.h>
+#include <core/Logger.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace core {
+
+namespace {
+
+/* Block k holds firstBlockSize << k names, so blockCount blocks cover every NameId */
+constexpr size_t firstBlockSize = 1024;
+constexpr size_t blockCount     = 23;
+
+struct Table {
+    /* Names are read without locking, blocks never move and size is advanced only after a name is stored */
+    std::atomic<string*> blocks[blockCount] { };
+    std::atomic<NameId>  size { 0 };
+
+    /* Guards ids and adding names, keys view the stored names */
+    std::mutex mutex;
+    std::unordered_map<std::string_view, NameId> ids;
+};
+
+/* Recently interned names of the calling thread, trivially destructible so it is usable during static destruction */
+struct CacheSlot {
+    size_t hash;
+    NameId id;
+};
+constexpr size_t cacheSize = 64;
+thread_local CacheSlot cache[cacheSize] { };
+
+/** Finds block holding name id and position of the name in it */
+void Locate(NameId id, size_t& block, uint64_t& offset) {
+    const uint64_t first = static_cast<uint64_t>(id) / firstBlockSize + 1;
+    block = 0;
+    while ((first >> (block + 1)) != 0) { ++block; }
+    offset = id - firstBlockSize * ((uint64_t(1) << block) - 1);
+}
+
+string& At(Table& table, NameId id) {
+    size_t block; uint64_t offset;
+    Locate(id, block, offset);
+    return table.blocks[block].load(std::memory_order_acquire)[offset];
+}
+
+/** Stores name under the next id, table has to be locked */
+NameId Add(Table& table, const string& name) {
+    const NameId id = table.size.load(std::memory_order_relaxed);
+
+    size_t block; uint64_t offset;
+    Locate(id, block, offset);
+    if (!table.blocks[block].load(std::memory_order_relaxed)) {
+        table.blocks[block].store(new string[firstBlockSize << block], std::memory_order_release);
+    }
+
+    string& stored = table.blocks[block].load(std::memory_order_relaxed)[offset];
+    stored = name;
+    table.ids.emplace(stored, id);
+    table.size.store(id + 1, std::memory_order_release);
+    return id;
+}
+
+// Intentionally never destroyed: objects owned by static containers read their names at static destruction
+Table& GetTable() {
+    static auto* table = [] {
+        auto* created = new Table();
+        Add(*created, "");
+        return created;
+    }();
+    return *table;
+}
+
+} // namespace
+
+NameId NameTable::Intern(const string& name) {
+    if (name.empty()) { return 0; }
+
+    Table& table = GetTable();
+    const size_t hash = std::hash<string>()(name);
+    CacheSlot& slot = cache[hash % cacheSize];
+    if (slot.id != 0 && slot.hash == hash && At(table, slot.id) == name) { return slot.id; }
+
+    NameId id;
+    {
+        std::lock_guard<std::mutex> lock(table.mutex);
+        auto it = table.ids.find(name);
+        id = it != table.ids.end() ? it->second : Add(table, name);
+    }
+    slot = { hash, id };
+    return id;
+}
+const string& NameTable::Get(NameId id) {
+    Table& table = GetTable();
+    if (id >= table.size.load(std::memory_order_acquire)) {
+        Logger::Log(INTERNAL, ERR_HERE) << "Name id " << id << " is not in the name table";
+        throw std::out_of_range("Name id " + std::to_string(id) + " is not in the name table");
+    }
+    return At(table, id);
+}
+
+}
@@ -29,27 +29,31 @@ namespace core {
 
 std::atomic<uint32_t> Object::objectCounter { 0 };
 
-Object::Object(string name) noexcept
-: name(std::move(name)), id(++objectCounter)
+Object::Object(const string& name)
+: nameId(NameTable::Intern(name)), id(++objectCounter)
 {
-    Logger::Log(OBJECT, INFO) << "Created object " << GetInfo();
+#ifdef CORE_TRACE_LIFECYCLE
+    Logger::Log(OBJECT, DEBUG) << "Created object " << GetInfo();
+#endif
 }
 Object::Object(Object &&other) noexcept
-: name(std::move(other.name)), id(other.id)
+: nameId(other.nameId), id(other.id)
 {
     other.id = 0;
 }
 Object::~Object() {
+#ifdef CORE_TRACE_LIFECYCLE
     // id == 0 means that object was moved, no need to log destruction
     if (id != 0) {
-        Logger::Log(OBJECT, INFO) << "Destroyed object " << GetInfo();
+        Logger::Log(OBJECT, DEBUG) << "Destroyed object " << GetInfo();
     }
+#endif
 }
 uint32_t Object::GetId() const {
     return id;
 }
 string Object::GetInfo() const {
-    return "\"" + name + "\""  + " ID(" + std::to_string(GetId()) + ")";
+    return "\"" + GetName() + "\""  + " ID(" + std::to_string(GetId()) + ")";
 }
 bool Object::operator==(const Object &rhs) const {
     return id == rhs.id;
@@ -59,15 +63,20 @@ bool Object::operator!=(const Object &rhs) const {
 }
 Object& Object::operator=(Object &&other) noexcept {
     if (this != &other) {
-        Logger::Log(OBJECT, INFO) << "Object " << other.GetInfo() << " was moved into " << this->GetInfo();
+#ifdef CORE_TRACE_LIFECYCLE
+        Logger::Log(OBJECT, DEBUG) << "Object " << other.GetInfo() << " was moved into " << this->GetInfo();
+#endif
         id = other.id;
         other.id = 0;
-        name = std::move(other.name);
+        nameId = other.nameId;
     }
     return *this;
 }
-const string& Object::GetName() {
-    return name;
+const string& Object::GetName() const {
+    return NameTable::Get(nameId);
+}
+NameId Object::GetNameId() const {
+    return nameId;
 }
 
-}
\ No newline at end of file
+}
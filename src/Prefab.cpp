@@ -0,0 +1,57 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <core/Prefab.h>
+#include <core/Entity.h>
+
+#include <utility>
+
+namespace core {
+
+Prefab::Prefab(string name, string layer)
+: name(std::move(name)), layer(std::move(layer))
+{
+
+}
+void Prefab::Build(Entity& entity) const {
+    for (const auto& builder : builders) {
+        builder(entity);
+    }
+}
+void Prefab::Reserve(size_t count) const {
+    for (const auto& reservation : reservations) {
+        reservation(count);
+    }
+}
+size_t Prefab::Size() const {
+    return builders.size();
+}
+const string& Prefab::GetName() const {
+    return name;
+}
+const string& Prefab::GetLayer() const {
+    return layer;
+}
+
+} // namespace core
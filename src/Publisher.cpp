@@ -23,40 +23,79 @@
  */
 #include <core/Publisher.h>
 
+#include <cstring>
+
 namespace core {
 
-void Publisher::SubscribeTo(const char* name, const std::function<void()>& callback) {
-    if ( !this->HasEvent(name) ) {
-        Logger::Log(GENERAL, ERR_HERE) << "Publisher does not have GetEvent \"" << name << "\"";
-        throw std::runtime_error("Publisher does not have GetEvent \"" + string(name) + "\"");
+void Publisher::SubscribeTo(EventId id, const std::function<void()>& callback) {
+    event* e = FindEvent(id);
+    if (!e) {
+        Logger::Log(GENERAL, ERR_HERE) << "Publisher does not have GetEvent \"" << id.name << "\"";
+        throw std::runtime_error("Publisher does not have GetEvent \"" + string(id.name) + "\"");
     }
 
-    auto e = std::find_if(eventList.begin(), eventList.end(), [&](event& e) { return e.first == name; } );
-    e->second.emplace_back(callback);
+    e->callbacks.emplace_back(callback);
 }
-void Publisher::AddEvent(const string& name) {
-    if (this->HasEvent(name)) {
-        Logger::Log(GENERAL, WARN_HERE) << "Cannot add new GetEvent \"" << name << "\" to publisher: GetEvent with same name already exists";
+void Publisher::AddEvent(EventId id) {
+    if (const event* e = FindEvent(id)) {
+        if (std::strcmp(e->name, id.name) != 0) {
+            Logger::Log(GENERAL, ERR_HERE) << "GetEvent \"" << id.name << "\" hash collides with \"" << e->name << "\"";
+            throw std::logic_error("GetEvent \"" + string(id.name) + "\" hash collides with \"" + string(e->name) + "\"");
+        }
+        Logger::Log(GENERAL, WARN_HERE) << "Cannot add new GetEvent \"" << id.name << "\" to publisher: GetEvent with same name already exists";
         return;
     }
 
-    eventList.emplace_back(name, callbackList { });
+    if ((eventCount + 1) * 2 > eventList.size()) { Grow(); }
+
+    const size_t mask = eventList.size() - 1;
+    size_t slot = id.hash & mask;
+    while (eventList[slot].hash != 0) { slot = (slot + 1) & mask; }
+
+    eventList[slot].hash = id.hash;
+    eventList[slot].name = id.name;
+    ++eventCount;
 }
-bool Publisher::HasEvent(const string &name) {
-    auto a = std::find_if(eventList.begin(), eventList.end(), [&](event& e) { return e.first == name; } );
-    return a != eventList.end() ? true : false;
+bool Publisher::HasEvent(EventId id) const {
+    return FindEvent(id) != nullptr;
 }
-void Publisher::Trigger(const string& name) {
-    if ( !this->HasEvent(name) ) {
-        Logger::Log(GENERAL, ERR_HERE) << "Publisher does not have GetEvent \"" << name << "\"";
-        throw std::runtime_error("Publisher does not have GetEvent \"" + name + "\"");
+void Publisher::Trigger(EventId id) {
+    event* e = FindEvent(id);
+    if (!e) {
+        Logger::Log(GENERAL, ERR_HERE) << "Publisher does not have GetEvent \"" << id.name << "\"";
+        throw std::runtime_error("Publisher does not have GetEvent \"" + string(id.name) + "\"");
     }
 
-    auto e = std::find_if(eventList.begin(), eventList.end(), [&](event& e) { return e.first == name; } );
-    for (const auto& callback : e->second) {
+    for (const auto& callback : e->callbacks) {
         callback();
     }
 }
+Publisher::event* Publisher::FindEvent(EventId id) {
+    return const_cast<event*>(static_cast<const Publisher*>(this)->FindEvent(id));
+}
+const Publisher::event* Publisher::FindEvent(EventId id) const {
+    if (eventList.empty()) { return nullptr; }
+
+    /* Table is never full, so probing always reaches an empty slot */
+    const size_t mask = eventList.size() - 1;
+    for (size_t slot = id.hash & mask; eventList[slot].hash != 0; slot = (slot + 1) & mask) {
+        if (eventList[slot].hash == id.hash) { return &eventList[slot]; }
+    }
+    return nullptr;
+}
+void Publisher::Grow() {
+    std::vector<event> old = std::move(eventList);
+    eventList = std::vector<event>(old.empty() ? 8 : old.size() * 2);
+
+    const size_t mask = eventList.size() - 1;
+    for (event& e : old) {
+        if (e.hash == 0) { continue; }
+
+        size_t slot = e.hash & mask;
+        while (eventList[slot].hash != 0) { slot = (slot + 1) & mask; }
+        eventList[slot] = std::move(e);
+    }
+}
 
 
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <core/Query.h>
+
+namespace core {
+
+IQuery::IQuery() {
+    Instances().push_back(this);
+}
+vector<IQuery*>& IQuery::Instances() {
+    // Intentionally never destroyed, same as queries themselves
+    static vector<IQuery*>* instances = new vector<IQuery*>();
+    return *instances;
+}
+const ComponentSignature& IQuery::GetSignature() const {
+    return signature;
+}
+void IQuery::SignatureChanged(Entity& entity, const ComponentSignature& previous) {
+    const ComponentSignature& current = entity.GetSignature();
+
+    for (IQuery* query : Instances()) {
+        const bool matched = previous.Contains(query->signature);
+        const bool matches = current.Contains(query->signature);
+
+        if (matches && !matched) { query->Insert(entity); }
+        if (matched && !matches) { query->Erase(entity); }
+    }
+}
+void IQuery::EntityDestroyed(Entity& entity) {
+    const ComponentSignature& current = entity.GetSignature();
+
+    for (IQuery* query : Instances()) {
+        if (current.Contains(query->signature)) { query->Erase(entity); }
+    }
+}
+
+} // namespace core
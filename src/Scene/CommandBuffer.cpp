@@ -0,0 +1,155 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <core/Scene/CommandBuffer.h>
+#include <core/Entity.h>
+#include <core/Layer.h>
+#include <core/Logger.h>
+
+#include <exception>
+
+namespace core {
+
+vector<unique<CommandBuffer>> CommandBuffer::buffers { };
+std::mutex                    CommandBuffer::buffersMutex { };
+
+CommandBuffer& CommandBuffer::Get() {
+    thread_local CommandBuffer* buffer = nullptr;
+
+    if (!buffer) {
+        std::lock_guard<std::mutex> guard(buffersMutex);
+        buffers.push_back(unique<CommandBuffer>(new CommandBuffer()));
+        buffer = buffers.back().get();
+    }
+    return *buffer;
+}
+void CommandBuffer::PlaybackAll() {
+    std::lock_guard<std::mutex> guard(buffersMutex);
+
+    /** Destroyed entities are removed from layers in one pass, after all commands */
+    Layer::DeferUnlink(true);
+    std::exception_ptr failure;
+    for (auto& buffer : buffers) {
+        try {
+            buffer->Playback();
+        } catch (...) {
+            if (!failure) { failure = std::current_exception(); }
+        }
+    }
+    Layer::DeferUnlink(false);
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+DeferredEntity CommandBuffer::Spawn(const string& name, EntityHandle parent, const string& layer) {
+    std::lock_guard<std::mutex> guard(mutex);
+    const DeferredEntity entity { spawnCount++ };
+
+    commands.emplace_back([name, parent, layer](CommandBuffer& buffer) {
+        /** Slot is taken first, so a skipped or failed spawn keeps later indices in place */
+        const size_t slot = buffer.spawned.size();
+        buffer.spawned.emplace_back();
+
+        if (parent.index == EntityHandle::invalidIndex) {
+            buffer.spawned[slot] = Entity::Spawn(name, Scene::Get("Default")->Root()->GetHandle(), Layer::Get(layer));
+        } else if (parent.IsValid()) {
+            buffer.spawned[slot] = Entity::Spawn(name, parent, Layer::Get(layer));
+        } else {
+            Logger::Log(OBJECT, WARN_HERE) << "Spawn of " << name << " skipped, parent was destroyed";
+        }
+    });
+    return entity;
+}
+DeferredEntity CommandBuffer::Spawn(const string& name, DeferredEntity parent, const string& layer) {
+    std::lock_guard<std::mutex> guard(mutex);
+    const DeferredEntity entity { spawnCount++ };
+
+    commands.emplace_back([name, parent, layer](CommandBuffer& buffer) {
+        const size_t slot = buffer.spawned.size();
+        buffer.spawned.emplace_back();
+
+        if (Entity* resolvedParent = buffer.Resolve(parent)) {
+            buffer.spawned[slot] = Entity::Spawn(name, resolvedParent->GetHandle(), Layer::Get(layer));
+        } else {
+            Logger::Log(OBJECT, WARN_HERE) << "Spawn of " << name << " skipped, deferred parent does not exist";
+        }
+    });
+    return entity;
+}
+void CommandBuffer::Destroy(EntityHandle entity) {
+    Record([entity](CommandBuffer&) { Entity::Destroy(entity); });
+}
+void CommandBuffer::Destroy(DeferredEntity entity) {
+    Record([entity](CommandBuffer& buffer) {
+        if (Entity* target = buffer.Resolve(entity)) { Entity::Destroy(target->GetHandle()); }
+    });
+}
+void CommandBuffer::SetLayer(EntityHandle entity, const string& layer) {
+    Record([entity, layer](CommandBuffer&) {
+        if (Entity* target = entity.Get()) { target->SetLayer(layer); }
+    });
+}
+void CommandBuffer::SetLayer(DeferredEntity entity, const string& layer) {
+    Record([entity, layer](CommandBuffer& buffer) {
+        if (Entity* target = buffer.Resolve(entity)) { target->SetLayer(layer); }
+    });
+}
+void CommandBuffer::Playback() {
+    vector<Command> recorded;
+    {
+        std::lock_guard<std::mutex> guard(mutex);
+        recorded.swap(commands);
+        spawnCount = 0;
+    }
+
+    /** Failed command must not drop the rest, DeferredEntity indices rely on every Spawn running */
+    std::exception_ptr failure;
+    spawned.clear();
+    for (Command& command : recorded) {
+        try {
+            command(*this);
+        } catch (...) {
+            if (!failure) { failure = std::current_exception(); }
+        }
+    }
+    spawned.clear();
+
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+bool CommandBuffer::IsEmpty() {
+    std::lock_guard<std::mutex> guard(mutex);
+    return commands.empty();
+}
+void CommandBuffer::Record(Command command) {
+    std::lock_guard<std::mutex> guard(mutex);
+    commands.push_back(std::move(command));
+}
+Entity* CommandBuffer::Resolve(DeferredEntity entity) const {
+    return entity.index < spawned.size() ? spawned[entity.index].Get() : nullptr;
+}
+
+} // namespace core
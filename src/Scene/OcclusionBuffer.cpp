@@ -0,0 +1,276 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <core/Scene/OcclusionBuffer.h>
+#include <core/JobSystem.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define CORE_OCCLUSION_SSE
+    #include <emmintrin.h>
+#endif
+
+namespace core {
+
+namespace {
+
+/** Corners of a box, bit 0 picks x, bit 1 y, bit 2 z of min or max */
+constexpr uint32_t boxIndices[36] {
+    0, 2, 3,  0, 3, 1,      // -z
+    4, 5, 7,  4, 7, 6,      // +z
+    0, 1, 5,  0, 5, 4,      // -y
+    2, 6, 7,  2, 7, 3,      // +y
+    0, 4, 6,  0, 6, 2,      // -x
+    1, 3, 7,  1, 7, 5       // +x
+};
+
+Vector3 Corner(const Range3D& box, uint32_t i) {
+    return {
+        (i & 1) ? box.max().x() : box.min().x(),
+        (i & 2) ? box.max().y() : box.min().y(),
+        (i & 4) ? box.max().z() : box.min().z()
+    };
+}
+
+/** Is clip space point behind the near plane? */
+bool BehindNearPlane(const Vector4& clip) {
+    return clip.w() <= std::numeric_limits<float>::epsilon() || clip.z() < -clip.w();
+}
+
+}
+
+OcclusionBuffer::OcclusionBuffer(JobSystem& jobSystem, uint32_t width, uint32_t height)
+: jobSystem(jobSystem),
+  width((std::max(width, 4u) + 3) & ~3u),
+  height(std::max(height, 1u)),
+  depth(static_cast<size_t>(this->width) * this->height, 1.0f)
+{ }
+void OcclusionBuffer::Begin(const Matrix4& matrix) {
+    viewProjection = matrix;
+    triangles.clear();
+}
+void OcclusionBuffer::AddOccluder(const Matrix4& transform, const Range3D& box) {
+    const Matrix4 toClip = viewProjection * transform;
+
+    Vector4 corners[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        corners[i] = toClip * Vector4 { Corner(box, i), 1.0f };
+    }
+    for (size_t i = 0; i < 36; i += 3) {
+        AddTriangle(corners[boxIndices[i]], corners[boxIndices[i + 1]], corners[boxIndices[i + 2]]);
+    }
+}
+void OcclusionBuffer::AddOccluder(const Matrix4& transform, const Vector3* vertices, const uint32_t* indices, size_t indexCount) {
+    const Matrix4 toClip = viewProjection * transform;
+
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        AddTriangle(toClip * Vector4 { vertices[indices[i]],     1.0f },
+                    toClip * Vector4 { vertices[indices[i + 1]], 1.0f },
+                    toClip * Vector4 { vertices[indices[i + 2]], 1.0f });
+    }
+}
+void OcclusionBuffer::AddTriangle(const Vector4& a, const Vector4& b, const Vector4& c) {
+    /* Skipping triangles crossing the near plane only makes occlusion weaker, never wrong */
+    if (BehindNearPlane(a) || BehindNearPlane(b) || BehindNearPlane(c)) { return; }
+
+    Triangle triangle;
+    const Vector4* vertices[3] { &a, &b, &c };
+    for (size_t i = 0; i < 3; ++i) {
+        const Vector4& clip = *vertices[i];
+        triangle.x[i] = (clip.x() / clip.w() * 0.5f + 0.5f) * static_cast<float>(width);
+        triangle.y[i] = (clip.y() / clip.w() * 0.5f + 0.5f) * static_cast<float>(height);
+        triangle.z[i] = clip.z() / clip.w();
+    }
+
+    const float area = (triangle.x[1] - triangle.x[0]) * (triangle.y[2] - triangle.y[0])
+                     - (triangle.x[2] - triangle.x[0]) * (triangle.y[1] - triangle.y[0]);
+    if (std::abs(area) < 1e-6f) { return; }
+
+    /* Both windings are rasterized, counter-clockwise order keeps edge functions positive inside */
+    if (area < 0.0f) {
+        std::swap(triangle.x[1], triangle.x[2]);
+        std::swap(triangle.y[1], triangle.y[2]);
+        std::swap(triangle.z[1], triangle.z[2]);
+    }
+    triangles.push_back(triangle);
+}
+void OcclusionBuffer::Rasterize() {
+    const uint32_t bandCount = (height + bandHeight - 1) / bandHeight;
+
+    jobSystem.ParallelFor(0, bandCount, [this](size_t band) {
+        const uint32_t rowBegin = static_cast<uint32_t>(band) * bandHeight;
+        const uint32_t rowEnd   = std::min(height, rowBegin + bandHeight);
+
+        std::fill(depth.begin() + static_cast<size_t>(rowBegin) * width,
+                  depth.begin() + static_cast<size_t>(rowEnd) * width, 1.0f);
+
+        for (const Triangle& triangle : triangles) {
+            RasterizeTriangle(triangle, rowBegin, rowEnd);
+        }
+    }, 1);
+}
+void OcclusionBuffer::RasterizeTriangle(const Triangle& t, uint32_t rowBegin, uint32_t rowEnd) {
+    const float minX = std::max(std::min({ t.x[0], t.x[1], t.x[2] }), 0.0f);
+    const float maxX = std::min(std::max({ t.x[0], t.x[1], t.x[2] }), static_cast<float>(width - 1));
+    const float minY = std::max(std::min({ t.y[0], t.y[1], t.y[2] }), static_cast<float>(rowBegin));
+    const float maxY = std::min(std::max({ t.y[0], t.y[1], t.y[2] }), static_cast<float>(rowEnd - 1));
+    if (minX > maxX || minY > maxY) { return; }
+
+    /* Rows are processed 4 pixels at a time, starting at a multiple of 4 */
+    const uint32_t x0 = static_cast<uint32_t>(minX) & ~3u;
+    const uint32_t x1 = static_cast<uint32_t>(maxX);
+    const uint32_t y0 = static_cast<uint32_t>(minY);
+    const uint32_t y1 = static_cast<uint32_t>(maxY);
+
+    /* Edge i goes from vertex i to vertex i + 1, E(x, y) = a * x + b * y + c is positive inside */
+    float edgeA[3], edgeB[3], edgeC[3];
+    for (size_t i = 0; i < 3; ++i) {
+        const size_t j = (i + 1) % 3;
+        edgeA[i] = t.y[i] - t.y[j];
+        edgeB[i] = t.x[j] - t.x[i];
+        edgeC[i] = -(edgeA[i] * t.x[i] + edgeB[i] * t.y[i]);
+    }
+
+    /* Depth is linear in screen space, z(x, y) = dzdx * x + dzdy * y + zc */
+    const float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.x[2] - t.x[0]) * (t.y[1] - t.y[0]);
+    const float dzdx = ((t.z[1] - t.z[0]) * (t.y[2] - t.y[0]) - (t.z[2] - t.z[0]) * (t.y[1] - t.y[0])) / area;
+    const float dzdy = ((t.z[2] - t.z[0]) * (t.x[1] - t.x[0]) - (t.z[1] - t.z[0]) * (t.x[2] - t.x[0])) / area;
+    const float zc   = t.z[0] - dzdx * t.x[0] - dzdy * t.y[0];
+
+    for (uint32_t y = y0; y <= y1; ++y) {
+        const float py = static_cast<float>(y) + 0.5f;
+        float* row = depth.data() + static_cast<size_t>(y) * width;
+
+#ifdef CORE_OCCLUSION_SSE
+        const __m128 zero = _mm_setzero_ps();
+        __m128 rowEdge[3];
+        for (size_t i = 0; i < 3; ++i) {
+            rowEdge[i] = _mm_set1_ps(edgeB[i] * py + edgeC[i]);
+        }
+        const __m128 rowDepth = _mm_set1_ps(dzdy * py + zc);
+
+        for (uint32_t x = x0; x <= x1; x += 4) {
+            const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+
+            __m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[0]), px), rowEdge[0]), zero);
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[1]), px), rowEdge[1]), zero));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(edgeA[2]), px), rowEdge[2]), zero));
+            if (_mm_movemask_ps(inside) == 0) { continue; }
+
+            const __m128 z        = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(dzdx), px), rowDepth);
+            const __m128 previous = _mm_loadu_ps(row + x);
+            const __m128 nearest  = _mm_min_ps(previous, z);
+            _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, previous)));
+        }
+#else
+        for (uint32_t x = x0; x <= x1; ++x) {
+            const float px = static_cast<float>(x) + 0.5f;
+            if (edgeA[0] * px + edgeB[0] * py + edgeC[0] < 0.0f ||
+                edgeA[1] * px + edgeB[1] * py + edgeC[1] < 0.0f ||
+                edgeA[2] * px + edgeB[2] * py + edgeC[2] < 0.0f) { continue; }
+
+            row[x] = std::min(row[x], dzdx * px + dzdy * py + zc);
+        }
+#endif
+    }
+}
+bool OcclusionBuffer::IsVisible(const Range3D& bounds) const {
+    float minX = std::numeric_limits<float>::max(), maxX = -minX;
+    float minY = minX, maxY = maxX;
+    float minZ = minX;
+    for (uint32_t i = 0; i < 8; ++i) {
+        const Vector4 clip = viewProjection * Vector4 { Corner(bounds, i), 1.0f };
+        if (BehindNearPlane(clip)) { return true; }
+
+        const float x = clip.x() / clip.w(), y = clip.y() / clip.w();
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        minZ = std::min(minZ, clip.z() / clip.w());
+    }
+
+    minX = (minX * 0.5f + 0.5f) * static_cast<float>(width);
+    maxX = (maxX * 0.5f + 0.5f) * static_cast<float>(width);
+    minY = (minY * 0.5f + 0.5f) * static_cast<float>(height);
+    maxY = (maxY * 0.5f + 0.5f) * static_cast<float>(height);
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) || minY >= static_cast<float>(height)) { return false; }
+
+    const uint32_t x0 = static_cast<uint32_t>(std::max(minX, 0.0f));
+    const uint32_t x1 = static_cast<uint32_t>(std::min(maxX, static_cast<float>(width - 1)));
+    const uint32_t y0 = static_cast<uint32_t>(std::max(minY, 0.0f));
+    const uint32_t y1 = static_cast<uint32_t>(std::min(maxY, static_cast<float>(height - 1)));
+
+    /* Visible as soon as one covered pixel is not nearer than the nearest point of the bounds */
+    for (uint32_t y = y0; y <= y1; ++y) {
+        const float* row = depth.data() + static_cast<size_t>(y) * width;
+
+        uint32_t x = x0;
+#ifdef CORE_OCCLUSION_SSE
+        const __m128 nearest = _mm_set1_ps(minZ);
+        for (; x + 3 <= x1; x += 4) {
+            if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), nearest)) != 0) { return true; }
+        }
+#endif
+        for (; x <= x1; ++x) {
+            if (row[x] >= minZ) { return true; }
+        }
+    }
+    return false;
+}
+size_t OcclusionBuffer::TestVisibility(const Range3D* bounds, uint8_t* visible, size_t count) const {
+    std::atomic<size_t> visibleCount { 0 };
+
+    const size_t jobCount = (count + testGrainSize - 1) / testGrainSize;
+    jobSystem.ParallelFor(0, jobCount, [&](size_t job) {
+        const size_t begin = job * testGrainSize;
+        const size_t end   = std::min(count, begin + testGrainSize);
+
+        size_t jobVisible = 0;
+        for (size_t i = begin; i < end; ++i) {
+            visible[i] = IsVisible(bounds[i]) ? 1 : 0;
+            jobVisible += visible[i];
+        }
+        visibleCount += jobVisible;
+    }, 1);
+
+    return visibleCount.load();
+}
+size_t OcclusionBuffer::GetTriangleCount() const {
+    return triangles.size();
+}
+uint32_t OcclusionBuffer::GetWidth() const {
+    return width;
+}
+uint32_t OcclusionBuffer::GetHeight() const {
+    return height;
+}
+const float* OcclusionBuffer::GetDepth() const {
+    return depth.data();
+}
+
+}
@@ -32,7 +32,7 @@ Scene* Scene::current { nullptr };
 
 Scene::Scene(const string& name)
 : Object(name),
-  root(make_shared<Entity>("Root", nullptr))
+  root(make_shared<Entity>("Root", EntityHandle { }))
 {
     if (!current) current = this;
 }
@@ -62,9 +62,10 @@ vector<shared<Model>> SceneData::ImportModels(){
 void SceneData::AddEntity(vector<shared<Entity>>& container, const shared<Entity>& parent, uint32_t id) {
     Logger::Log(IMPORT, INFO) << "[" << id << "] Entity " << names[id];
     
-    shared<Entity> entity = make_shared<Entity>(names[id], parent);
+    shared<Entity> entity = make_shared<Entity>(names[id], parent->GetHandle());
     entity->AddComponent<Transform>();
     entity->AddComponent<Renderer>(SceneData::LoadModel(id));
+    entity->GetComponent<Renderer>()->SetSource({ path, id });
     
     entity->GetComponent<Transform>()->SetPosition(objects[id]->transformation().translation());
     entity->GetComponent<Transform>()->SetRotation(Quaternion::fromMatrix(objects[id]->transformation().rotation()));
@@ -98,7 +99,7 @@ shared<Model> SceneData::LoadModel(uint32_t id) {
         }
     }
     
-    return make_shared<Model>(make_shared<Mesh>(&(*meshes[id])), Shader::standard, material);
+    return make_shared<Model>(make_shared<Mesh>(&(*meshes[id]), meshBounds[id], meshRadii[id]), Shader::standard, material);
 }
 void SceneData::SetTextures(const shared<Material>& material, uint32_t id) {
     auto& sceneMaterial = static_cast<const Trade::PhongMaterialData&>(*materials[id]);
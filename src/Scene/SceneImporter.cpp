@@ -39,36 +39,77 @@
 #include <Magnum/ImageView.h>
 
 #include <memory>
+#include <sstream>
 
 namespace core {
 
-SceneImporter::SceneImporter() {
-    InitImporter();
+namespace {
+
+/**
+ * Log entry recorded into SceneData::messages on destruction
+ * @details SceneImporter::Read may run on a job thread, where Logger must not be used
+ */
+class Note {
+public:
+    Note(SceneData& data, LogLevel level, const LogPlace& place = { })
+    : data(data), level(level), place(place)
+    { }
+    ~Note() {
+        data.messages.push_back({ level, place, stream.str() });
+    }
+
+    template<class T>
+    Note& operator<<(const T& thing) {
+        stream << thing;
+        return *this;
+    }
+
+private:
+    SceneData&        data;
+    LogLevel          level;
+    LogPlace          place;
+    std::stringstream stream;
+};
+
 }
+
+SceneImporter::SceneImporter() = default;
+
 void SceneImporter::InitImporter() {
     if (importer) { return; }
     
     importer = manager.loadAndInstantiate("AnySceneImporter");
     
     if (!importer) {
-        Logger::Log(IMPORT, ERR_HERE) << "Failed to load or instantiate importer";
         throw std::logic_error("Failed to load or instantiate importer");
     }
-    Logger::Log(IMPORT, DEBUG) << "Loaded scene importer successfully";
 }
 void SceneImporter::OpenFile(const string& filepath) {
     if (!importer->openFile(filepath)) {
-        Logger::Log(IMPORT, ERR_HERE) << "Failed to open file " << filepath;
         throw std::runtime_error("Failed to open file " + filepath);
     }
-    Logger::Log(IMPORT, DEBUG) << "Opened file " << filepath;
 }
 void SceneImporter::CloseFile() noexcept {
     importer->close();
 }
 shared<SceneData> SceneImporter::Import(const string& filepath) {
+    shared<SceneData> data;
+    try {
+        data = Read(filepath);
+    } catch (const std::exception& e) {
+        Logger::Log(IMPORT, ERR_HERE) << e.what();
+        throw;
+    }
+    Upload(*data);
+    return data;
+}
+shared<SceneData> SceneImporter::Read(const string& filepath) {
+    InitImporter();
+
     shared<SceneData> data = make_shared<SceneData>();
+    data->path = filepath;
     OpenFile(filepath);
+    Note(*data, DEBUG) << "Opened file " << filepath;
     
     ImportChildrenData(*data);
     ImportObjectData(*data);
@@ -79,43 +120,73 @@ shared<SceneData> SceneImporter::Import(const string& filepath) {
     CloseFile();
     return data;
 }
+void SceneImporter::Upload(SceneData& data) {
+    if (data.uploaded) { return; }
+
+    for (const SceneData::Message& message : data.messages) {
+        Logger::Log(IMPORT, message.level, message.place) << message.text;
+    }
+
+    data.textures = vector<optional<GL::Texture2D>>(data.textureData.size());
+    for (size_t i = 0; i != data.textureData.size(); ++i) {
+        const optional<Trade::TextureData>&  textureData = data.textureData[i];
+        const optional<Trade::ImageData2D>& imageData   = data.imageData[i];
+        if (!textureData || !imageData) { continue; }
+
+        const GL::TextureFormat format { imageData->format() };
+        GL::Texture2D texture;
+        texture
+            .setMagnificationFilter(textureData->magnificationFilter())
+            .setMinificationFilter(textureData->minificationFilter(), textureData->mipmapFilter())
+            .setWrapping(textureData->wrapping().xy())
+            .setStorage(Math::log2(imageData->size().max()) + 1, format, imageData->size())
+            .setSubImage(0, { }, *imageData)
+            .generateMipmap();
+
+        data.textures[i] = std::move(texture);
+    }
+
+    data.meshes = vector<optional<GL::Mesh>>(data.meshData.size());
+    for (size_t i = 0; i != data.meshData.size(); ++i) {
+        if (data.meshData[i]) { data.meshes[i] = MeshTools::compile(*data.meshData[i]); }
+    }
+
+    /* Staged data is only needed for the upload, GPU copies are kept instead */
+    data.messages.clear();
+    data.textureData.clear();
+    data.imageData.clear();
+    data.meshData.clear();
+    data.uploaded = true;
+}
 void SceneImporter::ImportTextures(SceneData& data) {
-    data.textures = vector<optional<GL::Texture2D>> { importer->textureCount() };
+    data.textureData = vector<optional<Trade::TextureData>>(importer->textureCount());
+    data.imageData   = vector<optional<Trade::ImageData2D>>(importer->textureCount());
     
     for (uint32_t i = 0; i != importer->textureCount(); i++) {
         optional<Trade::TextureData> textureData = optional<Trade::TextureData>(importer->texture(i));
         if (!textureData) {
-            Logger::Log(IMPORT, WARN) << "[" << i << "] " << "failed to load, skipping";
+            Note(data, WARN) << "[" << i << "] " << "failed to load, skipping";
             continue;
         } else if (textureData->type() != Trade::TextureType::Texture2D) {
-            Logger::Log(IMPORT, WARN_HERE) << "[" << i << "] " << "unsupported texture type, skipping";
+            Note(data, WARN_HERE) << "[" << i << "] " << "unsupported texture type, skipping";
             continue;
         }
-        Logger::Log(IMPORT, INFO)  << "[" << i << "] Texture " << importer->textureName(i);
-        Logger::Log(IMPORT, DEBUG) << " | Filter: "    << (int)textureData->magnificationFilter();
-        Logger::Log(IMPORT, DEBUG) << " | Mipmap: "    << (int)textureData->mipmapFilter();
-        Logger::Log(IMPORT, DEBUG) << " | Wrapping: "  << (int)textureData->wrapping().x() << 'x'
-                                                       << (int)textureData->wrapping().y();
+        Note(data, INFO)  << "[" << i << "] Texture " << importer->textureName(i);
+        Note(data, DEBUG) << " | Filter: "    << (int)textureData->magnificationFilter();
+        Note(data, DEBUG) << " | Mipmap: "    << (int)textureData->mipmapFilter();
+        Note(data, DEBUG) << " | Wrapping: "  << (int)textureData->wrapping().x() << 'x'
+                                              << (int)textureData->wrapping().y();
     
         const uint32_t imageID = textureData->image();
-        const optional<Trade::ImageData2D> imageData = optional<Trade::ImageData2D>(importer->image2D(imageID));
-        const GL::TextureFormat format { imageData->format() };
+        optional<Trade::ImageData2D> imageData = optional<Trade::ImageData2D>(importer->image2D(imageID));
         if (!imageData) {
-            Logger::Log(IMPORT, WARN_HERE) << " | Image " << imageID << " failed to load, skipping";
+            Note(data, WARN_HERE) << " | Image " << imageID << " failed to load, skipping";
             continue;
         }
-        Logger::Log(IMPORT, DEBUG) << " | Image format: " << (int) imageData->format();
-    
-        GL::Texture2D texture;
-        texture
-            .setMagnificationFilter(textureData->magnificationFilter())
-            .setMinificationFilter(textureData->minificationFilter(), textureData->mipmapFilter())
-            .setWrapping(textureData->wrapping().xy())
-            .setStorage(Math::log2(imageData->size().max()) + 1, format, imageData->size())
-            .setSubImage(0, { }, *imageData)
-            .generateMipmap();
+        Note(data, DEBUG) << " | Image format: " << (int) imageData->format();
 
-        data.textures[i] = std::move(texture);
+        data.textureData[i] = std::move(textureData);
+        data.imageData[i]   = std::move(imageData);
     }
 }
 void SceneImporter::ImportMaterials(SceneData& data) {
@@ -124,50 +195,55 @@ void SceneImporter::ImportMaterials(SceneData& data) {
    
         optional<Trade::MaterialData> materialData = optional<Trade::MaterialData>(importer->material(i));
         if (!materialData) {
-            Logger::Log(IMPORT, WARN) << "[" << i << "] Material failed to load, skipping";
+            Note(data, WARN) << "[" << i << "] Material failed to load, skipping";
             continue;
         }
-        Logger::Log(IMPORT, INFO) << "[" << i << "] Material " << importer->materialName(i);
+        Note(data, INFO) << "[" << i << "] Material " << importer->materialName(i);
     
         Trade::MaterialTypes materialTypes = materialData->types();
         if (materialTypes & Trade::MaterialType::PbrSpecularGlossiness
         or  materialTypes & Trade::MaterialType::PbrMetallicRoughness
         or  materialTypes & Trade::MaterialType::PbrClearCoat)
         {
-            Logger::Log(IMPORT, WARN_HERE) << "PBR materials not yet implemented!";
+            Note(data, WARN_HERE) << "PBR materials not yet implemented!";
         }
         
         if (materialTypes & Trade::MaterialType::Phong) {
             auto& material = static_cast<Trade::PhongMaterialData&>(*materialData);
-            Logger::Log(IMPORT, DEBUG) << " | Material type: Phong";
-            Logger::Log(IMPORT, DEBUG) << " | Diffuse texture:   " << (material.hasAttribute(Trade::MaterialAttribute::DiffuseTexture)   ? "Yes" : "No");
-            Logger::Log(IMPORT, DEBUG) << " | Specular texture:  " << (material.hasAttribute(Trade::MaterialAttribute::SpecularTexture)  ? "Yes" : "No");
-            Logger::Log(IMPORT, DEBUG) << " | Occlusion texture: " << (material.hasAttribute(Trade::MaterialAttribute::OcclusionTexture) ? "Yes" : "No");
-            Logger::Log(IMPORT, DEBUG) << " | Normal texture:    " << (material.hasAttribute(Trade::MaterialAttribute::NormalTexture)    ? "Yes" : "No");
+            Note(data, DEBUG) << " | Material type: Phong";
+            Note(data, DEBUG) << " | Diffuse texture:   " << (material.hasAttribute(Trade::MaterialAttribute::DiffuseTexture)   ? "Yes" : "No");
+            Note(data, DEBUG) << " | Specular texture:  " << (material.hasAttribute(Trade::MaterialAttribute::SpecularTexture)  ? "Yes" : "No");
+            Note(data, DEBUG) << " | Occlusion texture: " << (material.hasAttribute(Trade::MaterialAttribute::OcclusionTexture) ? "Yes" : "No");
+            Note(data, DEBUG) << " | Normal texture:    " << (material.hasAttribute(Trade::MaterialAttribute::NormalTexture)    ? "Yes" : "No");
             data.materials[i] = std::move(material);
         } else if (materialTypes & Trade::MaterialType::Flat) {
             auto& material = static_cast<Trade::FlatMaterialData&>(*materialData);
-            Logger::Log(IMPORT, DEBUG) << " | Material type: Flat";
-            Logger::Log(IMPORT, DEBUG) << " | Texture: " << (material.hasTexture() ? "Yes" : "No");
+            Note(data, DEBUG) << " | Material type: Flat";
+            Note(data, DEBUG) << " | Texture: " << (material.hasTexture() ? "Yes" : "No");
             data.materials[i] = std::move(material);
         }
     }
 }
 void SceneImporter::ImportMeshes(SceneData& data) {
-    data.meshes = vector<optional<GL::Mesh>> { importer->meshCount() };
+    data.meshData   = vector<optional<Trade::MeshData>>(importer->meshCount());
+    data.meshBounds = vector<Range3D>(importer->meshCount());
+    data.meshRadii  = vector<float>(importer->meshCount(), -1.0f);
     for (uint32_t i = 0; i != importer->meshCount(); ++i) {
         optional<Trade::MeshData> meshData = optional<Trade::MeshData>(importer->mesh(i));
         if (!meshData) {
-            Logger::Log(IMPORT, WARN_HERE) << "[" << i << "] Mesh failed to load, skipping";
+            Note(data, WARN_HERE) << "[" << i << "] Mesh failed to load, skipping";
             continue;
         }
         if (!meshData->hasAttribute(Trade::MeshAttribute::Normal) || meshData->primitive() != MeshPrimitive::Triangles) {
-            Logger::Log(IMPORT, WARN_HERE) << "[" << i << "] Mesh: Cannot deduce normal data, skipping";
+            Note(data, WARN_HERE) << "[" << i << "] Mesh: Cannot deduce normal data, skipping";
             continue;
         }
-        Logger::Log(IMPORT, INFO) << "[" << i << "] Mesh " << importer->meshName(i);
-    
-        data.meshes[i] = MeshTools::compile(*meshData);
+        Note(data, INFO) << "[" << i << "] Mesh " << importer->meshName(i);
+
+        if (!Mesh::ComputeBounds(*meshData, data.meshBounds[i], data.meshRadii[i])) {
+            Note(data, WARN) << "[" << i << "] Mesh has no positions, it will not be culled";
+        }
+        data.meshData[i] = std::move(meshData);
     }
 }
 void SceneImporter::ImportObjectData(SceneData& data) {
@@ -177,10 +253,10 @@ void SceneImporter::ImportObjectData(SceneData& data) {
         unique<Trade::ObjectData3D> objectData = importer->object3D(i);
         string name = importer->object3DName(i);
         if (!objectData) {
-            Logger::Log(IMPORT, INFO) << "[" << i << "] Model failed to import, skipping";
+            Note(data, INFO) << "[" << i << "] Model failed to import, skipping";
             continue;
         }
-        Logger::Log(IMPORT, INFO) << "[" << i << "] Model" << importer->object3DName(i);
+        Note(data, INFO) << "[" << i << "] Model" << importer->object3DName(i);
         
         data.objects[i] = std::move(objectData);
         data.names[i] = name;
@@ -188,10 +264,9 @@ void SceneImporter::ImportObjectData(SceneData& data) {
 }
 void SceneImporter::ImportChildrenData(SceneData& data) {
     if (importer->defaultScene() != -1) {
-        Logger::Log(IMPORT, INFO) << "Importing Default Scene " << importer->sceneName(importer->defaultScene());
+        Note(data, INFO) << "Importing Default Scene " << importer->sceneName(importer->defaultScene());
         data.children = optional<Trade::SceneData>(importer->scene(importer->defaultScene()));
         if (!data.children) {
-            Logger::Log(IMPORT, ERR_HERE) << "Children data failed to load";
             throw std::runtime_error("Cannot load scene, Children data failed to load");
         }
     }
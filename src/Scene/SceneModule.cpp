@@ -22,6 +22,7 @@
  SOFTWARE.
  */
 #include <core/Scene/SceneModule.h>
+#include <core/Scene/CommandBuffer.h>
 
 namespace core {
 
@@ -31,25 +32,41 @@ SceneModule::SceneModule()
     defaultScene = Scene::Get("Default");
 }
 void SceneModule::Start() {
-    std::for_each(Entity::instances.begin(), Entity::instances.end(),   [&](Entity* e) { e->Start(); } );
+    const auto& storages = IComponentStorage::ForPhase(TickerPhase::Start);
+    std::for_each(storages.begin(), storages.end(), [&](IComponentStorage* s) { s->Start(); } );
+    scheduler.Run(&ITicker::Start);
 }
 void SceneModule::EarlyTick() {
-    std::for_each(Entity::instances.begin(), Entity::instances.end(),   [&](Entity* e) { e->EarlyTick(); } );
+    const auto& storages = IComponentStorage::ForPhase(TickerPhase::EarlyTick);
+    std::for_each(storages.begin(), storages.end(), [&](IComponentStorage* s) { s->EarlyTick(); } );
+    scheduler.Run(&ITicker::EarlyTick);
 }
 void SceneModule::FixedTick() {
-    std::for_each(Entity::instances.begin(), Entity::instances.end(),   [&](Entity* e) { e->FixedTick(); } );
+    const auto& storages = IComponentStorage::ForPhase(TickerPhase::FixedTick);
+    std::for_each(storages.begin(), storages.end(), [&](IComponentStorage* s) { s->FixedTick(); } );
+    scheduler.Run(&ITicker::FixedTick);
 }
 void SceneModule::Tick() {
-    std::for_each(Entity::instances.begin(),  Entity::instances.end(),  [&](Entity* e) { e->Tick(); } );
+    const auto& storages = IComponentStorage::ForPhase(TickerPhase::Tick);
+    std::for_each(storages.begin(), storages.end(), [&](IComponentStorage* s) { s->Tick(); } );
+    scheduler.Run(&ITicker::Tick);
+    transforms.Update();
 
-    /** Make Camera->Draw() call only after all entities were updated */
+    /** Make Camera->Draw() call only after all components were updated */
     std::for_each(cameraList.cameras.begin(), cameraList.cameras.end(), [&](Camera* camera) { camera->Draw(); });
 }
 void SceneModule::LateTick() {
-    std::for_each(Entity::instances.begin(), Entity::instances.end(),   [&](Entity* e) { e->LateTick(); } );
+    const auto& storages = IComponentStorage::ForPhase(TickerPhase::LateTick);
+    std::for_each(storages.begin(), storages.end(), [&](IComponentStorage* s) { s->LateTick(); } );
+    scheduler.Run(&ITicker::LateTick);
+
+    /** Apply structural changes recorded during the frame */
+    CommandBuffer::PlaybackAll();
 }
 void SceneModule::Stop() {
-    std::for_each(Entity::instances.begin(), Entity::instances.end(),   [&](Entity* e) { e->Stop(); } );
+    const auto& storages = IComponentStorage::ForPhase(TickerPhase::Stop);
+    std::for_each(storages.begin(), storages.end(), [&](IComponentStorage* s) { s->Stop(); } );
+    scheduler.Run(&ITicker::Stop);
 }
 
 }
@@ -0,0 +1,435 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <core/Scene/SceneSnapshot.h>
+#include <core/Scene/SceneHierarchy.h>
+#include <core/Scene/SceneImporter.h>
+#include <core/Components/Transform.h>
+#include <core/Components/Renderer.h>
+#include <core/ComponentStorage.h>
+#include <core/FileSystem.h>
+#include <core/Entity.h>
+#include <core/Layer.h>
+#include <core/Logger.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <mutex>
+
+namespace core {
+
+namespace {
+
+constexpr char     magic[4]  = { 'C', 'S', 'N', 'P' };
+constexpr uint32_t none      = std::numeric_limits<uint32_t>::max();
+
+/** Written in native byte order, reads back differently on a machine of the other byte order */
+constexpr uint32_t byteOrder = 0x01020304;
+
+enum class SectionType : uint32_t {
+    Strings,
+    Entities,
+    Transforms,
+    Renderers,
+    Assets,
+    Count
+};
+
+using StringRef       = SceneSnapshot::Decoded::StringRef;
+using EntityRecord    = SceneSnapshot::Decoded::EntityRecord;
+using TransformRecord = SceneSnapshot::Decoded::TransformRecord;
+using RendererRecord  = SceneSnapshot::Decoded::RendererRecord;
+using AssetRecord     = SceneSnapshot::Decoded::AssetRecord;
+
+template<typename T>
+using Records = SceneSnapshot::Decoded::Records<T>;
+
+struct Header {
+    char     magic[4];
+    uint32_t byteOrder;
+    uint32_t version;
+    uint32_t sectionCount;
+};
+
+struct Section {
+    uint32_t type;
+    uint32_t reserved;
+    uint64_t offset;
+    uint64_t size;
+};
+
+constexpr size_t sectionAlignment = 8;
+
+/**
+ * Held while any SceneSnapshot creates or uses a SceneImporter
+ * @details Every importer owns a Corrade plugin manager, which is not known to be safe
+ * to load plugins concurrently, and several cells may be decoded on job threads at once
+ */
+std::mutex importerMutex;
+
+/**
+ * Deduplicating string table
+ */
+class StringTable {
+public:
+    StringRef Add(const string& text) {
+        auto it = offsets.find(text);
+        if (it != offsets.end()) { return it->second; }
+
+        const StringRef ref { static_cast<uint32_t>(data.size()), static_cast<uint32_t>(text.size()) };
+        data.insert(data.end(), text.begin(), text.end());
+        offsets.emplace(text, ref);
+        return ref;
+    }
+
+    vector<char> data;
+
+private:
+    std::unordered_map<string, StringRef> offsets;
+};
+
+/**
+ * Bounds-checked access to sections of a mapped snapshot
+ */
+class SnapshotView {
+public:
+    SnapshotView(const MappedFile& file, const string& path)
+    : file(file), path(path)
+    {
+        if (file.GetSize() < sizeof(Header)) { Fail("file is too small"); }
+
+        const auto* header = reinterpret_cast<const Header*>(file.GetData());
+        if (std::memcmp(header->magic, magic, sizeof(magic)) != 0) { Fail("file is not a scene snapshot"); }
+        if (header->byteOrder != byteOrder) { Fail("file was saved on a machine of different byte order"); }
+        if (header->version != SceneSnapshot::version) {
+            Fail("version " + std::to_string(header->version) + " is not supported");
+        }
+
+        const size_t tableEnd = sizeof(Header) + static_cast<size_t>(header->sectionCount) * sizeof(Section);
+        if (tableEnd > file.GetSize()) { Fail("section table is truncated"); }
+
+        sections = reinterpret_cast<const Section*>(file.GetData() + sizeof(Header));
+        sectionCount = header->sectionCount;
+    }
+
+    template<typename T>
+    Records<T> Get(SectionType type) const {
+        for (size_t i = 0; i < sectionCount; ++i) {
+            const Section& section = sections[i];
+            if (section.type != static_cast<uint32_t>(type)) { continue; }
+            if (section.size == 0) { return { nullptr, 0 }; }
+
+            if (section.offset > file.GetSize() || section.size > file.GetSize() - section.offset
+                || section.offset % alignof(T) != 0 || section.size % sizeof(T) != 0) {
+                Fail("section " + std::to_string(section.type) + " is out of bounds");
+            }
+            return { reinterpret_cast<const T*>(file.GetData() + section.offset), section.size / sizeof(T) };
+        }
+        return { nullptr, 0 };
+    }
+
+    void CheckString(StringRef ref) const {
+        if (ref.offset > strings.size || ref.length > strings.size - ref.offset) { Fail("string is out of bounds"); }
+    }
+
+    /* Decoding may run on a job thread, so failure is only thrown, callers log it */
+    [[noreturn]] void Fail(const string& reason) const {
+        throw std::runtime_error("Cannot load snapshot " + path + ", " + reason);
+    }
+
+    Records<char> strings;
+
+private:
+    const MappedFile& file;
+    const string&     path;
+    const Section*    sections     { nullptr };
+    size_t            sectionCount { 0 };
+};
+
+template<typename T>
+void WriteSection(std::ofstream& stream, Section& section, SectionType type, const vector<T>& records, uint64_t& offset) {
+    section = { static_cast<uint32_t>(type), 0, offset, records.size() * sizeof(T) };
+
+    stream.seekp(static_cast<std::streamoff>(offset));
+    stream.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(section.size));
+    offset += (section.size + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+}
+
+}
+
+void SceneSnapshot::Save(const string& path, EntityHandle root) {
+    Entity* rootEntity = root.Get();
+    if (!rootEntity) {
+        Logger::Log(SCENE, ERR_HERE) << "Cannot save snapshot " << path << ", root entity is not valid";
+        throw std::logic_error("Cannot save snapshot " + path + ", root entity is not valid");
+    }
+
+    StringTable                 strings;
+    vector<EntityRecord>        entities;
+    vector<TransformRecord>     transforms;
+    vector<RendererRecord>      renderers;
+    vector<AssetRecord>         assets;
+    std::unordered_map<string, uint32_t>   assetIndices;
+    std::unordered_map<uint32_t, uint32_t> recordIndices;
+
+    /* Hierarchy order puts parents before their children, so parent records always exist already */
+    SceneHierarchy<Entity>::EachInSubtree(root.index, [&](Entity& entity) {
+        if (&entity == rootEntity) { return; }
+
+        const uint32_t node   = entity.GetHandle().index;
+        const uint32_t parent = SceneHierarchy<Entity>::GetParent(node);
+        const auto     record = static_cast<uint32_t>(entities.size());
+        recordIndices.emplace(node, record);
+
+        entities.push_back({ parent == root.index ? none : recordIndices.at(parent),
+                             strings.Add(entity.GetName()),
+                             strings.Add(entity.GetLayer()->GetName()) });
+
+        if (auto* transform = entity.GetComponent<Transform>()) {
+            const Vector3&    position = transform->GetPosition();
+            const Quaternion& rotation = transform->GetRotation();
+            const Vector3&    scale    = transform->GetScale();
+            transforms.push_back({ record,
+                                   { position.x(), position.y(), position.z() },
+                                   { rotation.vector().x(), rotation.vector().y(), rotation.vector().z(), rotation.scalar() },
+                                   { scale.x(), scale.y(), scale.z() } });
+        }
+
+        if (auto* renderer = entity.GetComponent<Renderer>()) {
+            const Renderer::Source& source = renderer->GetSource();
+            if (source.path.empty()) {
+                Logger::Log(SCENE, WARN) << "Renderer of " << entity.GetInfo() << " has no source asset, skipping";
+                return;
+            }
+
+            auto asset = assetIndices.find(source.path);
+            if (asset == assetIndices.end()) {
+                asset = assetIndices.emplace(source.path, static_cast<uint32_t>(assets.size())).first;
+                assets.push_back({ strings.Add(source.path) });
+            }
+            renderers.push_back({ record, asset->second, source.object });
+        }
+    });
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream.is_open()) {
+        Logger::Log(SCENE, ERR_HERE) << "Cannot save snapshot, failed to open file at " << path;
+        throw std::runtime_error("Cannot save snapshot, failed to open file at " + path);
+    }
+
+    Header header { };
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.byteOrder    = byteOrder;
+    header.version      = version;
+    header.sectionCount = static_cast<uint32_t>(SectionType::Count);
+
+    Section  sections[static_cast<size_t>(SectionType::Count)] { };
+    uint64_t offset = (sizeof(Header) + sizeof(sections) + sectionAlignment - 1) / sectionAlignment * sectionAlignment;
+    WriteSection(stream, sections[0], SectionType::Strings,    strings.data, offset);
+    WriteSection(stream, sections[1], SectionType::Entities,   entities,     offset);
+    WriteSection(stream, sections[2], SectionType::Transforms, transforms,   offset);
+    WriteSection(stream, sections[3], SectionType::Renderers,  renderers,    offset);
+    WriteSection(stream, sections[4], SectionType::Assets,     assets,       offset);
+
+    /* Pad to the aligned end, so every section offset lies within the file */
+    const char padding[sectionAlignment] { };
+    const auto end = static_cast<uint64_t>(stream.tellp());
+    stream.write(padding, static_cast<std::streamsize>(offset - std::min(end, offset)));
+
+    stream.seekp(0);
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    stream.write(reinterpret_cast<const char*>(sections), sizeof(sections));
+
+    if (!stream) {
+        Logger::Log(SCENE, ERR_HERE) << "Cannot save snapshot, failed to write file at " << path;
+        throw std::runtime_error("Cannot save snapshot, failed to write file at " + path);
+    }
+    Logger::Log(SCENE, INFO) << "Saved " << entities.size() << " entities to snapshot " << path;
+}
+
+string SceneSnapshot::Decoded::String(StringRef ref) const {
+    return string(strings.data + ref.offset, ref.length);
+}
+
+SceneSnapshot::Decoded SceneSnapshot::Decode(const string& path) {
+    Decoded decoded;
+    decoded.file = std::make_shared<const MappedFile>(path);
+    SnapshotView view(*decoded.file, path);
+
+    /* Records are only validated here, Instantiate indexes them without checks */
+    decoded.strings    = view.strings = view.Get<char>(SectionType::Strings);
+    decoded.entities   = view.Get<EntityRecord>(SectionType::Entities);
+    decoded.transforms = view.Get<TransformRecord>(SectionType::Transforms);
+    decoded.renderers  = view.Get<RendererRecord>(SectionType::Renderers);
+    decoded.assets     = view.Get<AssetRecord>(SectionType::Assets);
+
+    for (size_t i = 0; i < decoded.entities.size; ++i) {
+        const EntityRecord& record = decoded.entities[i];
+        if (record.parent != none && record.parent >= i) { view.Fail("entity parent does not precede it"); }
+        view.CheckString(record.name);
+        view.CheckString(record.layer);
+    }
+    for (size_t i = 0; i < decoded.transforms.size; ++i) {
+        if (decoded.transforms[i].entity >= decoded.entities.size) { view.Fail("transform entity is out of bounds"); }
+    }
+    for (size_t i = 0; i < decoded.renderers.size; ++i) {
+        const RendererRecord& record = decoded.renderers[i];
+        if (record.entity >= decoded.entities.size || record.asset >= decoded.assets.size) { view.Fail("renderer record is out of bounds"); }
+    }
+    for (size_t i = 0; i < decoded.assets.size; ++i) {
+        view.CheckString(decoded.assets[i].path);
+    }
+
+    return decoded;
+}
+
+void SceneSnapshot::ReadAssets(Decoded& decoded) {
+    decoded.readAssets.assign(decoded.assets.size, nullptr);
+
+    /* Plugin manager is torn down under the lock as well, also when a read fails */
+    unique<SceneImporter> importer;
+    const auto release = [&] {
+        std::lock_guard<std::mutex> lock(importerMutex);
+        importer.reset();
+    };
+
+    try {
+        for (size_t i = 0; i < decoded.assets.size; ++i) {
+            const string path = decoded.String(decoded.assets[i].path);
+            {
+                std::lock_guard<std::mutex> lock(assetsMutex);
+                if (assets.count(path) != 0) { continue; }
+            }
+
+            std::lock_guard<std::mutex> lock(importerMutex);
+            if (!importer) { importer = unique<SceneImporter>(new SceneImporter()); }
+            decoded.readAssets[i] = importer->Read(path);
+        }
+    } catch (...) {
+        release();
+        throw;
+    }
+    release();
+}
+
+bool SceneSnapshot::Instantiate(const Decoded& decoded, Progress& progress, EntityHandle parent,
+                                std::chrono::steady_clock::time_point deadline) {
+    /* Clock is read once per batch of objects, not once per object */
+    constexpr size_t batchSize = 32;
+    const auto expired = [&](size_t done) {
+        return done % batchSize == 0 && std::chrono::steady_clock::now() >= deadline;
+    };
+
+    if (progress.entities == 0 && progress.transforms == 0 && progress.renderers == 0) {
+        /* Allocate everything up front, so construction below does not reallocate */
+        Entity::Reserve(decoded.entities.size);
+        Referable<Entity>::Reserve(decoded.entities.size);
+        SceneHierarchy<Entity>::Reserve(decoded.entities.size);
+        ComponentStorage<Transform>::Get().Reserve(decoded.transforms.size);
+        ComponentStorage<Renderer>::Get().Reserve(decoded.renderers.size);
+        progress.handles.reserve(decoded.entities.size);
+    }
+
+    while (progress.entities < decoded.entities.size) {
+        const EntityRecord& record = decoded.entities[progress.entities++];
+
+        const EntityHandle recordParent = record.parent != none ? progress.handles[record.parent] : parent;
+        progress.handles.push_back(Entity::Spawn(decoded.String(record.name), recordParent, Layer::Get(decoded.String(record.layer))));
+        if (record.parent == none) { progress.roots.push_back(progress.handles.back()); }
+
+        if (expired(progress.entities)) { return false; }
+    }
+
+    while (progress.transforms < decoded.transforms.size) {
+        const TransformRecord& record = decoded.transforms[progress.transforms++];
+
+        Entity* entity = progress.handles[record.entity].Get();
+        if (!entity) { continue; }
+
+        entity->AddComponent<Transform>();
+        auto* transform = entity->GetComponent<Transform>();
+        transform->SetPosition(Vector3 { record.position[0], record.position[1], record.position[2] });
+        transform->SetRotation(Quaternion { Vector3 { record.rotation[0], record.rotation[1], record.rotation[2] }, record.rotation[3] });
+        transform->SetScale(Vector3 { record.scale[0], record.scale[1], record.scale[2] });
+
+        if (expired(progress.transforms)) { return false; }
+    }
+
+    while (progress.renderers < decoded.renderers.size) {
+        const RendererRecord& record = decoded.renderers[progress.renderers++];
+
+        Entity* entity = progress.handles[record.entity].Get();
+        if (!entity) { continue; }
+
+        const string      assetPath = decoded.String(decoded.assets[record.asset].path);
+        shared<SceneData> asset;
+        {
+            std::lock_guard<std::mutex> lock(assetsMutex);
+            shared<SceneData>& cached = assets[assetPath];
+            if (!cached && record.asset < decoded.readAssets.size()) { cached = decoded.readAssets[record.asset]; }
+            asset = cached;
+        }
+        /* Asset was not read by ReadAssets, it is imported here and may wait for a decoding job to finish its read */
+        if (!asset) {
+            {
+                std::lock_guard<std::mutex> lock(importerMutex);
+                asset = SceneImporter().Import(assetPath);
+            }
+            std::lock_guard<std::mutex> lock(assetsMutex);
+            assets[assetPath] = asset;
+        }
+        SceneImporter::Upload(*asset);
+
+        if (record.object >= asset->objects.size()) {
+            Logger::Log(SCENE, WARN) << "Object " << record.object << " is out of bounds of " << assetPath << ", skipping";
+            continue;
+        }
+
+        entity->AddComponent<Renderer>(asset->LoadModel(record.object));
+        entity->GetComponent<Renderer>()->SetSource({ assetPath, record.object });
+
+        if (expired(progress.renderers)) { return false; }
+    }
+
+    return true;
+}
+
+vector<EntityHandle> SceneSnapshot::Load(const string& path, EntityHandle parent) {
+    Decoded decoded;
+    try {
+        decoded = Decode(path);
+    } catch (const std::exception& e) {
+        Logger::Log(IMPORT, ERR_HERE) << e.what();
+        throw;
+    }
+
+    Progress progress;
+    Instantiate(decoded, progress, parent);
+
+    Logger::Log(SCENE, INFO) << "Loaded " << progress.handles.size() << " entities from snapshot " << path;
+    return progress.roots;
+}
+
+} // namespace core
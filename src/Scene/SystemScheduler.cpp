@@ -0,0 +1,84 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <core/Scene/SystemScheduler.h>
+
+namespace core {
+
+SystemScheduler::SystemScheduler(JobSystem& jobSystem)
+: jobSystem(jobSystem)
+{
+
+}
+void SystemScheduler::Run(void (ITicker::*runPhase)()) {
+    std::lock_guard<std::mutex> runGuard(runMutex);
+    if (systems.empty()) { return; }
+
+    BuildGraph();
+    phase   = runPhase;
+    failure = nullptr;
+
+    JobCounter counter;
+    for (uint32_t i = 0; i < graph.size(); ++i) {
+        if (graph[i].dependencies == 0) { Schedule(i, counter); }
+    }
+
+    /** Help the workers until every system is done */
+    jobSystem.Wait(counter);
+    phase = nullptr;
+
+    if (failure) { std::rethrow_exception(failure); }
+}
+void SystemScheduler::BuildGraph() {
+    graph.assign(systems.size(), Node { });
+    pending = make_unique<std::atomic<uint32_t>[]>(systems.size());
+
+    for (uint32_t i = 0; i < systems.size(); ++i) {
+        for (uint32_t j = i + 1; j < systems.size(); ++j) {
+            if (systems[i]->ConflictsWith(*systems[j])) {
+                graph[i].dependents.push_back(j);
+                graph[j].dependencies++;
+            }
+        }
+    }
+    for (uint32_t i = 0; i < graph.size(); ++i) {
+        pending[i] = graph[i].dependencies;
+    }
+}
+void SystemScheduler::Schedule(uint32_t id, JobCounter& counter) {
+    jobSystem.Schedule([this, id, &counter] {
+        try {
+            (static_cast<ITicker*>(systems[id].get())->*phase)();
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(failureMutex);
+            if (!failure) { failure = std::current_exception(); }
+        }
+
+        for (uint32_t dependent : graph[id].dependents) {
+            if (pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) { Schedule(dependent, counter); }
+        }
+    }, &counter);
+}
+
+} // namespace core
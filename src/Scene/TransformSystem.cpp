@@ -0,0 +1,190 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <core/Scene/TransformSystem.h>
+#include <core/Scene/SceneHierarchy.h>
+#include <core/Components/Transform.h>
+#include <core/Components/Bounds.h>
+#include <core/JobSystem.h>
+#include <core/Entity.h>
+
+#include <algorithm>
+
+namespace core {
+
+namespace {
+
+using Hierarchy = SceneHierarchy<Entity>;
+
+}
+
+TransformSystem::TransformSystem(JobSystem& jobSystem)
+: jobSystem(jobSystem)
+{ }
+TransformSystem::Queue& TransformSystem::Pending() {
+    static auto* queue = new Queue();
+    return *queue;
+}
+void TransformSystem::UpdateNode(Entity& entity) {
+    if (Transform* transform = entity.GetComponent<Transform>()) {
+        transform->UpdateWorldTransform();
+    }
+}
+void TransformSystem::NotifyNode(Transform& transform) {
+    if (Bounds* bounds = transform.entity->GetComponent<Bounds>()) {
+        bounds->UpdateWorldBounds(transform.GetWorldTransformMatrix());
+    }
+    transform.OnTransformChange.Trigger(transform.GetWorldTransformMatrix());
+}
+void TransformSystem::ComposeLocalTransforms() {
+    const size_t count = composed.transforms.size();
+    if (count == 0) { return; }
+
+    for (auto& component : composed.position) { component.resize(count); }
+    for (auto& component : composed.rotation) { component.resize(count); }
+    for (auto& component : composed.scale)    { component.resize(count); }
+    composed.matrices.resize(count);
+
+    for (size_t i = 0; i < count; ++i) {
+        const Transform& transform = *composed.transforms[i];
+        for (size_t c = 0; c < 3; ++c) {
+            composed.position[c][i] = transform.position[c];
+            composed.rotation[c][i] = transform.rotation.vector()[c];
+            composed.scale[c][i]    = transform.scale[c];
+        }
+        composed.rotation[3][i] = transform.rotation.scalar();
+    }
+
+    const Math::TransformArrays input {
+        { composed.position[0].data(), composed.position[1].data(), composed.position[2].data() },
+        { composed.rotation[0].data(), composed.rotation[1].data(), composed.rotation[2].data(), composed.rotation[3].data() },
+        { composed.scale[0].data(), composed.scale[1].data(), composed.scale[2].data() } };
+    Math::ComposeTransforms(input, composed.matrices.data(), count);
+
+    for (size_t i = 0; i < count; ++i) {
+        composed.transforms[i]->localTransform = composed.matrices[i];
+        composed.transforms[i]->localDirty = false;
+    }
+}
+void TransformSystem::ExtractNormalMatrices() {
+    const size_t count = extracted.transforms.size();
+    if (count == 0) { return; }
+
+    extracted.matrices.resize(count);
+    extracted.normals.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        extracted.matrices[i] = extracted.transforms[i]->worldTransform;
+    }
+
+    Math::ExtractNormalMatrices(extracted.matrices.data(), extracted.normals.data(), count);
+
+    for (size_t i = 0; i < count; ++i) {
+        extracted.transforms[i]->normalMatrix = extracted.normals[i];
+    }
+}
+void TransformSystem::Enqueue(EntityHandle entity) {
+    Queue& pending = Pending();
+    std::lock_guard<std::mutex> guard(pending.mutex);
+    pending.entities.push_back(entity);
+}
+void TransformSystem::Update() {
+    Queue& pending = Pending();
+    {
+        std::lock_guard<std::mutex> guard(pending.mutex);
+        queued.swap(pending.entities);
+    }
+    if (queued.empty()) { return; }
+
+    roots.clear();
+    split.clear();
+    composed.transforms.clear();
+    for (EntityHandle handle : queued) {
+        Transform* transform = handle.GetComponent<Transform>();
+        if (!transform) { continue; }
+
+        transform->queued.store(false, std::memory_order_release);
+        roots.push_back(handle.index);
+        if (transform->localDirty) { composed.transforms.push_back(transform); }
+    }
+    queued.clear();
+
+    /* Only written transforms have outdated local matrices, their descendants just need new world ones */
+    ComposeLocalTransforms();
+
+    /* Ancestors come first in hierarchy order, so nodes inside of an already kept subtree are skipped */
+    std::sort(roots.begin(), roots.end(), [](uint32_t lhs, uint32_t rhs) {
+        return Hierarchy::GetPosition(lhs) < Hierarchy::GetPosition(rhs);
+    });
+    size_t   kept       = 0;
+    uint32_t coveredEnd = 0;
+    for (uint32_t node : roots) {
+        const uint32_t position = Hierarchy::GetPosition(node);
+        if (position < coveredEnd) { continue; }
+
+        roots[kept++] = node;
+        coveredEnd = position + Hierarchy::GetSubtreeSize(node);
+    }
+    roots.resize(kept);
+
+    /* Split large subtrees into subtrees of their children, so a single moved root still spreads across workers */
+    const size_t jobCount = static_cast<size_t>(jobSystem.ThreadCount()) * 4;
+    for (size_t i = 0; i < roots.size() && roots.size() < jobCount;) {
+        const uint32_t node = roots[i];
+        if (Hierarchy::GetSubtreeSize(node) <= splitSize || Hierarchy::GetFirstChild(node) == Hierarchy::none) {
+            ++i;
+            continue;
+        }
+
+        UpdateNode(*Hierarchy::GetObject(node));
+        split.push_back(node);
+
+        roots[i] = roots.back();
+        roots.pop_back();
+        for (uint32_t child = Hierarchy::GetFirstChild(node); child != Hierarchy::none; child = Hierarchy::GetNextSibling(child)) {
+            roots.push_back(child);
+        }
+    }
+
+    jobSystem.ParallelFor(0, roots.size(), [this](size_t i) {
+        Hierarchy::EachInSubtree(roots[i], UpdateNode);
+    }, 1);
+
+    extracted.transforms.clear();
+    auto gather = [this](Entity& entity) {
+        if (Transform* transform = entity.GetComponent<Transform>()) { extracted.transforms.push_back(transform); }
+    };
+    for (uint32_t node : split) {
+        gather(*Hierarchy::GetObject(node));
+    }
+    for (uint32_t node : roots) {
+        Hierarchy::EachInSubtree(node, gather);
+    }
+    ExtractNormalMatrices();
+
+    /* Subscribers are not expected to be thread-safe, notify them after all matrices are final */
+    for (Transform* transform : extracted.transforms) {
+        NotifyNode(*transform);
+    }
+}
+
+} // namespace core
@@ -0,0 +1,183 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <core/Scene/WorldPartition.h>
+#include <core/Entity.h>
+#include <core/Logger.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace core {
+
+WorldPartition::WorldPartition(float cellSize, float loadRadius, float unloadRadius, EntityHandle parent, JobSystem& jobSystem)
+: cellSize(cellSize), loadRadius(loadRadius), unloadRadius(std::max(loadRadius, unloadRadius)),
+  parent(parent), jobSystem(jobSystem)
+{ }
+WorldPartition::~WorldPartition() {
+    for (auto& entry : cells) {
+        Cell& cell = entry.second;
+        if (cell.decoding) { jobSystem.Wait(*cell.decoding); }
+        Entity::Destroy(cell.root);
+    }
+}
+void WorldPartition::AddCell(Vector2i coordinates, const string& snapshotPath) {
+    auto inserted = cells.try_emplace(Key(coordinates));
+    if (!inserted.second) {
+        Logger::Log(SCENE, ERR_HERE) << "Cell " << coordinates.x() << ", " << coordinates.y() << " is already registered";
+        throw std::logic_error("Cell is already registered");
+    }
+
+    Cell& cell = inserted.first->second;
+    cell.coordinates = coordinates;
+    cell.path        = snapshotPath;
+}
+void WorldPartition::Update(const Vector3& focus, std::chrono::microseconds budget) {
+    const auto deadline = std::chrono::steady_clock::now() + budget;
+
+    vector<std::pair<float, Cell*>> pending;
+    for (auto& entry : cells) {
+        Cell& cell = entry.second;
+        const float distance = Distance(cell, focus);
+
+        switch (cell.state) {
+            case CellState::Unloaded:
+                if (distance < loadRadius && cell.failure.empty()) { StartDecoding(cell); }
+                break;
+            case CellState::Decoding:
+                if (!cell.decoding->IsDone()) { break; }
+
+                cell.decoding.reset();
+                if (!cell.failure.empty()) {
+                    Logger::Log(SCENE, ERR) << "Failed to stream cell " << cell.path << ": " << cell.failure;
+                    cell.state = CellState::Unloaded;
+                } else if (distance > unloadRadius) {
+                    cell.decoded = { };
+                    cell.state = CellState::Unloaded;
+                } else {
+                    cell.state = CellState::Instantiating;
+                }
+                break;
+            case CellState::Instantiating:
+            case CellState::Loaded:
+                if (distance > unloadRadius) {
+                    cell.decoded  = { };
+                    cell.progress = { };
+                    cell.state = CellState::Unloading;
+                }
+                break;
+            case CellState::Unloading:
+                break;
+        }
+
+        if (cell.state == CellState::Instantiating || cell.state == CellState::Unloading) {
+            pending.emplace_back(distance, &cell);
+        }
+    }
+
+    /* Nearest cells are finalized first, they are the most likely to be seen */
+    std::sort(pending.begin(), pending.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (auto& entry : pending) {
+        if (std::chrono::steady_clock::now() >= deadline) { break; }
+
+        Cell& cell = *entry.second;
+        if (cell.state == CellState::Instantiating && Instantiate(cell, deadline)) {
+            cell.state = CellState::Loaded;
+        } else if (cell.state == CellState::Unloading && Unload(cell, deadline)) {
+            cell.state = CellState::Unloaded;
+        }
+    }
+}
+bool WorldPartition::IsLoaded(Vector2i coordinates) const {
+    auto it = cells.find(Key(coordinates));
+    return it != cells.end() && it->second.state == CellState::Loaded;
+}
+Vector2i WorldPartition::GetCell(const Vector3& point) const {
+    return { static_cast<int>(std::floor(point.x() / cellSize)), static_cast<int>(std::floor(point.z() / cellSize)) };
+}
+uint64_t WorldPartition::Key(Vector2i cell) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(cell.x())) << 32 | static_cast<uint32_t>(cell.y());
+}
+float WorldPartition::Distance(const Cell& cell, const Vector3& focus) const {
+    const float dx = (static_cast<float>(cell.coordinates.x()) + 0.5f) * cellSize - focus.x();
+    const float dz = (static_cast<float>(cell.coordinates.y()) + 0.5f) * cellSize - focus.z();
+    return std::sqrt(dx * dx + dz * dz);
+}
+void WorldPartition::StartDecoding(Cell& cell) {
+    cell.state    = CellState::Decoding;
+    cell.decoding = unique<JobCounter>(new JobCounter());
+
+    /* Cells are never erased and map nodes do not move, so the job can keep a pointer */
+    Cell* target = &cell;
+    jobSystem.Schedule([this, target] {
+        try {
+            target->decoded = SceneSnapshot::Decode(target->path);
+            snapshot.ReadAssets(target->decoded);
+        } catch (const std::exception& e) {
+            target->failure = e.what();
+        }
+    }, cell.decoding.get());
+
+    /* Without workers the job would only run once somebody waits for it */
+    if (jobSystem.ThreadCount() == 1) { jobSystem.Wait(*cell.decoding); }
+}
+bool WorldPartition::Instantiate(Cell& cell, std::chrono::steady_clock::time_point deadline) {
+    if (!cell.root) {
+        const string name = "Cell " + std::to_string(cell.coordinates.x()) + ", " + std::to_string(cell.coordinates.y());
+        cell.root = Entity::Spawn(name, parent);
+    }
+
+    if (!snapshot.Instantiate(cell.decoded, cell.progress, cell.root, deadline)) { return false; }
+
+    cell.decoded  = { };
+    cell.progress = { };
+    return true;
+}
+bool WorldPartition::Unload(Cell& cell, std::chrono::steady_clock::time_point deadline) {
+    if (!cell.root.Get()) { return true; }
+
+    /*
+     * Entities are destroyed deepest first, one leaf at a time, so no single Destroy tears down a whole subtree
+     * and unloading a dense cell is spread over frames. Clock is read once per batch of entities
+     */
+    using Hierarchy = SceneHierarchy<Entity>;
+    constexpr size_t batchSize = 64;
+    const uint32_t top = cell.root.index;
+    uint32_t node = top;
+    for (size_t destroyed = 1; ; ++destroyed) {
+        while (Hierarchy::GetFirstChild(node) != Hierarchy::none) { node = Hierarchy::GetFirstChild(node); }
+        if (node == top) { break; }
+
+        const uint32_t parentNode = Hierarchy::GetParent(node);
+        Entity::Destroy(Hierarchy::GetObject(node)->GetHandle());
+        node = parentNode;
+
+        if (destroyed % batchSize == 0 && std::chrono::steady_clock::now() >= deadline) { return false; }
+    }
+
+    Entity::Destroy(cell.root);
+    cell.root = { };
+    return true;
+}
+
+} // namespace core
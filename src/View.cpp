@@ -24,6 +24,7 @@
 #include <core/View.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <core/Logger.h>
+#include <core/EventBus.h>
 #include "Magnum/GL/Renderer.h"
 #include "Magnum/GL/AbstractFramebuffer.h"
 
@@ -58,7 +59,9 @@ void View::Resize(Vector2i pos, Vector2i size) {
     frameBuffer.attachRenderbuffer(GL::Framebuffer::ColorAttachment { 0 }, colorBuffer);
     frameBuffer.attachRenderbuffer(GL::Framebuffer::BufferAttachment::DepthStencil, depthStencil);
 
-    OnResize.Trigger(frameBuffer.viewport().size());
+    Vector2i viewport = frameBuffer.viewport().size();
+    OnResize.Trigger(viewport);
+    EventBus::Publish(ViewResized { this, viewport });
 }
 void View::Bind() {
     frameBuffer
@@ -0,0 +1,386 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include <core/Essentials.h>
+#include <core/Scene/BoundingVolumeTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace core { namespace Test {
+
+struct BoundingVolumeTreeTest : Corrade::TestSuite::Tester {
+    explicit BoundingVolumeTreeTest();
+
+    void Empty();
+    void Insert();
+    void Remove();
+    void Move();
+    void Rebuild();
+    void QueryOverlapBatch();
+    void QuerySphere();
+    void QueryRay();
+    void QueryFrustum();
+};
+
+namespace {
+
+using Tree = BoundingVolumeTree<uint32_t>;
+
+constexpr uint32_t boxCount = 2000;
+constexpr uint32_t queryCount = 64;
+
+float Random(std::mt19937& random, float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(random);
+}
+Range3D RandomBox(std::mt19937& random) {
+    const Vector3 min  { Random(random, -100, 100), Random(random, -100, 100), Random(random, -100, 100) };
+    const Vector3 size { Random(random, 0.1f, 5), Random(random, 0.1f, 5), Random(random, 0.1f, 5) };
+    return { min, min + size };
+}
+bool Overlaps(const Range3D& a, const Range3D& b) {
+    for (int i = 0; i < 3; ++i) {
+        if (a.max()[i] < b.min()[i] || b.max()[i] < a.min()[i]) { return false; }
+    }
+    return true;
+}
+
+/**
+ * Boxes kept next to the tree, by value, so every query is compared against a linear scan
+ * @details Values stored in the tree are indices into boxes, removed boxes are marked as not alive
+ */
+struct Reference {
+    uint32_t Insert(Tree& tree, const Range3D& box) {
+        const uint32_t value = static_cast<uint32_t>(boxes.size());
+        boxes.push_back(box);
+        alive.push_back(true);
+        proxies.push_back(tree.Insert(box, value));
+        return value;
+    }
+    template<typename F>
+    vector<uint32_t> Scan(F&& hits) const {
+        vector<uint32_t> result;
+        for (uint32_t i = 0; i < boxes.size(); ++i) {
+            if (alive[i] && hits(boxes[i])) { result.push_back(i); }
+        }
+        return result;
+    }
+    size_t Size() const {
+        return static_cast<size_t>(std::count(alive.begin(), alive.end(), true));
+    }
+
+    vector<Range3D>  boxes;
+    vector<bool>     alive;
+    vector<uint32_t> proxies;
+};
+
+vector<uint32_t> Sorted(vector<uint32_t> values) {
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+/* Incrementally built tree is kept balanced by rotations, so it stays within a small factor of log2 */
+uint32_t MaxHeight(size_t size) {
+    return 2 * static_cast<uint32_t>(std::ceil(std::log2(static_cast<float>(std::max<size_t>(size, 2)))));
+}
+
+}
+
+BoundingVolumeTreeTest::BoundingVolumeTreeTest() {
+    addTests({ &BoundingVolumeTreeTest::Empty,
+               &BoundingVolumeTreeTest::Insert,
+               &BoundingVolumeTreeTest::Remove,
+               &BoundingVolumeTreeTest::Move,
+               &BoundingVolumeTreeTest::Rebuild,
+               &BoundingVolumeTreeTest::QueryOverlapBatch,
+               &BoundingVolumeTreeTest::QuerySphere,
+               &BoundingVolumeTreeTest::QueryRay,
+               &BoundingVolumeTreeTest::QueryFrustum });
+}
+
+/* Every query of the tree has to match the linear scan exactly */
+#define CORE_COMPARE_OVERLAP(tree, reference, random)                                                   \
+    for (uint32_t q = 0; q < queryCount; ++q) {                                                         \
+        CORRADE_ITERATION(q);                                                                           \
+        const Range3D query = RandomBox(random);                                                        \
+        vector<uint32_t> result;                                                                        \
+        (tree).QueryOverlap(query, result);                                                             \
+        CORRADE_COMPARE(Sorted(result), (reference).Scan([&](const Range3D& box) { return Overlaps(box, query); })); \
+    }
+
+void BoundingVolumeTreeTest::Empty() {
+    Tree tree;
+    CORRADE_COMPARE(tree.Size(), 0);
+    CORRADE_COMPARE(tree.GetHeight(), 0);
+
+    vector<uint32_t> result;
+    tree.QueryOverlap(Range3D { Vector3 { -1000 }, Vector3 { 1000 } }, result);
+    tree.QuerySphere({ }, 1000, result);
+    tree.QueryRay({ }, { 1, 0, 0 }, 1000, result);
+    CORRADE_VERIFY(result.empty());
+
+    const uint32_t proxy = tree.Insert(Range3D { Vector3 { 0 }, Vector3 { 1 } }, 7);
+    CORRADE_COMPARE(tree.Size(), 1);
+    CORRADE_COMPARE(tree.GetHeight(), 0);
+
+    tree.Remove(proxy);
+    CORRADE_COMPARE(tree.Size(), 0);
+    tree.QueryOverlap(Range3D { Vector3 { -1000 }, Vector3 { 1000 } }, result);
+    CORRADE_VERIFY(result.empty());
+}
+
+void BoundingVolumeTreeTest::Insert() {
+    std::mt19937 random { 19 };
+    Tree tree;
+    Reference reference;
+
+    for (uint32_t i = 0; i < boxCount; ++i) {
+        reference.Insert(tree, RandomBox(random));
+        CORRADE_COMPARE(tree.Size(), i + 1);
+    }
+    CORRADE_VERIFY(tree.GetHeight() <= MaxHeight(tree.Size()));
+
+    /* Proxies keep returning what was inserted */
+    for (uint32_t i = 0; i < boxCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(tree.GetValue(reference.proxies[i]), i);
+        CORRADE_COMPARE(tree.GetBounds(reference.proxies[i]), reference.boxes[i]);
+    }
+
+    CORE_COMPARE_OVERLAP(tree, reference, random);
+}
+
+void BoundingVolumeTreeTest::Remove() {
+    std::mt19937 random { 19 };
+    Tree tree;
+    Reference reference;
+    for (uint32_t i = 0; i < boxCount; ++i) { reference.Insert(tree, RandomBox(random)); }
+
+    /* Every other box, then reinsert a few, so freed nodes get reused */
+    for (uint32_t i = 0; i < boxCount; i += 2) {
+        tree.Remove(reference.proxies[i]);
+        reference.alive[i] = false;
+    }
+    CORRADE_COMPARE(tree.Size(), reference.Size());
+    CORRADE_VERIFY(tree.GetHeight() <= MaxHeight(tree.Size()));
+    CORE_COMPARE_OVERLAP(tree, reference, random);
+
+    for (uint32_t i = 0; i < boxCount / 4; ++i) { reference.Insert(tree, RandomBox(random)); }
+    CORRADE_COMPARE(tree.Size(), reference.Size());
+    CORE_COMPARE_OVERLAP(tree, reference, random);
+
+    /* Removed proxy, unless its node got reused by a later insert, is rejected */
+    const uint32_t removed = reference.proxies[0];
+    if (std::find(reference.proxies.begin() + boxCount, reference.proxies.end(), removed) == reference.proxies.end()) {
+        bool thrown = false;
+        try { tree.Remove(removed); } catch (const std::out_of_range&) { thrown = true; }
+        CORRADE_VERIFY(thrown);
+    }
+
+    for (uint32_t i = 0; i < reference.proxies.size(); ++i) {
+        if (reference.alive[i]) { tree.Remove(reference.proxies[i]); }
+    }
+    CORRADE_COMPARE(tree.Size(), 0);
+    CORRADE_COMPARE(tree.GetHeight(), 0);
+}
+
+void BoundingVolumeTreeTest::Move() {
+    std::mt19937 random { 19 };
+    Tree tree { 0.5f };
+    Reference reference;
+    for (uint32_t i = 0; i < boxCount; ++i) { reference.Insert(tree, RandomBox(random)); }
+
+    /* Moving within the margin keeps the tree, leaving it reinserts the box */
+    const Range3D nudged { reference.boxes[0].min() + Vector3 { 0.25f }, reference.boxes[0].max() + Vector3 { 0.25f } };
+    CORRADE_VERIFY(!tree.Move(reference.proxies[0], nudged));
+    reference.boxes[0] = nudged;
+
+    const Range3D moved { reference.boxes[1].min() + Vector3 { 10.0f }, reference.boxes[1].max() + Vector3 { 10.0f } };
+    CORRADE_VERIFY(tree.Move(reference.proxies[1], moved));
+    reference.boxes[1] = moved;
+
+    for (uint32_t i = 2; i < boxCount; ++i) {
+        const Vector3 offset { Random(random, -3, 3), Random(random, -3, 3), Random(random, -3, 3) };
+        reference.boxes[i] = { reference.boxes[i].min() + offset, reference.boxes[i].max() + offset };
+        tree.Move(reference.proxies[i], reference.boxes[i]);
+    }
+
+    for (uint32_t i = 0; i < boxCount; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(tree.GetBounds(reference.proxies[i]), reference.boxes[i]);
+        CORRADE_COMPARE(tree.GetValue(reference.proxies[i]), i);
+    }
+    CORRADE_COMPARE(tree.Size(), boxCount);
+    CORRADE_VERIFY(tree.GetHeight() <= MaxHeight(tree.Size()));
+    CORE_COMPARE_OVERLAP(tree, reference, random);
+}
+
+void BoundingVolumeTreeTest::Rebuild() {
+    std::mt19937 random { 19 };
+    Tree tree;
+    Reference reference;
+    for (uint32_t i = 0; i < boxCount; ++i) { reference.Insert(tree, RandomBox(random)); }
+    for (uint32_t i = 0; i < boxCount; i += 3) {
+        tree.Remove(reference.proxies[i]);
+        reference.alive[i] = false;
+    }
+
+    tree.Rebuild();
+
+    /* Proxies survive the rebuild */
+    CORRADE_COMPARE(tree.Size(), reference.Size());
+    for (uint32_t i = 0; i < boxCount; ++i) {
+        if (!reference.alive[i]) { continue; }
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(tree.GetValue(reference.proxies[i]), i);
+        CORRADE_COMPARE(tree.GetBounds(reference.proxies[i]), reference.boxes[i]);
+    }
+    CORE_COMPARE_OVERLAP(tree, reference, random);
+
+    /* Rebuilt tree keeps working incrementally */
+    for (uint32_t i = 0; i < boxCount / 4; ++i) { reference.Insert(tree, RandomBox(random)); }
+    for (uint32_t i = 1; i < boxCount; i += 3) {
+        tree.Remove(reference.proxies[i]);
+        reference.alive[i] = false;
+    }
+    CORRADE_COMPARE(tree.Size(), reference.Size());
+    CORE_COMPARE_OVERLAP(tree, reference, random);
+
+    tree.Clear();
+    tree.Rebuild();
+    CORRADE_COMPARE(tree.Size(), 0);
+    CORRADE_COMPARE(tree.GetHeight(), 0);
+}
+
+void BoundingVolumeTreeTest::QueryOverlapBatch() {
+    std::mt19937 random { 19 };
+    Tree tree;
+    Reference reference;
+    for (uint32_t i = 0; i < boxCount; ++i) { reference.Insert(tree, RandomBox(random)); }
+
+    vector<Range3D> queries;
+    for (uint32_t i = 0; i < queryCount; ++i) { queries.push_back(RandomBox(random)); }
+
+    /* Results are appended after what is already in the vector */
+    vector<uint32_t> result { 12345 };
+    vector<uint32_t> offsets;
+    tree.QueryOverlap(queries, result, offsets);
+
+    CORRADE_COMPARE(offsets.size(), queries.size() + 1);
+    CORRADE_COMPARE(offsets.front(), 1);
+    CORRADE_COMPARE(offsets.back(), result.size());
+    CORRADE_COMPARE(result.front(), 12345);
+    for (uint32_t q = 0; q < queries.size(); ++q) {
+        CORRADE_ITERATION(q);
+        const vector<uint32_t> hits(result.begin() + offsets[q], result.begin() + offsets[q + 1]);
+        CORRADE_COMPARE(Sorted(hits), reference.Scan([&](const Range3D& box) { return Overlaps(box, queries[q]); }));
+    }
+}
+
+void BoundingVolumeTreeTest::QuerySphere() {
+    std::mt19937 random { 19 };
+    Tree tree;
+    Reference reference;
+    for (uint32_t i = 0; i < boxCount; ++i) { reference.Insert(tree, RandomBox(random)); }
+
+    for (uint32_t q = 0; q < queryCount; ++q) {
+        CORRADE_ITERATION(q);
+        const Vector3 center { Random(random, -100, 100), Random(random, -100, 100), Random(random, -100, 100) };
+        const float   radius = Random(random, 0, 20);
+
+        vector<uint32_t> result;
+        tree.QuerySphere(center, radius, result);
+        CORRADE_COMPARE(Sorted(result), reference.Scan([&](const Range3D& box) {
+            const Vector3 closest = Magnum::Math::clamp(center, box.min(), box.max());
+            return (closest - center).dot() <= radius * radius;
+        }));
+    }
+}
+
+void BoundingVolumeTreeTest::QueryRay() {
+    std::mt19937 random { 19 };
+    Tree tree;
+    Reference reference;
+    for (uint32_t i = 0; i < boxCount; ++i) { reference.Insert(tree, RandomBox(random)); }
+
+    /* Axis-aligned rays are included to exercise the parallel slab case */
+    const Vector3 directions[] { { 1, 0, 0 }, { 0, -1, 0 }, { 0, 0, 1 } };
+    for (uint32_t q = 0; q < queryCount; ++q) {
+        CORRADE_ITERATION(q);
+        const Vector3 origin { Random(random, -100, 100), Random(random, -100, 100), Random(random, -100, 100) };
+        const Vector3 direction = q < std::size(directions) ? directions[q]
+            : Vector3 { Random(random, -1, 1), Random(random, -1, 1), Random(random, -1, 1) }.normalized();
+        const float maxDistance = Random(random, 10, 200);
+
+        vector<uint32_t> result;
+        tree.QueryRay(origin, direction, maxDistance, result);
+
+        /* Ray hits a box if it passes through it before maxDistance, found by clipping to every slab */
+        CORRADE_COMPARE(Sorted(result), reference.Scan([&](const Range3D& box) {
+            float first = 0.0f, last = maxDistance;
+            for (int i = 0; i < 3; ++i) {
+                if (direction[i] == 0.0f) {
+                    if (origin[i] < box.min()[i] || origin[i] > box.max()[i]) { return false; }
+                    continue;
+                }
+                const float a = (box.min()[i] - origin[i]) / direction[i];
+                const float b = (box.max()[i] - origin[i]) / direction[i];
+                first = std::max(first, std::min(a, b));
+                last  = std::min(last,  std::max(a, b));
+            }
+            return first <= last;
+        }));
+    }
+}
+
+void BoundingVolumeTreeTest::QueryFrustum() {
+    std::mt19937 random { 19 };
+    Tree tree;
+    Reference reference;
+    for (uint32_t i = 0; i < boxCount; ++i) { reference.Insert(tree, RandomBox(random)); }
+
+    /* Frustum of axis-aligned planes bounds a box, so the conservative plane test is exact for it */
+    for (uint32_t q = 0; q < queryCount; ++q) {
+        CORRADE_ITERATION(q);
+        const Range3D region = RandomBox(random);
+        const Range3D volume { region.min() - Vector3 { 20 }, region.max() + Vector3 { 20 } };
+        const Frustum frustum {
+            {  1,  0,  0, -volume.min().x() }, { -1,  0,  0, volume.max().x() },
+            {  0,  1,  0, -volume.min().y() }, {  0, -1,  0, volume.max().y() },
+            {  0,  0,  1, -volume.min().z() }, {  0,  0, -1, volume.max().z() } };
+
+        vector<uint32_t> result;
+        tree.QueryFrustum(frustum, result);
+        CORRADE_COMPARE(Sorted(result), reference.Scan([&](const Range3D& box) { return Overlaps(box, volume); }));
+    }
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::BoundingVolumeTreeTest)
@@ -0,0 +1,256 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/EventBus.h>
+
+#include <stdexcept>
+
+namespace core { namespace Test {
+
+struct EventBusTest : Corrade::TestSuite::Tester {
+    explicit EventBusTest();
+
+    void Batch();
+    void NoSubscribers();
+    void WrapAround();
+    void GrowDuringDrain();
+    void PhaseCursors();
+    void LateSubscriber();
+    void InvalidPhase();
+};
+
+namespace {
+
+/* Channels are global per event type, so every test publishes its own type */
+template<int Test>
+struct Numbered {
+    uint64_t number;
+};
+
+/**
+ * Checks that events arrive exactly once and in publishing order
+ */
+template<int Test>
+struct Receiver {
+    void operator()(const EventBatch<Numbered<Test>>& batch) {
+        ++batches;
+        for (const Numbered<Test>& event : batch) {
+            ordered = ordered && event.number == next;
+            next = event.number + 1;
+        }
+    }
+
+    uint64_t next    { 0 };
+    size_t   batches { 0 };
+    bool     ordered { true };
+};
+
+}
+
+EventBusTest::EventBusTest() {
+    addTests({ &EventBusTest::Batch,
+               &EventBusTest::NoSubscribers,
+               &EventBusTest::WrapAround,
+               &EventBusTest::GrowDuringDrain,
+               &EventBusTest::PhaseCursors,
+               &EventBusTest::LateSubscriber,
+               &EventBusTest::InvalidPhase });
+}
+
+void EventBusTest::Batch() {
+    using Event = Numbered<0>;
+    Receiver<0> receiver;
+    Subscription subscription = EventBus::SubscribeScoped<Event>(TickerPhase::Tick, [&](const EventBatch<Event>& batch) { receiver(batch); });
+
+    /* Nothing queued, nothing handed out */
+    EventBus::Drain(TickerPhase::Tick);
+    CORRADE_COMPARE(receiver.batches, 0);
+
+    for (uint64_t i = 0; i < 10; ++i) { EventBus::Publish(Event { i }); }
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 10);
+
+    /* Other phases don't touch the queue */
+    EventBus::Drain(TickerPhase::EarlyTick);
+    CORRADE_COMPARE(receiver.batches, 0);
+
+    EventBus::Drain(TickerPhase::Tick);
+    CORRADE_COMPARE(receiver.batches, 1);
+    CORRADE_COMPARE(receiver.next, 10);
+    CORRADE_VERIFY(receiver.ordered);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 0);
+}
+
+void EventBusTest::NoSubscribers() {
+    using Event = Numbered<1>;
+
+    /* Events nobody listens to are dropped right away */
+    for (uint64_t i = 0; i < 1000; ++i) { EventBus::Publish(Event { i }); }
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 0);
+}
+
+void EventBusTest::WrapAround() {
+    using Event = Numbered<2>;
+    Receiver<2> receiver;
+    Subscription subscription = EventBus::SubscribeScoped<Event>(TickerPhase::Tick, [&](const EventBatch<Event>& batch) { receiver(batch); });
+
+    /* Fewer than the initial 64 events in flight, so the ring never grows and its write index keeps wrapping */
+    uint64_t published = 0;
+    size_t   splitFrames = 0;
+    for (int frame = 0; frame < 100; ++frame) {
+        CORRADE_ITERATION(frame);
+        const size_t count = 20 + static_cast<size_t>(frame * 7) % 40;
+        for (size_t i = 0; i < count; ++i) { EventBus::Publish(Event { published++ }); }
+
+        const size_t batchesBefore = receiver.batches;
+        EventBus::Drain(TickerPhase::Tick);
+        CORRADE_VERIFY(receiver.batches - batchesBefore >= 1 && receiver.batches - batchesBefore <= 2);
+        splitFrames += receiver.batches - batchesBefore == 2;
+
+        CORRADE_COMPARE(receiver.next, published);
+        CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 0);
+    }
+    CORRADE_VERIFY(receiver.ordered);
+
+    /* Events crossing the end of the ring come in two batches */
+    CORRADE_VERIFY(splitFrames > 0);
+}
+
+void EventBusTest::GrowDuringDrain() {
+    using Event = Numbered<3>;
+    Receiver<3> late;
+    Subscription lateSubscription = EventBus::SubscribeScoped<Event>(TickerPhase::LateTick, [&](const EventBatch<Event>& batch) { late(batch); });
+
+    /* First handler publishes enough to grow the ring several times while its own batch is still being read */
+    uint64_t published = 0;
+    uint64_t tickNext  = 0;
+    bool     tickOrdered = true;
+    Subscription tickSubscription = EventBus::SubscribeScoped<Event>(TickerPhase::Tick, [&](const EventBatch<Event>& batch) {
+        const bool first = tickNext == 0;
+        if (first) {
+            for (int i = 0; i < 1000; ++i) { EventBus::Publish(Event { published++ }); }
+        }
+        for (const Event& event : batch) {
+            tickOrdered = tickOrdered && event.number == tickNext;
+            tickNext = event.number + 1;
+        }
+    });
+
+    for (int i = 0; i < 10; ++i) { EventBus::Publish(Event { published++ }); }
+
+    /* Events published while Tick drains are handed to Tick at its next drain */
+    EventBus::Drain(TickerPhase::Tick);
+    CORRADE_COMPARE(tickNext, 10);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 1010);
+
+    /* LateTick did not drain yet, so it gets them all at once */
+    EventBus::Drain(TickerPhase::LateTick);
+    CORRADE_COMPARE(late.next, 1010);
+    CORRADE_VERIFY(late.ordered);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 1000);
+
+    EventBus::Drain(TickerPhase::Tick);
+    CORRADE_COMPARE(tickNext, 1010);
+    CORRADE_VERIFY(tickOrdered);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 0);
+}
+
+void EventBusTest::PhaseCursors() {
+    using Event = Numbered<4>;
+    Receiver<4> early, tick, late;
+    Subscription earlySubscription = EventBus::SubscribeScoped<Event>(TickerPhase::EarlyTick, [&](const EventBatch<Event>& batch) { early(batch); });
+    Subscription tickSubscription  = EventBus::SubscribeScoped<Event>(TickerPhase::Tick,      [&](const EventBatch<Event>& batch) { tick(batch); });
+    Subscription lateSubscription  = EventBus::SubscribeScoped<Event>(TickerPhase::LateTick,  [&](const EventBatch<Event>& batch) { late(batch); });
+
+    EventBus::Publish(Event { 0 });
+    EventBus::Drain(TickerPhase::EarlyTick);
+    EventBus::Publish(Event { 1 });
+    EventBus::Drain(TickerPhase::Tick);
+    EventBus::Publish(Event { 2 });
+
+    /* Each phase reads from where it stopped, events stay until the slowest phase reads them */
+    CORRADE_COMPARE(early.next, 1);
+    CORRADE_COMPARE(tick.next, 2);
+    CORRADE_COMPARE(late.next, 0);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 3);
+
+    EventBus::Drain(TickerPhase::LateTick);
+    CORRADE_COMPARE(late.next, 3);
+    CORRADE_COMPARE(late.batches, 1);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 2);
+
+    EventBus::Drain(TickerPhase::EarlyTick);
+    CORRADE_COMPARE(early.next, 3);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 1);
+
+    EventBus::Drain(TickerPhase::Tick);
+    CORRADE_COMPARE(tick.next, 3);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 0);
+    CORRADE_VERIFY(early.ordered && tick.ordered && late.ordered);
+}
+
+void EventBusTest::LateSubscriber() {
+    using Event = Numbered<5>;
+    Receiver<5> tick;
+    Subscription tickSubscription = EventBus::SubscribeScoped<Event>(TickerPhase::Tick, [&](const EventBatch<Event>& batch) { tick(batch); });
+
+    for (uint64_t i = 0; i < 5; ++i) { EventBus::Publish(Event { i }); }
+
+    /* Phase subscribed later starts with the next published event and holds back nothing before it */
+    Receiver<5> late;
+    late.next = 5;
+    Subscription lateSubscription = EventBus::SubscribeScoped<Event>(TickerPhase::LateTick, [&](const EventBatch<Event>& batch) { late(batch); });
+    EventBus::Publish(Event { 5 });
+
+    EventBus::Drain(TickerPhase::Tick);
+    CORRADE_COMPARE(tick.next, 6);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 1);
+
+    EventBus::Drain(TickerPhase::LateTick);
+    CORRADE_COMPARE(late.batches, 1);
+    CORRADE_COMPARE(late.next, 6);
+    CORRADE_VERIFY(late.ordered);
+    CORRADE_COMPARE(EventChannel<Event>::Get().Size(), 0);
+}
+
+void EventBusTest::InvalidPhase() {
+    using Event = Numbered<6>;
+
+    /* FixedTick is not drained by the main loop, subscribers would never be called */
+    bool thrown = false;
+    try {
+        EventBus::Subscribe<Event>(TickerPhase::FixedTick, [](const EventBatch<Event>&) { });
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    CORRADE_VERIFY(thrown);
+    CORRADE_VERIFY(!EventBus::IsDrainPhase(TickerPhase::FixedTick));
+    CORRADE_VERIFY(EventBus::IsDrainPhase(TickerPhase::Tick));
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::EventBusTest)
@@ -0,0 +1,221 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/Event.h>
+
+#include <atomic>
+#include <thread>
+
+namespace core { namespace Test {
+
+/**
+ * Event tests, CrossThread ones are meant to run under ThreadSanitizer as well
+ * @see CORE_SANITIZE_THREAD CMake option
+ */
+struct EventTest : Corrade::TestSuite::Tester {
+    explicit EventTest();
+
+    void Trigger();
+    void ScopedSubscription();
+    void SubscribeDuringTrigger();
+    void Move();
+    void Rebind();
+    void CrossThreadStress();
+    void CrossThreadDestroyed();
+};
+
+EventTest::EventTest() {
+    /* Cross-thread tests bind the dispatcher to the main thread, so they go last */
+    addTests({ &EventTest::Trigger,
+               &EventTest::ScopedSubscription,
+               &EventTest::SubscribeDuringTrigger,
+               &EventTest::Move,
+               &EventTest::Rebind,
+               &EventTest::CrossThreadStress,
+               &EventTest::CrossThreadDestroyed });
+}
+
+void EventTest::Trigger() {
+    Event<int> event;
+    event.Trigger(1);
+
+    int sum = 0;
+    event.Subscribe([&](int& value) { sum += value; });
+    event.Subscribe([&](int& value) { sum += 10 * value; });
+    event.Trigger(1);
+    CORRADE_COMPARE(sum, 11);
+
+    int value = 2;
+    event.Trigger(value);
+    CORRADE_COMPARE(sum, 33);
+}
+
+void EventTest::ScopedSubscription() {
+    Event<int> event;
+    int sum = 0;
+    event.Subscribe([&](int& value) { sum += value; });
+    {
+        Subscription subscription = event.SubscribeScoped([&](int& value) { sum += 10 * value; });
+        CORRADE_VERIFY(subscription.IsConnected());
+        event.Trigger(1);
+        CORRADE_COMPARE(sum, 11);
+    }
+    event.Trigger(1);
+    CORRADE_COMPARE(sum, 12);
+
+    Subscription subscription = event.SubscribeScoped([&](int& value) { sum += 100 * value; });
+    subscription.Reset();
+    CORRADE_VERIFY(!subscription.IsConnected());
+    event.Trigger(1);
+    CORRADE_COMPARE(sum, 13);
+}
+
+void EventTest::SubscribeDuringTrigger() {
+    Event<int> event;
+
+    /* Callback removing itself and adding another one, which receives the next trigger only */
+    int calls = 0;
+    Subscription self, late;
+    self = event.SubscribeScoped([&](int&) {
+        ++calls;
+        self.Reset();
+        late = event.SubscribeScoped([&](int&) { calls += 100; });
+    });
+
+    event.Trigger(0);
+    CORRADE_COMPARE(calls, 1);
+    event.Trigger(0);
+    CORRADE_COMPARE(calls, 101);
+}
+
+void EventTest::Move() {
+    int sum = 0;
+    auto captured = std::make_shared<int>(5);
+    Subscription subscription;
+    {
+        Event<int> event;
+        subscription = event.SubscribeScoped([captured, &sum](int&) { sum += *captured; });
+
+        Event<int> moved { std::move(event) };
+        moved.Trigger(0);
+        CORRADE_COMPARE(sum, 5);
+        CORRADE_VERIFY(subscription.IsConnected());
+    }
+
+    /* Subscription outlives the event, callback and its captures are released with the event */
+    CORRADE_VERIFY(!subscription.IsConnected());
+    subscription.Reset();
+    CORRADE_COMPARE(captured.use_count(), 1);
+}
+
+void EventTest::Rebind() {
+    /* Unbound, every thread is the owner */
+    bool otherIsOwner = false;
+    std::thread([&] { otherIsOwner = EventDispatcher::IsOwnerThread(); }).join();
+    CORRADE_VERIFY(EventDispatcher::IsOwnerThread());
+    CORRADE_VERIFY(otherIsOwner);
+
+    /* Bound thread stays the owner until other thread binds */
+    std::atomic<int> step { 0 };
+    bool ownerBefore = false, ownerAfter = true;
+    std::thread other([&] {
+        EventDispatcher::Get().BindToThisThread();
+        ownerBefore = EventDispatcher::IsOwnerThread();
+        step = 1;
+        while (step.load() != 2) { std::this_thread::yield(); }
+        ownerAfter = EventDispatcher::IsOwnerThread();
+    });
+    while (step.load() != 1) { std::this_thread::yield(); }
+    CORRADE_VERIFY(!EventDispatcher::IsOwnerThread());
+
+    EventDispatcher::Get().BindToThisThread();
+    step = 2;
+    other.join();
+    CORRADE_VERIFY(ownerBefore);
+    CORRADE_VERIFY(!ownerAfter);
+    CORRADE_VERIFY(EventDispatcher::IsOwnerThread());
+}
+
+void EventTest::CrossThreadStress() {
+    EventDispatcher::Get().BindToThisThread();
+
+    constexpr int producerCount = 4;
+    constexpr int triggerCount  = 50000;
+
+    Event<int> event;
+    int64_t total = 0;
+    event.Subscribe([&](int& value) { total += value; });
+
+    /* Producers trigger, subscribe, post and unsubscribe, while the owner thread keeps draining */
+    std::atomic<int>  extraCalls { 0 };
+    std::atomic<int>  finished   { 0 };
+    vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&] {
+            for (int i = 0; i < triggerCount; ++i) {
+                event.Trigger(1);
+                if (i % 1000 == 0) {
+                    Subscription subscription = event.SubscribeScoped([&](int&) { ++extraCalls; });
+                    event.Post(0);
+                }
+            }
+            ++finished;
+        });
+    }
+    while (finished.load() != producerCount) {
+        EventDispatcher::Get().DispatchPosted();
+    }
+    for (std::thread& producer : producers) { producer.join(); }
+
+    /* Subscriptions and triggers posted by the last callbacks are carried out by the second call */
+    EventDispatcher::Get().DispatchPosted();
+    EventDispatcher::Get().DispatchPosted();
+
+    CORRADE_COMPARE(total, int64_t(producerCount) * triggerCount);
+}
+
+void EventTest::CrossThreadDestroyed() {
+    EventDispatcher::Get().BindToThisThread();
+
+    /* Event destroyed with a trigger still posted, its token reset from another thread afterwards */
+    Subscription subscription;
+    int calls = 0;
+    {
+        Event<int> event;
+        subscription = event.SubscribeScoped([&](int&) { ++calls; });
+        std::thread([&] { event.Trigger(3); }).join();
+    }
+    std::thread([&] { subscription.Reset(); }).join();
+    EventDispatcher::Get().DispatchPosted();
+
+    CORRADE_COMPARE(calls, 0);
+    CORRADE_VERIFY(!subscription.IsConnected());
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::EventTest)
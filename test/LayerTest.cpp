@@ -0,0 +1,170 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/Entity.h>
+#include <core/IComponent.h>
+#include <core/IDrawable.h>
+#include <core/Layer.h>
+#include <core/Scene/Scene.h>
+
+namespace core { namespace Test {
+
+struct LayerTest : Corrade::TestSuite::Tester {
+    explicit LayerTest();
+
+    void DrawCulled();
+    void StatsAccumulate();
+};
+
+namespace {
+
+/** Draws nothing, counts how many times it was drawn */
+struct Counted : public IComponent, public IDrawable {
+    explicit Counted(Entity& parent, Vector4 sphere) : IComponent(parent, "Counted"), sphere(sphere) { }
+
+    void Draw() override { ++draws; }
+    void SetProjectionMatrix(Matrix4& mtx) override { }
+    void SetTransformMatrix(Matrix4& mtx) override { }
+    void SetLight(Light& light) override { }
+
+    bool GetBoundingSphere(Vector4& out) override {
+        out = sphere;
+        return true;
+    }
+
+    Vector4  sphere;
+    uint32_t draws { 0 };
+};
+
+/** Same as Counted without bounds, never culled */
+struct Unbounded : public IComponent, public IDrawable {
+    explicit Unbounded(Entity& parent) : IComponent(parent, "Unbounded") { }
+
+    void Draw() override { ++draws; }
+    void SetProjectionMatrix(Matrix4& mtx) override { }
+    void SetTransformMatrix(Matrix4& mtx) override { }
+    void SetLight(Light& light) override { }
+
+    uint32_t draws { 0 };
+};
+
+/** Box frustum [-10, 10] on every axis */
+const Frustum frustum {
+    { 1, 0, 0, 10 }, { -1, 0, 0, 10 },
+    { 0, 1, 0, 10 }, { 0, -1, 0, 10 },
+    { 0, 0, 1, 10 }, { 0, 0, -1, 10 } };
+
+EntityHandle SpawnCounted(const shared<Layer>& layer, const Vector4& sphere) {
+    EntityHandle handle = Entity::Spawn("Counted", Scene::Get("Default")->Root()->GetHandle(), layer);
+    handle.Get()->AddComponent<Counted>(sphere);
+    return handle;
+}
+
+EntityHandle SpawnUnbounded(const shared<Layer>& layer) {
+    EntityHandle handle = Entity::Spawn("Unbounded", Scene::Get("Default")->Root()->GetHandle(), layer);
+    handle.Get()->AddComponent<Unbounded>();
+    return handle;
+}
+
+}
+
+LayerTest::LayerTest() {
+    addTests({ &LayerTest::DrawCulled,
+               &LayerTest::StatsAccumulate });
+}
+
+void LayerTest::DrawCulled() {
+    shared<Layer> layer = Layer::Get("LayerTestDrawCulled");
+
+    /* Inside, touching a plane from outside, past a plane, and unbounded */
+    EntityHandle inside    = SpawnCounted(layer, { 0.0f, 0.0f, 0.0f, 1.0f });
+    EntityHandle touching  = SpawnCounted(layer, { 12.0f, 0.0f, 0.0f, 2.0f });
+    EntityHandle outside   = SpawnCounted(layer, { 0.0f, -12.5f, 0.0f, 2.0f });
+    EntityHandle far       = SpawnCounted(layer, { 0.0f, 0.0f, 500.0f, 10.0f });
+    EntityHandle unbounded = SpawnUnbounded(layer);
+
+    CullingStats stats;
+    layer->Draw(frustum, stats);
+
+    CORRADE_COMPARE(stats.total, 5);
+    CORRADE_COMPARE(stats.visible, 3);
+    CORRADE_COMPARE(stats.occluded, 0);
+
+    CORRADE_COMPARE(inside.Get()->GetComponent<Counted>()->draws, 1);
+    CORRADE_COMPARE(touching.Get()->GetComponent<Counted>()->draws, 1);
+    CORRADE_COMPARE(outside.Get()->GetComponent<Counted>()->draws, 0);
+    CORRADE_COMPARE(far.Get()->GetComponent<Counted>()->draws, 0);
+    CORRADE_COMPARE(unbounded.Get()->GetComponent<Unbounded>()->draws, 1);
+
+    for (EntityHandle e : { inside, touching, outside, far, unbounded }) {
+        Entity::Destroy(e);
+    }
+}
+
+void LayerTest::StatsAccumulate() {
+    shared<Layer> first  = Layer::Get("LayerTestFirst");
+    shared<Layer> second = Layer::Get("LayerTestSecond");
+
+    /* Enough spheres to go through the vectorized path and its tail, every third one is culled */
+    vector<EntityHandle> entities;
+    for (size_t i = 0; i < 19; ++i) {
+        const float x = i % 3 == 0 ? 50.0f : float(i % 10) - 5.0f;
+        entities.push_back(SpawnCounted(first, { x, 0.0f, 0.0f, 0.5f }));
+    }
+    entities.push_back(SpawnUnbounded(second));
+    entities.push_back(SpawnCounted(second, { 0.0f, 0.0f, -50.0f, 1.0f }));
+
+    /* Counters are summed over layers and draws, never reset */
+    CullingStats stats;
+    first->Draw(frustum, stats);
+    CORRADE_COMPARE(stats.total, 19);
+    CORRADE_COMPARE(stats.visible, 12);
+
+    second->Draw(frustum, stats);
+    CORRADE_COMPARE(stats.total, 21);
+    CORRADE_COMPARE(stats.visible, 13);
+
+    first->Draw(frustum, stats);
+    CORRADE_COMPARE(stats.total, 40);
+    CORRADE_COMPARE(stats.visible, 25);
+
+    /* Destroyed entities are not counted anymore */
+    Entity::Destroy(entities[1]);
+    Entity::Destroy(entities[0]);
+    CullingStats fresh;
+    first->Draw(frustum, fresh);
+    CORRADE_COMPARE(fresh.total, 17);
+    CORRADE_COMPARE(fresh.visible, 11);
+
+    for (EntityHandle e : entities) {
+        if (e.IsValid()) { Entity::Destroy(e); }
+    }
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::LayerTest)
@@ -0,0 +1,292 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/DebugStl.h>
+
+#include <core/Essentials.h>
+#include <core/Math.h>
+
+#include <iterator>
+#include <random>
+
+namespace core { namespace Test {
+
+struct MathTest : Corrade::TestSuite::Tester {
+    explicit MathTest();
+
+    void ComposeTransforms();
+    void Multiply();
+    void MultiplyAliased();
+    void ExtractNormalMatrices();
+    void NormalizeQuaternions();
+    void CullSpheres();
+    void CullSpheresTouching();
+};
+
+namespace {
+
+const struct {
+    const char* name;
+    Math::SimdLevel level;
+} levelData[] {
+    { "Scalar", Math::SimdLevel::Scalar },
+    { "SSE4.1", Math::SimdLevel::SSE41  },
+    { "AVX2",   Math::SimdLevel::AVX2   }
+};
+
+/* Covers empty input, remainders of 4 and 8 wide kernels and a few full iterations */
+constexpr size_t counts[] { 0, 1, 3, 4, 5, 7, 8, 9, 13, 16, 31, 64 };
+constexpr size_t maxCount = 64;
+
+float Random(std::mt19937& random, float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(random);
+}
+Quaternion RandomRotation(std::mt19937& random) {
+    return Quaternion({ Random(random, -1, 1), Random(random, -1, 1), Random(random, -1, 1) }, Random(random, -1, 1)).normalized();
+}
+Matrix4 RandomTransform(std::mt19937& random) {
+    const Vector3 position { Random(random, -100, 100), Random(random, -100, 100), Random(random, -100, 100) };
+    const Vector3 scale    { Random(random, 0.1f, 10), Random(random, 0.1f, 10), Random(random, 0.1f, 10) };
+    return Matrix4::from(RandomRotation(random).toMatrix(), position) * Matrix4::scaling(scale);
+}
+
+}
+
+MathTest::MathTest() {
+    addInstancedTests({ &MathTest::ComposeTransforms,
+                        &MathTest::Multiply,
+                        &MathTest::MultiplyAliased,
+                        &MathTest::ExtractNormalMatrices,
+                        &MathTest::NormalizeQuaternions,
+                        &MathTest::CullSpheres,
+                        &MathTest::CullSpheresTouching }, std::size(levelData));
+}
+
+/* Selects kernels of the tested instance, skips the test if CPU lacks them */
+#define CORE_SELECT_SIMD_LEVEL()                                                    \
+    auto&& data = levelData[testCaseInstanceId()];                                  \
+    setTestCaseDescription(data.name);                                              \
+    Math::SetSimdLevel(data.level);                                                 \
+    if (Math::GetSimdLevel() != data.level) { CORRADE_SKIP("Not supported by CPU"); }
+
+void MathTest::ComposeTransforms() {
+    CORE_SELECT_SIMD_LEVEL();
+
+    std::mt19937 random { 14 };
+    vector<float> position[3], rotation[4], scale[3];
+    for (size_t i = 0; i < maxCount; ++i) {
+        const Quaternion q = RandomRotation(random);
+        rotation[0].push_back(q.vector().x());
+        rotation[1].push_back(q.vector().y());
+        rotation[2].push_back(q.vector().z());
+        rotation[3].push_back(q.scalar());
+        for (auto& p : position) { p.push_back(Random(random, -100, 100)); }
+        for (auto& s : scale)    { s.push_back(Random(random, 0.1f, 10)); }
+    }
+    const Math::TransformArrays input {
+        { position[0].data(), position[1].data(), position[2].data() },
+        { rotation[0].data(), rotation[1].data(), rotation[2].data(), rotation[3].data() },
+        { scale[0].data(), scale[1].data(), scale[2].data() } };
+
+    for (size_t count : counts) {
+        CORRADE_ITERATION(count);
+
+        /* Matrix one past the end must stay untouched */
+        vector<Matrix4> output(count + 1, Matrix4 { });
+        Math::ComposeTransforms(input, output.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            const Quaternion q { { rotation[0][i], rotation[1][i], rotation[2][i] }, rotation[3][i] };
+            const Matrix4 expected = Matrix4::from(q.toMatrix(), { position[0][i], position[1][i], position[2][i] })
+                                   * Matrix4::scaling({ scale[0][i], scale[1][i], scale[2][i] });
+            CORRADE_COMPARE(output[i], expected);
+        }
+        CORRADE_COMPARE(output[count], Matrix4 { });
+    }
+}
+void MathTest::Multiply() {
+    CORE_SELECT_SIMD_LEVEL();
+
+    std::mt19937 random { 14 };
+    vector<Matrix4> lhs, rhs;
+    for (size_t i = 0; i < maxCount; ++i) {
+        lhs.push_back(RandomTransform(random));
+        rhs.push_back(RandomTransform(random));
+    }
+
+    for (size_t count : counts) {
+        CORRADE_ITERATION(count);
+
+        vector<Matrix4> output(count + 1, Matrix4 { });
+        Math::Multiply(lhs.data(), rhs.data(), output.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            CORRADE_COMPARE(output[i], lhs[i] * rhs[i]);
+        }
+        CORRADE_COMPARE(output[count], Matrix4 { });
+    }
+}
+void MathTest::MultiplyAliased() {
+    CORE_SELECT_SIMD_LEVEL();
+
+    std::mt19937 random { 14 };
+    vector<Matrix4> lhs, rhs, expected;
+    for (size_t i = 0; i < maxCount - 1; ++i) {
+        lhs.push_back(RandomTransform(random));
+        rhs.push_back(RandomTransform(random));
+        expected.push_back(lhs.back() * rhs.back());
+    }
+
+    Math::Multiply(lhs.data(), rhs.data(), lhs.data(), lhs.size());
+    for (size_t i = 0; i < lhs.size(); ++i) {
+        CORRADE_COMPARE(lhs[i], expected[i]);
+    }
+}
+void MathTest::ExtractNormalMatrices() {
+    CORE_SELECT_SIMD_LEVEL();
+
+    std::mt19937 random { 14 };
+    vector<Matrix4> transforms;
+    for (size_t i = 0; i < maxCount; ++i) {
+        transforms.push_back(RandomTransform(random));
+    }
+
+    for (size_t count : counts) {
+        CORRADE_ITERATION(count);
+
+        vector<Matrix3x3> output(count + 1, Matrix3x3 { });
+        Math::ExtractNormalMatrices(transforms.data(), output.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            CORRADE_COMPARE(output[i], transforms[i].normalMatrix());
+        }
+        CORRADE_COMPARE(output[count], Matrix3x3 { });
+    }
+}
+void MathTest::NormalizeQuaternions() {
+    CORE_SELECT_SIMD_LEVEL();
+
+    std::mt19937 random { 14 };
+    vector<Quaternion> quaternions;
+    for (size_t i = 0; i < maxCount; ++i) {
+        quaternions.push_back({ { Random(random, -10, 10), Random(random, -10, 10), Random(random, -10, 10) }, Random(random, -10, 10) });
+    }
+
+    for (size_t count : counts) {
+        CORRADE_ITERATION(count);
+
+        vector<float> x, y, z, w;
+        for (const Quaternion& q : quaternions) {
+            x.push_back(q.vector().x());
+            y.push_back(q.vector().y());
+            z.push_back(q.vector().z());
+            w.push_back(q.scalar());
+        }
+        Math::NormalizeQuaternions(x.data(), y.data(), z.data(), w.data(), count);
+
+        for (size_t i = 0; i < count; ++i) {
+            CORRADE_COMPARE(Quaternion({ x[i], y[i], z[i] }, w[i]), quaternions[i].normalized());
+        }
+        if (count < maxCount) {
+            CORRADE_COMPARE(Quaternion({ x[count], y[count], z[count] }, w[count]), quaternions[count]);
+        }
+    }
+}
+
+void MathTest::CullSpheres() {
+    CORE_SELECT_SIMD_LEVEL();
+
+    /* 90 degree pyramid from the origin looking down -Z, spheres scattered around it so a good part of them is culled */
+    const float s = 0.70710678f;
+    const Frustum frustum {
+        { s, 0, -s, 0 }, { -s, 0, -s, 0 },
+        { 0, s, -s, 0 }, { 0, -s, -s, 0 },
+        { 0, 0, -1, -0.5f }, { 0, 0, 1, 100 } };
+    std::mt19937 random { 20 };
+    vector<float> center[3], radius;
+    for (size_t i = 0; i < maxCount; ++i) {
+        for (auto& c : center) { c.push_back(Random(random, -60, 60)); }
+        center[2].back() = Random(random, -120, 10);
+        radius.push_back(Random(random, 0.1f, 15));
+    }
+    const Math::SphereArrays spheres { { center[0].data(), center[1].data(), center[2].data() }, radius.data() };
+
+    for (size_t count : counts) {
+        CORRADE_ITERATION(count);
+
+        /* Scalar kernel is the reference, the byte past count has to stay untouched */
+        vector<uint8_t> expected(maxCount + 1, 0xaa), visible(maxCount + 1, 0xaa);
+        Math::SetSimdLevel(Math::SimdLevel::Scalar);
+        const size_t expectedCount = Math::CullSpheres(frustum, spheres, expected.data(), count);
+        Math::SetSimdLevel(data.level);
+        const size_t visibleCount = Math::CullSpheres(frustum, spheres, visible.data(), count);
+
+        CORRADE_COMPARE(visibleCount, expectedCount);
+        CORRADE_COMPARE(visible, expected);
+        CORRADE_COMPARE(visible[count], 0xaa);
+
+        size_t counted = 0;
+        for (size_t i = 0; i < count; ++i) { counted += visible[i]; }
+        CORRADE_COMPARE(visibleCount, counted);
+
+        /* Both outcomes are exercised */
+        if (count == maxCount) { CORRADE_VERIFY(expectedCount > 0 && expectedCount < count); }
+    }
+}
+
+void MathTest::CullSpheresTouching() {
+    CORE_SELECT_SIMD_LEVEL();
+
+    /* Box frustum [-10, 10] on every axis with unit normals, so distances to its planes are exact */
+    const Frustum frustum {
+        { 1, 0, 0, 10 }, { -1, 0, 0, 10 },
+        { 0, 1, 0, 10 }, { 0, -1, 0, 10 },
+        { 0, 0, 1, 10 }, { 0, 0, -1, 10 } };
+
+    /* Spheres alternate between touching one of the planes from outside and missing it by a bit */
+    vector<float> center[3], radius;
+    vector<uint8_t> expected;
+    for (size_t i = 0; i < maxCount; ++i) {
+        const size_t axis = (i / 2) % 3;
+        const float  side = (i / 6) % 2 ? 1.0f : -1.0f;
+        const bool   touching = i % 2 == 0;
+        for (size_t c = 0; c < 3; ++c) { center[c].push_back(c == axis ? side * (touching ? 12.0f : 12.5f) : 0.0f); }
+        radius.push_back(2.0f);
+        expected.push_back(touching ? 1 : 0);
+    }
+    const Math::SphereArrays spheres { { center[0].data(), center[1].data(), center[2].data() }, radius.data() };
+
+    for (size_t count : counts) {
+        CORRADE_ITERATION(count);
+
+        vector<uint8_t> visible(count);
+        const size_t visibleCount = Math::CullSpheres(frustum, spheres, visible.data(), count);
+        CORRADE_COMPARE(visible, vector<uint8_t>(expected.begin(), expected.begin() + count));
+        CORRADE_COMPARE(visibleCount, (count + 1) / 2);
+    }
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::MathTest)
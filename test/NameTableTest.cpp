@@ -0,0 +1,122 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/NameTable.h>
+
+#include <stdexcept>
+#include <thread>
+
+namespace core { namespace Test {
+
+/**
+ * NameTable tests, Concurrent is meant to run under ThreadSanitizer as well
+ * @see CORE_SANITIZE_THREAD CMake option
+ */
+struct NameTableTest : Corrade::TestSuite::Tester {
+    explicit NameTableTest();
+
+    void Intern();
+    void Empty();
+    void StableReferences();
+    void InvalidId();
+    void Concurrent();
+};
+
+NameTableTest::NameTableTest() {
+    addTests({ &NameTableTest::Intern,
+               &NameTableTest::Empty,
+               &NameTableTest::StableReferences,
+               &NameTableTest::InvalidId,
+               &NameTableTest::Concurrent });
+}
+
+void NameTableTest::Intern() {
+    const NameId camera = NameTable::Intern("NameTableTest Camera");
+    const NameId light  = NameTable::Intern("NameTableTest Light");
+    CORRADE_VERIFY(camera != light);
+    CORRADE_COMPARE(NameTable::Intern("NameTableTest Camera"), camera);
+    CORRADE_COMPARE(NameTable::Get(camera), "NameTableTest Camera");
+    CORRADE_COMPARE(NameTable::Get(light), "NameTableTest Light");
+}
+
+void NameTableTest::Empty() {
+    CORRADE_COMPARE(NameTable::Intern(""), 0);
+    CORRADE_COMPARE(NameTable::Get(0), "");
+}
+
+void NameTableTest::StableReferences() {
+    /* Enough names to fill several blocks of the table */
+    const string& first = NameTable::Get(NameTable::Intern("NameTableTest Stable"));
+    vector<NameId> ids;
+    for (int i = 0; i < 10000; ++i) { ids.push_back(NameTable::Intern("NameTableTest " + std::to_string(i))); }
+
+    CORRADE_COMPARE(first, "NameTableTest Stable");
+    CORRADE_COMPARE(&NameTable::Get(NameTable::Intern("NameTableTest Stable")), &first);
+    for (int i = 0; i < 10000; ++i) {
+        CORRADE_ITERATION(i);
+        CORRADE_COMPARE(NameTable::Get(ids[i]), "NameTableTest " + std::to_string(i));
+        CORRADE_COMPARE(NameTable::Intern("NameTableTest " + std::to_string(i)), ids[i]);
+    }
+}
+
+void NameTableTest::InvalidId() {
+    bool thrown = false;
+    try {
+        NameTable::Get(0xfffffff0u);
+    } catch (const std::out_of_range&) {
+        thrown = true;
+    }
+    CORRADE_VERIFY(thrown);
+}
+
+void NameTableTest::Concurrent() {
+    /* Threads intern overlapping names and read names interned by others */
+    constexpr int threadCount = 4;
+    constexpr int nameCount   = 2000;
+    vector<vector<NameId>> ids(threadCount, vector<NameId>(nameCount));
+    vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&ids, t] {
+            for (int i = 0; i < nameCount; ++i) {
+                const int name = (i + t * 500) % nameCount;
+                ids[t][name] = NameTable::Intern("NameTableTest Concurrent " + std::to_string(name));
+                NameTable::Get(ids[t][name]).size();
+            }
+        });
+    }
+    for (std::thread& thread : threads) { thread.join(); }
+
+    for (int i = 0; i < nameCount; ++i) {
+        CORRADE_ITERATION(i);
+        for (int t = 1; t < threadCount; ++t) { CORRADE_COMPARE(ids[t][i], ids[0][i]); }
+        CORRADE_COMPARE(NameTable::Get(ids[0][i]), "NameTableTest Concurrent " + std::to_string(i));
+    }
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::NameTableTest)
@@ -0,0 +1,206 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/JobSystem.h>
+#include <core/Scene/OcclusionBuffer.h>
+
+#include <random>
+
+namespace core { namespace Test {
+
+struct OcclusionBufferTest : Corrade::TestSuite::Tester {
+    explicit OcclusionBufferTest();
+
+    void Size();
+    void Empty();
+    void Occluded();
+    void NotOccluded();
+    void Perspective();
+    void NearPlane();
+    void TestVisibility();
+};
+
+namespace {
+
+/* With identity view projection NDC is world space, so boxes map onto the buffer directly */
+const Matrix4 identity { };
+
+Range3D Box(const Vector3& min, const Vector3& max) {
+    return { min, max };
+}
+
+}
+
+OcclusionBufferTest::OcclusionBufferTest() {
+    addTests({ &OcclusionBufferTest::Size,
+               &OcclusionBufferTest::Empty,
+               &OcclusionBufferTest::Occluded,
+               &OcclusionBufferTest::NotOccluded,
+               &OcclusionBufferTest::Perspective,
+               &OcclusionBufferTest::NearPlane,
+               &OcclusionBufferTest::TestVisibility });
+}
+
+void OcclusionBufferTest::Size() {
+    JobSystem jobSystem { 0 };
+
+    OcclusionBuffer buffer { jobSystem, 30, 17 };
+    CORRADE_COMPARE(buffer.GetWidth(), 32);
+    CORRADE_COMPARE(buffer.GetHeight(), 17);
+
+    OcclusionBuffer tiny { jobSystem, 0, 0 };
+    CORRADE_COMPARE(tiny.GetWidth(), 4);
+    CORRADE_COMPARE(tiny.GetHeight(), 1);
+}
+
+void OcclusionBufferTest::Empty() {
+    JobSystem jobSystem { 0 };
+    OcclusionBuffer buffer { jobSystem, 64, 32 };
+    buffer.Begin(identity);
+    buffer.Rasterize();
+
+    CORRADE_COMPARE(buffer.GetTriangleCount(), 0);
+    for (uint32_t i = 0; i < buffer.GetWidth() * buffer.GetHeight(); ++i) {
+        CORRADE_COMPARE(buffer.GetDepth()[i], 1.0f);
+    }
+
+    CORRADE_VERIFY(buffer.IsVisible(Box({ -0.1f, -0.1f, 0.5f }, { 0.1f, 0.1f, 0.6f })));
+
+    /* Bounds outside of the screen are never visible */
+    CORRADE_VERIFY(!buffer.IsVisible(Box({ 2.0f, -0.1f, 0.5f }, { 3.0f, 0.1f, 0.6f })));
+}
+
+void OcclusionBufferTest::Occluded() {
+    JobSystem jobSystem { 0 };
+    OcclusionBuffer buffer { jobSystem, 64, 32 };
+    buffer.Begin(identity);
+    buffer.AddOccluder(identity, Box({ -0.5f, -0.5f, 0.0f }, { 0.5f, 0.5f, 0.1f }));
+    buffer.Rasterize();
+
+    /* Side faces are seen edge-on and skipped, front and back faces are two triangles each */
+    CORRADE_COMPARE(buffer.GetTriangleCount(), 4);
+    CORRADE_COMPARE(buffer.GetDepth()[16 * 64 + 32], 0.0f);
+    CORRADE_COMPARE(buffer.GetDepth()[0], 1.0f);
+
+    CORRADE_VERIFY(!buffer.IsVisible(Box({ -0.2f, -0.2f, 0.5f }, { 0.2f, 0.2f, 0.6f })));
+
+    /* Next frame without occluders hides nothing */
+    buffer.Begin(identity);
+    buffer.Rasterize();
+    CORRADE_VERIFY(buffer.IsVisible(Box({ -0.2f, -0.2f, 0.5f }, { 0.2f, 0.2f, 0.6f })));
+}
+
+void OcclusionBufferTest::NotOccluded() {
+    JobSystem jobSystem { 0 };
+    OcclusionBuffer buffer { jobSystem, 64, 32 };
+    buffer.Begin(identity);
+    buffer.AddOccluder(identity, Box({ -0.5f, -0.5f, 0.0f }, { 0.5f, 0.5f, 0.1f }));
+    buffer.Rasterize();
+
+    /* In front of the occluder */
+    CORRADE_VERIFY(buffer.IsVisible(Box({ -0.2f, -0.2f, -0.6f }, { 0.2f, 0.2f, -0.5f })));
+    /* Intersecting it */
+    CORRADE_VERIFY(buffer.IsVisible(Box({ -0.2f, -0.2f, -0.1f }, { 0.2f, 0.2f, 0.5f })));
+    /* Behind it, but sticking out on the side */
+    CORRADE_VERIFY(buffer.IsVisible(Box({ 0.3f, -0.2f, 0.5f }, { 0.8f, 0.2f, 0.6f })));
+    /* Behind it, but larger */
+    CORRADE_VERIFY(buffer.IsVisible(Box({ -0.7f, -0.7f, 0.5f }, { 0.7f, 0.7f, 0.6f })));
+}
+
+void OcclusionBufferTest::Perspective() {
+    JobSystem jobSystem { 0 };
+    OcclusionBuffer buffer { jobSystem, 128, 128 };
+
+    /* Camera at the origin looking down -Z, wall 5 units in front of it */
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+    buffer.Begin(projection);
+    buffer.AddOccluder(Matrix4::translation({ 0.0f, 0.0f, -5.0f }), Box({ -2.0f, -2.0f, -0.1f }, { 2.0f, 2.0f, 0.1f }));
+    buffer.Rasterize();
+
+    /* Wall covers a growing area with distance */
+    CORRADE_VERIFY(!buffer.IsVisible(Box({ -1.0f, -1.0f, -10.0f }, { 1.0f, 1.0f, -9.0f })));
+    CORRADE_VERIFY(!buffer.IsVisible(Box({ -5.0f, -5.0f, -21.0f }, { 5.0f, 5.0f, -20.0f })));
+    CORRADE_VERIFY(buffer.IsVisible(Box({ -1.0f, -1.0f, -4.0f }, { 1.0f, 1.0f, -3.0f })));
+    CORRADE_VERIFY(buffer.IsVisible(Box({ 10.0f, -1.0f, -21.0f }, { 12.0f, 1.0f, -20.0f })));
+}
+
+void OcclusionBufferTest::NearPlane() {
+    JobSystem jobSystem { 0 };
+    OcclusionBuffer buffer { jobSystem, 128, 128 };
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(90.0f), 1.0f, 0.1f, 100.0f);
+    buffer.Begin(projection);
+
+    /* Box around the camera, only its far face lies fully in front of the near plane */
+    buffer.AddOccluder(identity, Box({ -2.0f, -2.0f, -5.0f }, { 2.0f, 2.0f, 1.0f }));
+    CORRADE_COMPARE(buffer.GetTriangleCount(), 2);
+    buffer.Rasterize();
+
+    CORRADE_VERIFY(!buffer.IsVisible(Box({ -1.0f, -1.0f, -10.0f }, { 1.0f, 1.0f, -9.0f })));
+
+    /* Bounds crossing the near plane are always visible */
+    CORRADE_VERIFY(buffer.IsVisible(Box({ -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f })));
+}
+
+void OcclusionBufferTest::TestVisibility() {
+    /* Enough bounds for several jobs, so the batch is split over workers */
+    JobSystem jobSystem { 3 };
+    OcclusionBuffer buffer { jobSystem, 128, 64 };
+    const Matrix4 projection = Matrix4::perspectiveProjection(Deg(90.0f), 2.0f, 0.1f, 100.0f);
+    buffer.Begin(projection);
+    buffer.AddOccluder(Matrix4::translation({ -3.0f, 0.0f, -5.0f }), Box({ -2.0f, -2.0f, -0.1f }, { 2.0f, 2.0f, 0.1f }));
+    buffer.AddOccluder(Matrix4::translation({  3.0f, 0.0f, -8.0f }), Box({ -2.0f, -3.0f, -0.1f }, { 2.0f, 3.0f, 0.1f }));
+    buffer.Rasterize();
+
+    std::mt19937 random { 21 };
+    std::uniform_real_distribution<float> x { -30.0f, 30.0f }, y { -15.0f, 15.0f }, z { -60.0f, -1.0f }, size { 0.1f, 3.0f };
+    vector<Range3D> bounds;
+    for (size_t i = 0; i < 2000; ++i) {
+        const Vector3 min { x(random), y(random), z(random) };
+        bounds.push_back(Box(min, min + Vector3 { size(random), size(random), size(random) }));
+    }
+
+    vector<uint8_t> visible(bounds.size(), 2);
+    const size_t visibleCount = buffer.TestVisibility(bounds.data(), visible.data(), bounds.size());
+
+    size_t expectedCount = 0, hiddenCount = 0;
+    for (size_t i = 0; i < bounds.size(); ++i) {
+        CORRADE_ITERATION(i);
+        const bool expected = buffer.IsVisible(bounds[i]);
+        CORRADE_COMPARE(visible[i], expected ? 1 : 0);
+        expectedCount += expected;
+        hiddenCount   += !expected;
+    }
+    CORRADE_COMPARE(visibleCount, expectedCount);
+
+    /* Otherwise the comparison above proves nothing */
+    CORRADE_VERIFY(hiddenCount > 0);
+    CORRADE_VERIFY(expectedCount > 0);
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::OcclusionBufferTest)
@@ -0,0 +1,188 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/Entity.h>
+#include <core/IComponent.h>
+#include <core/Query.h>
+#include <core/Scene/Scene.h>
+
+namespace core { namespace Test {
+
+struct QueryTest : Corrade::TestSuite::Tester {
+    explicit QueryTest();
+
+    void Match();
+    void ChangedConsumers();
+    void ChangedAllTerms();
+    void ChangedDuringVisit();
+};
+
+namespace {
+
+struct Health : public IComponent {
+    explicit Health(Entity& parent) : IComponent(parent, "Health") { }
+    int value { 0 };
+};
+
+struct Armor : public IComponent {
+    explicit Armor(Entity& parent) : IComponent(parent, "Armor") { }
+    int value { 0 };
+};
+
+EntityHandle SpawnWith(const string& name, bool armor) {
+    EntityHandle handle = Entity::Spawn(name, Scene::Get("Default")->Root()->GetHandle());
+    handle.Get()->AddComponent<Health>();
+    if (armor) { handle.Get()->AddComponent<Armor>(); }
+    return handle;
+}
+
+}
+
+QueryTest::QueryTest() {
+    addTests({ &QueryTest::Match,
+               &QueryTest::ChangedConsumers,
+               &QueryTest::ChangedAllTerms,
+               &QueryTest::ChangedDuringVisit });
+}
+
+void QueryTest::Match() {
+    EntityHandle a = SpawnWith("a", true);
+    EntityHandle b = SpawnWith("b", false);
+
+    Query<Health, Armor>& query = Query<Health, Armor>::Get();
+    CORRADE_COMPARE(query.Size(), 1);
+
+    b.Get()->AddComponent<Armor>();
+    CORRADE_COMPARE(query.Size(), 2);
+
+    int visited = 0;
+    query.Each([&](Entity& entity, Health& health, Armor&) {
+        CORRADE_VERIFY(entity.GetComponent<Health>() == &health);
+        ++visited;
+    });
+    CORRADE_COMPARE(visited, 2);
+
+    Entity::Destroy(a);
+    CORRADE_COMPARE(query.Size(), 1);
+    Entity::Destroy(b);
+    CORRADE_COMPARE(query.Size(), 0);
+}
+
+void QueryTest::ChangedConsumers() {
+    EntityHandle a = SpawnWith("a", false);
+    EntityHandle b = SpawnWith("b", false);
+
+    /* Two systems share the query, each with its own tick */
+    Query<Changed<Health>>& query = Query<Changed<Health>>::Get();
+    uint64_t upload = 0, refit = 0;
+    auto count = [&](uint64_t& lastVisit) {
+        int visited = 0;
+        query.Each(lastVisit, [&](Health&) { ++visited; });
+        return visited;
+    };
+
+    /* Newly matching entities count as changed for every consumer */
+    CORRADE_COMPARE(count(upload), 2);
+    CORRADE_COMPARE(count(refit), 2);
+    CORRADE_COMPARE(count(upload), 0);
+    CORRADE_COMPARE(count(refit), 0);
+
+    /* A write is seen once by each consumer, no matter which visits first */
+    a.GetComponent<Health>()->MarkChanged();
+    CORRADE_COMPARE(count(upload), 1);
+    CORRADE_COMPARE(count(upload), 0);
+    CORRADE_COMPARE(count(refit), 1);
+    CORRADE_COMPARE(count(refit), 0);
+
+    /* Consumer skipping a few visits still gets every write since its last one */
+    b.GetComponent<Health>()->MarkChanged();
+    CORRADE_COMPARE(count(upload), 1);
+    a.GetComponent<Health>()->MarkChanged();
+    CORRADE_COMPARE(count(upload), 1);
+    CORRADE_COMPARE(count(refit), 2);
+
+    /* Consumer created later starts with everything */
+    uint64_t replication = 0;
+    CORRADE_COMPARE(count(replication), 2);
+
+    Entity::Destroy(a);
+    Entity::Destroy(b);
+}
+
+void QueryTest::ChangedAllTerms() {
+    EntityHandle a = SpawnWith("a", true);
+
+    Query<Changed<Health>, Changed<Armor>>& query = Query<Changed<Health>, Changed<Armor>>::Get();
+    uint64_t lastVisit = 0;
+    auto count = [&] {
+        int visited = 0;
+        query.Each(lastVisit, [&](Health&, Armor&) { ++visited; });
+        return visited;
+    };
+    CORRADE_COMPARE(count(), 1);
+
+    /* Every Changed term has to be written since the last visit */
+    a.GetComponent<Health>()->MarkChanged();
+    CORRADE_COMPARE(count(), 0);
+    a.GetComponent<Armor>()->MarkChanged();
+    CORRADE_COMPARE(count(), 0);
+
+    a.GetComponent<Health>()->MarkChanged();
+    a.GetComponent<Armor>()->MarkChanged();
+    CORRADE_COMPARE(count(), 1);
+
+    /* Unfiltered terms don't take part */
+    Query<Changed<Health>, Armor>& partial = Query<Changed<Health>, Armor>::Get();
+    uint64_t partialVisit = 0;
+    int visited = 0;
+    partial.Each(partialVisit, [&](Health&, Armor&) { ++visited; });
+    a.GetComponent<Armor>()->MarkChanged();
+    partial.Each(partialVisit, [&](Health&, Armor&) { ++visited; });
+    CORRADE_COMPARE(visited, 1);
+
+    Entity::Destroy(a);
+}
+
+void QueryTest::ChangedDuringVisit() {
+    EntityHandle a = SpawnWith("a", false);
+
+    Query<Changed<Health>>& query = Query<Changed<Health>>::Get();
+    uint64_t lastVisit = 0;
+
+    /* Writes made while visiting are reported on the next visit */
+    int visited = 0;
+    query.Each(lastVisit, [&](Health& health) { ++visited; health.MarkChanged(); });
+    query.Each(lastVisit, [&](Health&) { ++visited; });
+    query.Each(lastVisit, [&](Health&) { ++visited; });
+    CORRADE_COMPARE(visited, 2);
+
+    Entity::Destroy(a);
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::QueryTest)
@@ -0,0 +1,290 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/Entity.h>
+#include <core/Components/Transform.h>
+#include <core/Scene/Scene.h>
+#include <core/Scene/SceneSnapshot.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+
+namespace core { namespace Test {
+
+struct SceneSnapshotTest : Corrade::TestSuite::Tester {
+    explicit SceneSnapshotTest();
+
+    void SaveDecode();
+    void SaveLoad();
+    void LoadEmpty();
+    void Synthetic();
+    void Malformed();
+};
+
+namespace {
+
+using Decoded = SceneSnapshot::Decoded;
+
+constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+string TempPath(const string& name) {
+    return (std::filesystem::temp_directory_path() / ("CoreSceneSnapshotTest-" + name + ".snap")).string();
+}
+
+/**
+ * Writes snapshot files byte by byte, mirrors the layout documented by SceneSnapshot
+ */
+struct SyntheticSnapshot {
+    struct Header {
+        char     magic[4]  { 'C', 'S', 'N', 'P' };
+        uint32_t byteOrder { 0x01020304 };
+        uint32_t version   { SceneSnapshot::version };
+        uint32_t sectionCount { 5 };
+    };
+
+    struct Section {
+        uint32_t type;
+        uint32_t reserved;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    Decoded::StringRef AddString(const string& text) {
+        const Decoded::StringRef ref { static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(text.size()) };
+        strings.insert(strings.end(), text.begin(), text.end());
+        return ref;
+    }
+
+    /** Sections in the order of their type id, aligned to 8 bytes */
+    vector<char> Bytes() {
+        vector<char> bytes(sizeof(Header) + 5 * sizeof(Section));
+        sections.clear();
+        const auto append = [&](const void* data, size_t size) {
+            bytes.resize((bytes.size() + 7) / 8 * 8);
+            sections.push_back({ static_cast<uint32_t>(sections.size()), 0, bytes.size(), size });
+            bytes.insert(bytes.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+        };
+        append(strings.data(),    strings.size());
+        append(entities.data(),   entities.size()   * sizeof(Decoded::EntityRecord));
+        append(transforms.data(), transforms.size() * sizeof(Decoded::TransformRecord));
+        append(renderers.data(),  renderers.size()  * sizeof(Decoded::RendererRecord));
+        append(assets.data(),     assets.size()     * sizeof(Decoded::AssetRecord));
+
+        std::memcpy(bytes.data(), &header, sizeof(Header));
+        std::memcpy(bytes.data() + sizeof(Header), sections.data(), sections.size() * sizeof(Section));
+        return bytes;
+    }
+
+    /** Two entities, the second one a child of the first, one Renderer referencing one asset */
+    static SyntheticSnapshot Valid() {
+        SyntheticSnapshot snapshot;
+        const Decoded::StringRef layer = snapshot.AddString("Default");
+        snapshot.entities.push_back({ none, snapshot.AddString("parent"), layer });
+        snapshot.entities.push_back({ 0,    snapshot.AddString("child"),  layer });
+        snapshot.transforms.push_back({ 1, { 1, 2, 3 }, { 0, 0, 0, 1 }, { 1, 1, 1 } });
+        snapshot.assets.push_back({ snapshot.AddString("models/box.gltf") });
+        snapshot.renderers.push_back({ 1, 0, 0 });
+        return snapshot;
+    }
+
+    Header                          header;
+    vector<Section>                 sections;
+    vector<char>                    strings;
+    vector<Decoded::EntityRecord>    entities;
+    vector<Decoded::TransformRecord> transforms;
+    vector<Decoded::RendererRecord>  renderers;
+    vector<Decoded::AssetRecord>     assets;
+};
+
+void WriteFile(const string& path, const vector<char>& bytes) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+/** Every case breaks one thing in an otherwise valid synthetic snapshot */
+const struct {
+    const char* name;
+    std::function<vector<char>(SyntheticSnapshot&)> corrupt;
+} malformedData[] {
+    { "too small", [](SyntheticSnapshot& s) { vector<char> bytes = s.Bytes(); bytes.resize(6); return bytes; } },
+    { "bad magic", [](SyntheticSnapshot& s) { s.header.magic[3] = 'X'; return s.Bytes(); } },
+    { "other version", [](SyntheticSnapshot& s) { s.header.version = SceneSnapshot::version + 1; return s.Bytes(); } },
+    { "other byte order", [](SyntheticSnapshot& s) { s.header.byteOrder = 0x04030201; return s.Bytes(); } },
+    { "truncated table", [](SyntheticSnapshot& s) { s.header.sectionCount = 1000; return s.Bytes(); } },
+    { "truncated section", [](SyntheticSnapshot& s) {
+        vector<char> bytes = s.Bytes();
+        bytes.resize(s.sections[1].offset + sizeof(Decoded::EntityRecord) / 2);
+        return bytes;
+    } },
+    { "section past end", [](SyntheticSnapshot& s) {
+        vector<char> bytes = s.Bytes();
+        const uint64_t offset = bytes.size() + 64;
+        std::memcpy(bytes.data() + sizeof(SyntheticSnapshot::Header) + 2 * sizeof(SyntheticSnapshot::Section) + 8, &offset, sizeof(offset));
+        return bytes;
+    } },
+    { "parent out of range", [](SyntheticSnapshot& s) { s.entities[1].parent = 7; return s.Bytes(); } },
+    { "parent after child", [](SyntheticSnapshot& s) { s.entities[0].parent = 1; return s.Bytes(); } },
+    { "name out of range", [](SyntheticSnapshot& s) { s.entities[0].name.offset = static_cast<uint32_t>(s.strings.size()); s.entities[0].name.length = 1; return s.Bytes(); } },
+    { "name length overflow", [](SyntheticSnapshot& s) { s.entities[1].name.length = none; return s.Bytes(); } },
+    { "layer out of range", [](SyntheticSnapshot& s) { s.entities[1].layer.offset = none; return s.Bytes(); } },
+    { "transform entity out of range", [](SyntheticSnapshot& s) { s.transforms[0].entity = 2; return s.Bytes(); } },
+    { "renderer entity out of range", [](SyntheticSnapshot& s) { s.renderers[0].entity = 2; return s.Bytes(); } },
+    { "asset index out of range", [](SyntheticSnapshot& s) { s.renderers[0].asset = 1; return s.Bytes(); } },
+    { "asset path out of range", [](SyntheticSnapshot& s) { s.assets[0].path.length = static_cast<uint32_t>(s.strings.size()) + 1; return s.Bytes(); } },
+};
+
+}
+
+SceneSnapshotTest::SceneSnapshotTest() {
+    addTests({ &SceneSnapshotTest::SaveDecode,
+               &SceneSnapshotTest::SaveLoad,
+               &SceneSnapshotTest::LoadEmpty,
+               &SceneSnapshotTest::Synthetic });
+
+    addInstancedTests({ &SceneSnapshotTest::Malformed }, std::size(malformedData));
+}
+
+void SceneSnapshotTest::SaveDecode() {
+    EntityHandle root  = Entity::Spawn("Saved", Scene::Get("Default")->Root()->GetHandle());
+    EntityHandle alpha = Entity::Spawn("alpha", root);
+    EntityHandle beta  = Entity::Spawn("beta", alpha);
+    EntityHandle gamma = Entity::Spawn("gamma", root);
+    alpha.Get()->AddComponent<Transform>();
+    alpha.GetComponent<Transform>()->SetPosition(Vector3(1, 2, 3));
+    beta.Get()->AddComponent<Transform>();
+    beta.GetComponent<Transform>()->SetScale(Vector3(4, 5, 6));
+
+    const string path = TempPath("SaveDecode");
+    SceneSnapshot::Save(path, root);
+    Entity::Destroy(root);
+    Entity::Destroy(gamma);
+
+    const Decoded decoded = SceneSnapshot::Decode(path);
+    CORRADE_COMPARE(decoded.entities.size, 3);
+    CORRADE_COMPARE(decoded.transforms.size, 2);
+    CORRADE_COMPARE(decoded.renderers.size, 0);
+    CORRADE_COMPARE(decoded.assets.size, 0);
+
+    /* Parents precede children, names are deduplicated in the string table */
+    CORRADE_COMPARE(decoded.String(decoded.entities[0].name), "alpha");
+    CORRADE_COMPARE(decoded.entities[0].parent, none);
+    CORRADE_COMPARE(decoded.String(decoded.entities[1].name), "beta");
+    CORRADE_COMPARE(decoded.entities[1].parent, 0);
+    CORRADE_COMPARE(decoded.String(decoded.entities[2].name), "gamma");
+    CORRADE_COMPARE(decoded.entities[2].parent, none);
+    CORRADE_COMPARE(decoded.entities[0].layer.offset, decoded.entities[2].layer.offset);
+
+    CORRADE_COMPARE(decoded.transforms[0].entity, 0);
+    CORRADE_COMPARE(decoded.transforms[0].position[1], 2.0f);
+    CORRADE_COMPARE(decoded.transforms[1].entity, 1);
+    CORRADE_COMPARE(decoded.transforms[1].scale[2], 6.0f);
+}
+
+void SceneSnapshotTest::SaveLoad() {
+    EntityHandle root  = Entity::Spawn("Saved", Scene::Get("Default")->Root()->GetHandle());
+    EntityHandle alpha = Entity::Spawn("alpha", root);
+    EntityHandle beta  = Entity::Spawn("beta", alpha);
+    beta.Get()->AddComponent<Transform>();
+    beta.GetComponent<Transform>()->SetPosition(Vector3(7, 8, 9));
+    beta.GetComponent<Transform>()->SetRotation(Quaternion({ 0, 0.6f, 0 }, 0.8f));
+
+    const string path = TempPath("SaveLoad");
+    SceneSnapshot::Save(path, root);
+    Entity::Destroy(root);
+
+    SceneSnapshot snapshot;
+    EntityHandle target = Entity::Spawn("Loaded", Scene::Get("Default")->Root()->GetHandle());
+    const vector<EntityHandle> roots = snapshot.Load(path, target);
+    CORRADE_COMPARE(roots.size(), 1);
+
+    Entity* loadedAlpha = roots[0].Get();
+    CORRADE_VERIFY(loadedAlpha);
+    CORRADE_COMPARE(loadedAlpha->GetName(), "alpha");
+    CORRADE_COMPARE(loadedAlpha->GetParent(), target.Get());
+    CORRADE_VERIFY(!loadedAlpha->GetComponent<Transform>());
+
+    const vector<EntityHandle> children = loadedAlpha->GetChildren();
+    CORRADE_COMPARE(children.size(), 1);
+    Transform* transform = children[0].GetComponent<Transform>();
+    CORRADE_COMPARE(children[0].Get()->GetName(), "beta");
+    CORRADE_VERIFY(transform);
+    CORRADE_COMPARE(transform->GetPosition().z(), 9.0f);
+    CORRADE_COMPARE(transform->GetRotation().vector().y(), 0.6f);
+    CORRADE_COMPARE(transform->GetRotation().scalar(), 0.8f);
+
+    Entity::Destroy(target);
+}
+
+void SceneSnapshotTest::LoadEmpty() {
+    EntityHandle root = Entity::Spawn("Saved", Scene::Get("Default")->Root()->GetHandle());
+    const string path = TempPath("LoadEmpty");
+    SceneSnapshot::Save(path, root);
+    Entity::Destroy(root);
+
+    SceneSnapshot snapshot;
+    EntityHandle target = Entity::Spawn("Loaded", Scene::Get("Default")->Root()->GetHandle());
+    CORRADE_VERIFY(snapshot.Load(path, target).empty());
+    Entity::Destroy(target);
+}
+
+void SceneSnapshotTest::Synthetic() {
+    /* Makes sure malformed cases start from a snapshot Decode accepts */
+    SyntheticSnapshot snapshot = SyntheticSnapshot::Valid();
+    const string path = TempPath("Synthetic");
+    WriteFile(path, snapshot.Bytes());
+
+    const Decoded decoded = SceneSnapshot::Decode(path);
+    CORRADE_COMPARE(decoded.entities.size, 2);
+    CORRADE_COMPARE(decoded.String(decoded.entities[1].name), "child");
+    CORRADE_COMPARE(decoded.String(decoded.assets[0].path), "models/box.gltf");
+    CORRADE_COMPARE(decoded.renderers[0].entity, 1);
+}
+
+void SceneSnapshotTest::Malformed() {
+    auto&& data = malformedData[testCaseInstanceId()];
+    setTestCaseDescription(data.name);
+
+    SyntheticSnapshot snapshot = SyntheticSnapshot::Valid();
+    const string path = TempPath("Malformed");
+    WriteFile(path, data.corrupt(snapshot));
+
+    bool thrown = false;
+    try {
+        SceneSnapshot::Decode(path);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    CORRADE_VERIFY(thrown);
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::SceneSnapshotTest)
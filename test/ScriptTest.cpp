@@ -0,0 +1,121 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/Entity.h>
+#include <core/ComponentStorage.h>
+#include <core/Components/Script.h>
+#include <core/Scene/Scene.h>
+
+namespace core { namespace Test {
+
+struct ScriptTest : Corrade::TestSuite::Tester {
+    explicit ScriptTest();
+
+    void PublicOverrides();
+    void NonPublicOverrides();
+};
+
+namespace {
+
+struct PublicBehaviour : public ScriptedBehaviour {
+    void Tick() override { ++ticks; }
+    void LateTick() override { ++lateTicks; }
+
+    int ticks     { 0 };
+    int lateTicks { 0 };
+};
+
+/* Hooks declared the way virtual hooks often are, Script<T> has to compile with them */
+class ProtectedBehaviour : public ScriptedBehaviour {
+public:
+    int ticks { 0 };
+
+protected:
+    void Tick() override { ++ticks; }
+};
+
+class PrivateBehaviour final : public ScriptedBehaviour {
+public:
+    int earlyTicks { 0 };
+
+private:
+    void EarlyTick() override { ++earlyTicks; }
+};
+
+static_assert(ScriptPhaseAccess<PublicBehaviour>::Accessible(TickerPhase::Tick), "Public override is called statically");
+static_assert(!ScriptPhaseAccess<ProtectedBehaviour>::Accessible(TickerPhase::Tick), "Protected override is not accessible");
+static_assert(!ScriptPhaseAccess<PrivateBehaviour>::Accessible(TickerPhase::EarlyTick), "Private override is not accessible");
+static_assert(ScriptPhaseAccess<PrivateBehaviour>::Accessible(TickerPhase::Tick), "ITicker's own function is public");
+
+static_assert(Script<ProtectedBehaviour>::tickerPhases & PhaseBit(TickerPhase::Tick), "Protected override is ticked");
+static_assert(Script<PrivateBehaviour>::tickerPhases & PhaseBit(TickerPhase::EarlyTick), "Private override is ticked");
+
+template<typename T>
+T& Attach() {
+    EntityHandle handle = Entity::Spawn("Scripted", Scene::Get("Default")->Root()->GetHandle());
+    handle.Get()->AddComponent<Script<T>>();
+    return handle.GetComponent<Script<T>>()->GetBehaviour();
+}
+
+void Run(TickerPhase phase) {
+    for (IComponentStorage* storage : IComponentStorage::ForPhase(phase)) {
+        (static_cast<ITicker*>(storage)->*PhaseFunction(phase))();
+    }
+}
+
+}
+
+ScriptTest::ScriptTest() {
+    addTests({ &ScriptTest::PublicOverrides,
+               &ScriptTest::NonPublicOverrides });
+}
+
+void ScriptTest::PublicOverrides() {
+    PublicBehaviour& behaviour = Attach<PublicBehaviour>();
+
+    Run(TickerPhase::EarlyTick);
+    Run(TickerPhase::Tick);
+    Run(TickerPhase::LateTick);
+    Run(TickerPhase::Tick);
+    CORRADE_COMPARE(behaviour.ticks, 2);
+    CORRADE_COMPARE(behaviour.lateTicks, 1);
+}
+
+void ScriptTest::NonPublicOverrides() {
+    ProtectedBehaviour& protectedBehaviour = Attach<ProtectedBehaviour>();
+    PrivateBehaviour&   privateBehaviour   = Attach<PrivateBehaviour>();
+
+    Run(TickerPhase::EarlyTick);
+    Run(TickerPhase::Tick);
+    Run(TickerPhase::Tick);
+    CORRADE_COMPARE(protectedBehaviour.ticks, 2);
+    CORRADE_COMPARE(privateBehaviour.earlyTicks, 1);
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::ScriptTest)
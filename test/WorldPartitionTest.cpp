@@ -0,0 +1,238 @@
+/*
+ MIT License
+ 
+ Copyright (c) 2021 kualta <contact@kualta.dev>
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+ */
+
+#include <Corrade/TestSuite/Tester.h>
+
+#include <core/Essentials.h>
+#include <core/Entity.h>
+#include <core/JobSystem.h>
+#include <core/Scene/Scene.h>
+#include <core/Scene/SceneHierarchy.h>
+#include <core/Scene/SceneSnapshot.h>
+#include <core/Scene/WorldPartition.h>
+
+#include <filesystem>
+#include <stdexcept>
+
+namespace core { namespace Test {
+
+/**
+ * Steps cells through Unloaded, Decoding, Instantiating, Loaded and Unloading
+ * @details JobSystem has no workers, so decoding finishes within the Update that starts it
+ */
+struct WorldPartitionTest : Corrade::TestSuite::Tester {
+    explicit WorldPartitionTest();
+
+    void LoadUnload();
+    void Budgeted();
+    void LeaveWhileDecoding();
+    void Failed();
+    void DuplicateCell();
+};
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr float cellSize = 100.0f;
+
+/** Center of cell (0, 0) and a point far from it */
+const Vector3 near { 50.0f, 0.0f, 50.0f };
+const Vector3 far  { 5000.0f, 0.0f, 5000.0f };
+
+/**
+ * Saves a cell of count entities, chained in groups of 10 to give it some depth
+ */
+string SaveCell(const string& name, size_t count) {
+    const string path = (std::filesystem::temp_directory_path() / ("CoreWorldPartitionTest-" + name + ".snap")).string();
+
+    EntityHandle saved  = Entity::Spawn("Saved", Scene::Get("Default")->Root()->GetHandle());
+    EntityHandle parent = saved;
+    for (size_t i = 0; i < count; ++i) {
+        parent = Entity::Spawn("Entity", i % 10 == 0 ? saved : parent);
+    }
+    SceneSnapshot::Save(path, saved);
+    Entity::Destroy(saved);
+    return path;
+}
+
+/** Number of entities below root, root excluded */
+size_t Descendants(EntityHandle root) {
+    size_t count = 0;
+    SceneHierarchy<Entity>::EachInSubtree(root.index, [&](Entity&) { ++count; });
+    return count - 1;
+}
+
+}
+
+WorldPartitionTest::WorldPartitionTest() {
+    addTests({ &WorldPartitionTest::LoadUnload,
+               &WorldPartitionTest::Budgeted,
+               &WorldPartitionTest::LeaveWhileDecoding,
+               &WorldPartitionTest::Failed,
+               &WorldPartitionTest::DuplicateCell });
+}
+
+void WorldPartitionTest::LoadUnload() {
+    JobSystem jobSystem(0);
+    CORRADE_COMPARE(jobSystem.ThreadCount(), 1);
+
+    EntityHandle world = Entity::Spawn("World", Scene::Get("Default")->Root()->GetHandle());
+    WorldPartition partition(cellSize, 150.0f, 300.0f, world, jobSystem);
+    partition.AddCell({ 0, 0 }, SaveCell("LoadUnload", 20));
+    CORRADE_COMPARE(partition.GetCell(near), Vector2i(0, 0));
+
+    /* Out of range, stays unloaded */
+    partition.Update(far, 100ms);
+    CORRADE_VERIFY(!partition.IsLoaded({ 0, 0 }));
+    CORRADE_COMPARE(Descendants(world), 0);
+
+    /* Decoded in this update, instantiated in the next one */
+    partition.Update(near, 100ms);
+    CORRADE_VERIFY(!partition.IsLoaded({ 0, 0 }));
+    CORRADE_COMPARE(Descendants(world), 0);
+
+    partition.Update(near, 100ms);
+    CORRADE_VERIFY(partition.IsLoaded({ 0, 0 }));
+    CORRADE_COMPARE(Descendants(world), 21);
+
+    /* Staying in range keeps the cell as it is */
+    partition.Update(near, 100ms);
+    CORRADE_VERIFY(partition.IsLoaded({ 0, 0 }));
+    CORRADE_COMPARE(Descendants(world), 21);
+
+    /* Between load and unload radius nothing changes either */
+    partition.Update({ 50.0f, 0.0f, 250.0f }, 100ms);
+    CORRADE_VERIFY(partition.IsLoaded({ 0, 0 }));
+
+    partition.Update(far, 100ms);
+    CORRADE_VERIFY(!partition.IsLoaded({ 0, 0 }));
+    CORRADE_COMPARE(Descendants(world), 0);
+
+    /* Unloaded cell loads again */
+    partition.Update(near, 100ms);
+    partition.Update(near, 100ms);
+    CORRADE_VERIFY(partition.IsLoaded({ 0, 0 }));
+    CORRADE_COMPARE(Descendants(world), 21);
+
+    Entity::Destroy(world);
+}
+
+void WorldPartitionTest::Budgeted() {
+    JobSystem jobSystem(0);
+    EntityHandle world = Entity::Spawn("World", Scene::Get("Default")->Root()->GetHandle());
+    WorldPartition partition(cellSize, 150.0f, 300.0f, world, jobSystem);
+    partition.AddCell({ 0, 0 }, SaveCell("Budgeted", 5000));
+    partition.Update(near, 1us);
+
+    /* Budget runs out after every batch, so instantiation spreads over frames */
+    size_t frames = 0;
+    size_t previous = 0;
+    bool   growing = true;
+    while (!partition.IsLoaded({ 0, 0 }) && frames < 10000) {
+        partition.Update(near, 1us);
+        const size_t loaded = Descendants(world);
+        growing = growing && loaded >= previous;
+        previous = loaded;
+        ++frames;
+    }
+    CORRADE_VERIFY(partition.IsLoaded({ 0, 0 }));
+    CORRADE_VERIFY(growing);
+    CORRADE_VERIFY(frames > 1);
+    CORRADE_COMPARE(Descendants(world), 5001);
+
+    /* Same for unloading, the cell is not loaded anymore from the first unloading frame */
+    frames = 0;
+    previous = Descendants(world);
+    bool shrinking = true;
+    do {
+        partition.Update(far, 1us);
+        CORRADE_VERIFY(!partition.IsLoaded({ 0, 0 }));
+        const size_t loaded = Descendants(world);
+        shrinking = shrinking && loaded <= previous;
+        previous = loaded;
+        ++frames;
+    } while (Descendants(world) != 0 && frames < 10000);
+    CORRADE_COMPARE(Descendants(world), 0);
+    CORRADE_VERIFY(shrinking);
+    CORRADE_VERIFY(frames > 1);
+
+    Entity::Destroy(world);
+}
+
+void WorldPartitionTest::LeaveWhileDecoding() {
+    JobSystem jobSystem(0);
+    EntityHandle world = Entity::Spawn("World", Scene::Get("Default")->Root()->GetHandle());
+    WorldPartition partition(cellSize, 150.0f, 300.0f, world, jobSystem);
+    partition.AddCell({ 0, 0 }, SaveCell("LeaveWhileDecoding", 20));
+
+    /* Decoded cell is dropped without instantiating anything */
+    partition.Update(near, 100ms);
+    partition.Update(far, 100ms);
+    CORRADE_VERIFY(!partition.IsLoaded({ 0, 0 }));
+    CORRADE_COMPARE(Descendants(world), 0);
+
+    partition.Update(near, 100ms);
+    partition.Update(near, 100ms);
+    CORRADE_VERIFY(partition.IsLoaded({ 0, 0 }));
+
+    Entity::Destroy(world);
+}
+
+void WorldPartitionTest::Failed() {
+    JobSystem jobSystem(0);
+    EntityHandle world = Entity::Spawn("World", Scene::Get("Default")->Root()->GetHandle());
+    WorldPartition partition(cellSize, 150.0f, 300.0f, world, jobSystem);
+    partition.AddCell({ 0, 0 }, (std::filesystem::temp_directory_path() / "CoreWorldPartitionTest-Missing.snap").string());
+    partition.AddCell({ 1, 0 }, SaveCell("Failed", 20));
+
+    /* Failure is logged once, the cell is not retried, other cells load normally */
+    for (int i = 0; i < 5; ++i) { partition.Update(near, 100ms); }
+    CORRADE_VERIFY(!partition.IsLoaded({ 0, 0 }));
+    CORRADE_VERIFY(partition.IsLoaded({ 1, 0 }));
+    CORRADE_COMPARE(Descendants(world), 21);
+
+    Entity::Destroy(world);
+}
+
+void WorldPartitionTest::DuplicateCell() {
+    JobSystem jobSystem(0);
+    EntityHandle world = Entity::Spawn("World", Scene::Get("Default")->Root()->GetHandle());
+    WorldPartition partition(cellSize, 150.0f, 300.0f, world, jobSystem);
+    partition.AddCell({ 0, 0 }, "a.snap");
+
+    bool thrown = false;
+    try {
+        partition.AddCell({ 0, 0 }, "b.snap");
+    } catch (const std::logic_error&) {
+        thrown = true;
+    }
+    CORRADE_VERIFY(thrown);
+
+    Entity::Destroy(world);
+}
+
+}}
+
+CORRADE_TEST_MAIN(core::Test::WorldPartitionTest)